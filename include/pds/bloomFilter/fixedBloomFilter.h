@@ -0,0 +1,61 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+#include "pds/core/common.h"
+#include "pds/core/hash.h"
+
+namespace pds::bloomFilter
+{
+    /**
+     * @brief Bloom filter whose size and number of hash functions are fixed at compile time,
+     * for small filters kept by value in large numbers, e.g. one per connection. The bits live
+     * inline with no allocation, the k probes are unrolled and a power-of-two Bits reduces
+     * indices with a mask. Indices match those of a SimpleBloomFilter of the same size and k.
+     *
+     * The filter is Bits rounded up to 64-bit words and nothing else: no set-bit count, which
+     * getSize() recomputes, and no visualiser or metrics, so it is trivially copyable and can
+     * be copied or sent with memcpy.
+     *
+     * @tparam T
+     * @tparam Bits Number of bits, m
+     * @tparam K Number of hash functions, k
+     */
+    template <typename T, size_t Bits, size_t K>
+    class FixedBloomFilter
+    {
+        static_assert(Bits > 0, "FixedBloomFilter needs at least one bit");
+        static_assert(K > 0, "FixedBloomFilter needs at least one hash function");
+
+        public:
+        void insert(const T& item);
+        template <typename Item = T>
+        bool contains(const Item& item) const;
+        template <typename Item = T>
+        std::optional<float> query(const Item& item) const;
+        void clear();
+
+        int32_t getLoadFactor() const;
+        int32_t getSize() const;
+        bool isEmpty() const;
+
+        private:
+        static constexpr size_t NUM_WORDS = (Bits + 63) / 64;
+        static constexpr bool POWER_OF_TWO = (Bits & (Bits - 1)) == 0;
+
+        static constexpr size_t index(size_t baseHash, size_t i);
+        template <size_t... I>
+        void setBits(size_t baseHash, std::index_sequence<I...>);
+        template <size_t... I>
+        bool testBits(size_t baseHash, std::index_sequence<I...>) const;
+
+        std::array<uint64_t, NUM_WORDS> _words{};
+    };
+}
+
+#include "fixedBloomFilterImpl.h"
@@ -0,0 +1,162 @@
+#pragma once
+
+namespace pds::bloomFilter
+{
+    /**
+     * @brief Insert an item into the Bloom Filter
+     *
+     * @tparam T
+     * @tparam Bits
+     * @tparam K
+     * @param item
+     */
+    template <typename T, size_t Bits, size_t K>
+    void FixedBloomFilter<T, Bits, K>::insert(const T& item)
+    {
+        setBits(core::transparentHash(item), std::make_index_sequence<K>{});
+    }
+
+    /**
+     * @brief Checks if an item, or a key hashing like one such as a std::string_view, is possibly in the filter
+     *
+     * @tparam T
+     * @tparam Bits
+     * @tparam K
+     * @tparam Item
+     * @param item
+     * @return true
+     * @return false
+     */
+    template <typename T, size_t Bits, size_t K>
+    template <typename Item>
+    bool FixedBloomFilter<T, Bits, K>::contains(const Item& item) const
+    {
+        static_assert(std::is_same_v<Item, T> || core::isTransparentKey<T, Item>, "Item must be T or hash like it");
+        return testBits(core::transparentHash(item), std::make_index_sequence<K>{});
+    }
+
+    /**
+     * @brief Query if an item is possibly in the Bloom Filter
+     *
+     * @tparam T
+     * @tparam Bits
+     * @tparam K
+     * @tparam Item
+     * @param item
+     * @return std::optional<float> The false positive probability if the item may be present
+     */
+    template <typename T, size_t Bits, size_t K>
+    template <typename Item>
+    std::optional<float> FixedBloomFilter<T, Bits, K>::query(const Item& item) const
+    {
+        if (!contains(item))
+            return std::nullopt;
+
+        const float fill = static_cast<float>(getSize()) / static_cast<float>(Bits);
+        return std::make_optional<float>(std::pow(fill, static_cast<float>(K)));
+    }
+
+    /**
+     * @brief Clears every bit
+     *
+     * @tparam T
+     * @tparam Bits
+     * @tparam K
+     */
+    template <typename T, size_t Bits, size_t K>
+    void FixedBloomFilter<T, Bits, K>::clear()
+    {
+        _words.fill(0);
+    }
+
+    /**
+     * @brief Gets the load factor of the Bloom Filter as a percentage of bits set
+     *
+     * @tparam T
+     * @tparam Bits
+     * @tparam K
+     * @return int32_t
+     */
+    template <typename T, size_t Bits, size_t K>
+    int32_t FixedBloomFilter<T, Bits, K>::getLoadFactor() const
+    {
+        return static_cast<int32_t>(static_cast<size_t>(getSize()) * 100 / Bits);
+    }
+
+    /**
+     * @brief Number of set bits, counted on demand so the filter holds nothing but its bits
+     *
+     * @tparam T
+     * @tparam Bits
+     * @tparam K
+     * @return int32_t
+     */
+    template <typename T, size_t Bits, size_t K>
+    int32_t FixedBloomFilter<T, Bits, K>::getSize() const
+    {
+        int32_t count = 0;
+        for (uint64_t word : _words)
+        {
+            count += __builtin_popcountll(word);
+        }
+        return count;
+    }
+
+    /**
+     * @brief Checks if the Bloom Filter is empty
+     *
+     * @tparam T
+     * @tparam Bits
+     * @tparam K
+     * @return true
+     * @return false
+     */
+    template <typename T, size_t Bits, size_t K>
+    bool FixedBloomFilter<T, Bits, K>::isEmpty() const
+    {
+        for (uint64_t word : _words)
+        {
+            if (word != 0)
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Index of the i-th hash function, h_i(x) = std::hash(x) ^ (i * 0x9e3779b9), reduced by mask when Bits is a power of two
+     *
+     * @tparam T
+     * @tparam Bits
+     * @tparam K
+     * @param baseHash
+     * @param i
+     * @return size_t
+     */
+    template <typename T, size_t Bits, size_t K>
+    constexpr size_t FixedBloomFilter<T, Bits, K>::index(size_t baseHash, size_t i)
+    {
+        const size_t h = baseHash ^ (i * core::HASH_SEED_MULTIPLIER);
+        if constexpr (POWER_OF_TWO)
+        {
+            return h & (Bits - 1);
+        }
+        else
+        {
+            return h % Bits;
+        }
+    }
+
+    template <typename T, size_t Bits, size_t K>
+    template <size_t... I>
+    void FixedBloomFilter<T, Bits, K>::setBits(size_t baseHash, std::index_sequence<I...>)
+    {
+        ((_words[index(baseHash, I) / 64] |= uint64_t{1} << (index(baseHash, I) % 64)), ...);
+    }
+
+    template <typename T, size_t Bits, size_t K>
+    template <size_t... I>
+    bool FixedBloomFilter<T, Bits, K>::testBits(size_t baseHash, std::index_sequence<I...>) const
+    {
+        return (((_words[index(baseHash, I) / 64] >> (index(baseHash, I) % 64)) & 1) && ...);
+    }
+}
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <vector>
+#include <optional>
+#include <string>
+#include <iostream>
+#include <cmath>
+#include <memory_resource>
+#include <unordered_set>
+
+#include "pds/core/common.h"
+#include "pds/core/hash.h"
+#include "quotientFilterVisualiser.h"
+
+namespace pds::bloomFilter
+{
+    /**
+     * @brief Quotient filter: each item is reduced to a fingerprint of quotientBits + remainderBits
+     * hash bits. The quotient picks a home slot and the remainder is stored in the run of that
+     * slot, kept sorted with linear probing. Four metadata bits per slot (occupied, continuation,
+     * shifted, counter) let the runs be decoded, so the filter supports erase and counting, merges
+     * two filters in fingerprint order, and doubles by moving one remainder bit into the quotient,
+     * without the original items.
+     *
+     * A remainder inserted more than once is followed by counter slots holding its count less one,
+     * remainderBits bits per slot, so an item inserted n times takes 1 + log(n) / remainderBits
+     * slots. Adding or removing a slot shifts only the rest of its cluster.
+     *
+     * Slots are packed at remainderBits + 4 bits each, so a lookup touches the few consecutive
+     * slots of one run, usually within one cache line.
+     *
+     * @tparam T
+     */
+    template <typename T>
+    class QuotientFilter
+    {
+        friend class QuotientFilterVisualiser<T>;
+
+        public:
+        explicit QuotientFilter(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+        void init(size_t quotientBits = 10, size_t remainderBits = 8);
+
+        bool insert(const T& item);
+        std::optional<float> query(const T& item) const;
+        uint64_t count(const T& item) const;
+        bool erase(const T& item);
+
+        bool merge(const QuotientFilter& other);
+        bool resize();
+
+        int32_t getLoadFactor() const;
+        int32_t getSize() const;
+        bool isEmpty() const;
+        size_t getCapacity() const;
+        size_t getRemainderBits() const;
+
+        private:
+        static constexpr uint64_t OCCUPIED = 1;     // The slot is the home of some stored fingerprint
+        static constexpr uint64_t CONTINUATION = 2; // The slot holds a remainder or counter that is not the first of its run
+        static constexpr uint64_t SHIFTED = 4;      // The slot holds a remainder or counter away from its home slot
+        static constexpr uint64_t COUNTER = 8;      // The slot holds a digit of the count of the remainder before it
+        static constexpr size_t METADATA_BITS = 4;
+
+        struct Entry
+        {
+            uint64_t remainder;
+            uint64_t count;
+            size_t length; // Slots taken, the remainder and its counters
+        };
+
+        struct Fingerprint
+        {
+            uint64_t value;
+            uint64_t count;
+        };
+
+        uint64_t fingerprint(const T& item) const;
+        bool reserveSlots(uint64_t count);
+        void insertFingerprint(uint64_t fingerprint, uint64_t count);
+        bool findEntry(size_t runStart, uint64_t remainder, size_t& index, Entry& entry) const;
+        size_t findRunStart(size_t home) const;
+        Entry readEntry(size_t index) const;
+        void writeCount(size_t index, size_t home, size_t oldDigits, uint64_t count);
+        size_t digitsFor(uint64_t count) const;
+        void insertSlot(size_t index, uint64_t content);
+        void removeSlot(size_t index, size_t home, bool runStart);
+        std::pmr::vector<Fingerprint> fingerprints() const;
+        void reset(size_t quotientBits, size_t remainderBits);
+
+        uint64_t getSlot(size_t index) const;
+        void setSlot(size_t index, uint64_t value);
+        // Everything but the occupied bit moves with the slot's contents when a run shifts
+        void setContent(size_t index, uint64_t content) { setSlot(index, (getSlot(index) & OCCUPIED) | content); }
+        bool isEmptySlot(size_t index) const { return (getSlot(index) & (OCCUPIED | SHIFTED)) == 0; }
+        size_t next(size_t index) const { return (index + 1) & (_numSlots - 1); }
+        size_t prev(size_t index) const { return (index - 1) & (_numSlots - 1); }
+
+        float computeFalsePositiveProbability() const
+        {
+            // Probability that another fingerprint shares the item's quotient and remainder
+            const float load = static_cast<float>(_usedSlots) / static_cast<float>(_numSlots);
+            return 1.0f - std::exp(-load / std::ldexp(1.0f, static_cast<int>(_remainderBits)));
+        }
+
+        size_t _quotientBits;
+        size_t _remainderBits;
+        size_t _slotBits; // remainderBits + METADATA_BITS
+        size_t _numSlots;
+        size_t _size; // Fingerprints stored, counting repeats
+        size_t _usedSlots; // Slots holding a remainder or a counter
+        std::pmr::vector<uint64_t> _words; // Slots packed back to back, plus a word for the last one's overflow
+
+        QuotientFilterVisualiser<T> _visualiser;
+        std::pmr::unordered_multiset<T> _items; // To track inserted items, only while visualising
+    };
+}
+
+#include "quotientFilterImpl.h"
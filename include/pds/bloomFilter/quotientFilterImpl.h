@@ -0,0 +1,691 @@
+#pragma once
+
+#include <algorithm>
+
+namespace pds::bloomFilter
+{
+    /**
+     * @brief Construct a new Quotient Filter< T>:: Quotient Filter object
+     * with its slots drawn from the given memory resource
+     *
+     * @tparam T
+     * @param resource
+     */
+    template <typename T>
+    QuotientFilter<T>::QuotientFilter(std::pmr::memory_resource* resource)
+        : _quotientBits(0), _remainderBits(0), _slotBits(0), _numSlots(0), _size(0), _usedSlots(0),
+          _words(resource), _items(resource)
+    {
+        reset(10, 8);
+    }
+
+    /**
+     * @brief Initialise an empty filter of 2^quotientBits slots, each storing remainderBits bits of
+     * the item's fingerprint. The false positive rate is about load / 2^remainderBits.
+     * quotientBits + remainderBits is capped at 64 and remainderBits at 60.
+     *
+     * @tparam T
+     * @param quotientBits
+     * @param remainderBits
+     */
+    template <typename T>
+    void QuotientFilter<T>::init(size_t quotientBits, size_t remainderBits)
+    {
+        remainderBits = std::clamp<size_t>(remainderBits, 1, 64 - METADATA_BITS);
+        quotientBits = std::clamp<size_t>(quotientBits, 1, 64 - remainderBits);
+        reset(quotientBits, remainderBits);
+        _items.clear();
+
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("[Init] Quotient Filter initialized with " + std::to_string(_numSlots) +
+                                  " slots and " + std::to_string(_remainderBits) + " remainder bits");
+            _visualiser.logState(*this, std::nullopt, VisualContext::INIT);
+        }
+    }
+
+    /**
+     * @brief Insert an item, doubling the filter first if it is past its maximum load
+     *
+     * @tparam T
+     * @param item
+     * @return true
+     * @return false if the filter is full and has no remainder bit left to double with
+     */
+    template <typename T>
+    bool QuotientFilter<T>::insert(const T& item)
+    {
+        if (!reserveSlots(1))
+            return false;
+
+        const uint64_t f = fingerprint(item);
+        insertFingerprint(f, 1);
+
+        if constexpr (VISUALISE)
+        {
+            const size_t home = static_cast<size_t>(f >> _remainderBits);
+            _items.insert(item);
+            _visualiser.logAction("[Insert] " + toDisplayString(item) + " -> Quotient: " + std::to_string(home) +
+                                  ", Remainder: " + std::to_string(f & ((uint64_t{1} << _remainderBits) - 1)));
+            _visualiser.logState(*this, home, VisualContext::INSERT);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Query if an item is possibly in the filter
+     *
+     * @tparam T
+     * @param item
+     * @return std::optional<float> The false positive probability if the item may be present
+     */
+    template <typename T>
+    std::optional<float> QuotientFilter<T>::query(const T& item) const
+    {
+        if (count(item) == 0)
+        {
+            if constexpr (VISUALISE)
+            {
+                _visualiser.logAction("\033[31m[Query Miss]\033[0m " + toDisplayString(item));
+                _visualiser.logState(*this, static_cast<size_t>(fingerprint(item) >> _remainderBits), VisualContext::QUERY);
+            }
+            return std::nullopt;
+        }
+
+        if constexpr (VISUALISE)
+        {
+            if (_items.find(item) == _items.end())
+            {
+                _visualiser.logAction("\033[33m[Query False Positive]\033[0m " + toDisplayString(item));
+            }
+            else
+            {
+                _visualiser.logAction("\033[34m[Query Hit]\033[0m " + toDisplayString(item));
+            }
+            _visualiser.logState(*this, static_cast<size_t>(fingerprint(item) >> _remainderBits), VisualContext::QUERY);
+        }
+
+        return std::make_optional<float>(computeFalsePositiveProbability());
+    }
+
+    /**
+     * @brief Number of times the item's fingerprint was inserted and not erased. Never less than
+     * the item's true count; more only if another item shares its fingerprint.
+     *
+     * @tparam T
+     * @param item
+     * @return uint64_t
+     */
+    template <typename T>
+    uint64_t QuotientFilter<T>::count(const T& item) const
+    {
+        const uint64_t f = fingerprint(item);
+        const size_t home = static_cast<size_t>(f >> _remainderBits);
+        if (!(getSlot(home) & OCCUPIED))
+            return 0;
+
+        size_t index;
+        Entry entry;
+        return findEntry(findRunStart(home), f & ((uint64_t{1} << _remainderBits) - 1), index, entry) ? entry.count : 0;
+    }
+
+    /**
+     * @brief Erases one occurrence of an item: its count drops by one, and the remainder's slot is
+     * freed with its last occurrence
+     *
+     * @tparam T
+     * @param item
+     * @return true
+     * @return false if the item's fingerprint is not in the filter
+     */
+    template <typename T>
+    bool QuotientFilter<T>::erase(const T& item)
+    {
+        const uint64_t f = fingerprint(item);
+        const size_t home = static_cast<size_t>(f >> _remainderBits);
+        const uint64_t remainder = f & ((uint64_t{1} << _remainderBits) - 1);
+        if (!(getSlot(home) & OCCUPIED))
+            return false;
+
+        const size_t runStart = findRunStart(home);
+        size_t index;
+        Entry entry;
+        if (!findEntry(runStart, remainder, index, entry))
+            return false;
+
+        if (entry.count > 1)
+        {
+            writeCount(index, home, entry.length - 1, entry.count - 1);
+        }
+        else
+        {
+            // Only the first remainder of a run lacks the continuation bit
+            const bool first = index == runStart;
+            if (first && !(getSlot(next(index)) & CONTINUATION))
+            {
+                setSlot(home, getSlot(home) & ~OCCUPIED);
+            }
+            removeSlot(index, home, first);
+        }
+        --_size;
+
+        if constexpr (VISUALISE)
+        {
+            if (auto tracked = _items.find(item); tracked != _items.end())
+            {
+                _items.erase(tracked);
+            }
+            _visualiser.logAction("\033[32m[Erase]\033[0m " + toDisplayString(item));
+            _visualiser.logState(*this, home, VisualContext::ERASE);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Inserts every fingerprint of another filter with the same fingerprint length, which may
+     * have a different number of slots. The fingerprints are read in sorted order with their
+     * counts, so the slots of this filter are filled front to back.
+     *
+     * @tparam T
+     * @param other
+     * @return true
+     * @return false if the fingerprint lengths differ or this filter filled up
+     */
+    template <typename T>
+    bool QuotientFilter<T>::merge(const QuotientFilter& other)
+    {
+        if (other._quotientBits + other._remainderBits != _quotientBits + _remainderBits)
+            return false;
+
+        for (const Fingerprint& f : other.fingerprints())
+        {
+            if (!reserveSlots(f.count))
+                return false;
+
+            insertFingerprint(f.value, f.count);
+        }
+
+        if constexpr (VISUALISE)
+        {
+            _items.insert(other._items.begin(), other._items.end());
+            _visualiser.logAction("[Merge] " + std::to_string(other._size) + " fingerprints merged");
+            _visualiser.logState(*this, std::nullopt, VisualContext::INSERT);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Doubles the number of slots without the original items: the top bit of each
+     * remainder becomes the low bit of its quotient. The false positive rate doubles with it.
+     *
+     * @tparam T
+     * @return true
+     * @return false if only one remainder bit is left
+     */
+    template <typename T>
+    bool QuotientFilter<T>::resize()
+    {
+        if (_remainderBits <= 1)
+            return false;
+
+        const std::pmr::vector<Fingerprint> stored = fingerprints();
+        reset(_quotientBits + 1, _remainderBits - 1);
+        for (const Fingerprint& f : stored)
+        {
+            insertFingerprint(f.value, f.count);
+        }
+
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("[Resize] Doubled to " + std::to_string(_numSlots) + " slots with " +
+                                  std::to_string(_remainderBits) + " remainder bits");
+        }
+        return true;
+    }
+
+    /**
+     * @brief Gets the load factor of the filter as a percentage of slots filled, by remainders
+     * and their counters
+     *
+     * @tparam T
+     * @return int32_t
+     */
+    template <typename T>
+    int32_t QuotientFilter<T>::getLoadFactor() const
+    {
+        return static_cast<int32_t>(_usedSlots * 100 / _numSlots);
+    }
+
+    /**
+     * @brief Number of fingerprints stored, counting repeats
+     *
+     * @tparam T
+     * @return int32_t
+     */
+    template <typename T>
+    int32_t QuotientFilter<T>::getSize() const
+    {
+        return static_cast<int32_t>(_size);
+    }
+
+    /**
+     * @brief Checks if the filter is empty
+     *
+     * @tparam T
+     * @return true
+     * @return false
+     */
+    template <typename T>
+    bool QuotientFilter<T>::isEmpty() const
+    {
+        return _size == 0;
+    }
+
+    /**
+     * @brief Number of slots
+     *
+     * @tparam T
+     * @return size_t
+     */
+    template <typename T>
+    size_t QuotientFilter<T>::getCapacity() const
+    {
+        return _numSlots;
+    }
+
+    /**
+     * @brief Number of fingerprint bits stored per slot, one less after each doubling
+     *
+     * @tparam T
+     * @return size_t
+     */
+    template <typename T>
+    size_t QuotientFilter<T>::getRemainderBits() const
+    {
+        return _remainderBits;
+    }
+
+    /**
+     * @brief The top quotientBits + remainderBits bits of the item's mixed hash
+     *
+     * @tparam T
+     * @param item
+     * @return uint64_t
+     */
+    template <typename T>
+    uint64_t QuotientFilter<T>::fingerprint(const T& item) const
+    {
+        return core::mixedHash(item) >> (64 - (_quotientBits + _remainderBits));
+    }
+
+    /**
+     * @brief Doubles the filter if adding count occurrences of a new remainder would take it past
+     * 90% load. One slot always stays empty, so every cluster has an end.
+     *
+     * @tparam T
+     * @param count
+     * @return true
+     * @return false if the filter is full and has no remainder bit left to double with
+     */
+    template <typename T>
+    bool QuotientFilter<T>::reserveSlots(uint64_t count)
+    {
+        // The remainder's slot and its counters, or one more counter if the count carries
+        const auto needed = [&] { return 1 + digitsFor(count); };
+        if ((_usedSlots + needed()) * 10 > _numSlots * 9)
+        {
+            resize();
+        }
+        return _usedSlots + needed() < _numSlots;
+    }
+
+    /**
+     * @brief Adds count occurrences of a fingerprint. A remainder already in its run has its
+     * count raised; a new one is placed in sorted position. Either way only the slots from
+     * there to the end of the cluster shift, into the empty slot after it.
+     *
+     * @tparam T
+     * @param fingerprint
+     * @param count At least 1
+     */
+    template <typename T>
+    void QuotientFilter<T>::insertFingerprint(uint64_t fingerprint, uint64_t count)
+    {
+        const size_t home = static_cast<size_t>(fingerprint >> _remainderBits);
+        const uint64_t remainder = fingerprint & ((uint64_t{1} << _remainderBits) - 1);
+        _size += count;
+
+        if (isEmptySlot(home))
+        {
+            setSlot(home, OCCUPIED | (remainder << METADATA_BITS));
+            ++_usedSlots;
+            writeCount(home, home, 0, count);
+            return;
+        }
+
+        const bool newRun = !(getSlot(home) & OCCUPIED);
+        setSlot(home, getSlot(home) | OCCUPIED);
+        const size_t runStart = findRunStart(home);
+
+        size_t index = runStart;
+        Entry entry{remainder, 0, 1};
+        if (newRun || !findEntry(runStart, remainder, index, entry))
+        {
+            entry = {remainder, 0, 1};
+            const bool first = index == runStart;
+            insertSlot(index, (remainder << METADATA_BITS) | (first ? 0 : CONTINUATION) | (index != home ? SHIFTED : 0));
+            if (first && !newRun)
+            {
+                // The run's old first remainder now follows the new one
+                setContent(next(index), (getSlot(next(index)) & ~OCCUPIED) | CONTINUATION);
+            }
+        }
+        writeCount(index, home, entry.length - 1, entry.count + count);
+    }
+
+    /**
+     * @brief Looks for a remainder in the sorted run starting at runStart
+     *
+     * @tparam T
+     * @param runStart
+     * @param remainder
+     * @param index Set to the remainder's slot, or to the slot it would be inserted at
+     * @param entry Set to the remainder's entry when found
+     * @return true
+     * @return false if the remainder is not in the run
+     */
+    template <typename T>
+    bool QuotientFilter<T>::findEntry(size_t runStart, uint64_t remainder, size_t& index, Entry& entry) const
+    {
+        index = runStart;
+        do
+        {
+            entry = readEntry(index);
+            if (entry.remainder >= remainder)
+                return entry.remainder == remainder;
+
+            index = (index + entry.length) & (_numSlots - 1);
+        } while (getSlot(index) & CONTINUATION);
+        return false;
+    }
+
+    /**
+     * @brief First slot of the run of home, whose occupied bit is set: walks back to the start
+     * of the cluster, then forward run by run
+     *
+     * @tparam T
+     * @param home
+     * @return size_t
+     */
+    template <typename T>
+    size_t QuotientFilter<T>::findRunStart(size_t home) const
+    {
+        size_t start = home;
+        while (getSlot(start) & SHIFTED)
+        {
+            start = prev(start);
+        }
+
+        size_t runStart = start;
+        for (size_t quotient = start; quotient != home;)
+        {
+            do
+            {
+                runStart = next(runStart);
+            } while (getSlot(runStart) & CONTINUATION);
+
+            do
+            {
+                quotient = next(quotient);
+            } while (!(getSlot(quotient) & OCCUPIED));
+        }
+        return runStart;
+    }
+
+    /**
+     * @brief Decodes the remainder at index and the counter slots after it, which hold its count
+     * less one, lowest digit first
+     *
+     * @tparam T
+     * @param index
+     * @return Entry
+     */
+    template <typename T>
+    typename QuotientFilter<T>::Entry QuotientFilter<T>::readEntry(size_t index) const
+    {
+        Entry entry{getSlot(index) >> METADATA_BITS, 1, 1};
+        size_t shift = 0;
+        for (size_t i = next(index); getSlot(i) & COUNTER; i = next(i), shift += _remainderBits, ++entry.length)
+        {
+            if (shift < 64)
+            {
+                entry.count += (getSlot(i) >> METADATA_BITS) << shift;
+            }
+        }
+        return entry;
+    }
+
+    /**
+     * @brief Rewrites the counters after the remainder at index for a new count, first adding or
+     * removing counter slots if the number of digits changed
+     *
+     * @tparam T
+     * @param index
+     * @param home Home slot of the remainder's run
+     * @param oldDigits Counter slots the remainder has now
+     * @param count At least 1
+     */
+    template <typename T>
+    void QuotientFilter<T>::writeCount(size_t index, size_t home, size_t oldDigits, uint64_t count)
+    {
+        const size_t mask = _numSlots - 1;
+        const size_t digits = digitsFor(count);
+        for (size_t d = oldDigits; d < digits; ++d)
+        {
+            insertSlot((index + 1 + d) & mask, COUNTER | CONTINUATION | SHIFTED);
+        }
+        for (size_t d = oldDigits; d > digits; --d)
+        {
+            removeSlot((index + d) & mask, home, false);
+        }
+
+        uint64_t value = count - 1;
+        for (size_t d = 0; d < digits; ++d, value >>= _remainderBits)
+        {
+            const uint64_t digit = value & ((uint64_t{1} << _remainderBits) - 1);
+            setContent((index + 1 + d) & mask, COUNTER | CONTINUATION | SHIFTED | (digit << METADATA_BITS));
+        }
+    }
+
+    /**
+     * @brief Counter slots needed for a count
+     *
+     * @tparam T
+     * @param count
+     * @return size_t
+     */
+    template <typename T>
+    size_t QuotientFilter<T>::digitsFor(uint64_t count) const
+    {
+        size_t digits = 0;
+        for (uint64_t value = count - 1; value != 0; value >>= _remainderBits)
+        {
+            ++digits;
+        }
+        return digits;
+    }
+
+    /**
+     * @brief Writes content to the filled slot at index after moving it and the rest of its
+     * cluster one slot on, into the first empty slot. Occupied bits stay where they are.
+     *
+     * @tparam T
+     * @param index
+     * @param content Remainder and metadata, without the occupied bit
+     */
+    template <typename T>
+    void QuotientFilter<T>::insertSlot(size_t index, uint64_t content)
+    {
+        size_t empty = index;
+        while (!isEmptySlot(empty))
+        {
+            empty = next(empty);
+        }
+
+        for (size_t i = empty; i != index; i = prev(i))
+        {
+            setContent(i, (getSlot(prev(i)) & ~OCCUPIED) | SHIFTED);
+        }
+        setContent(index, content);
+        ++_usedSlots;
+    }
+
+    /**
+     * @brief Clears the slot at index and moves the rest of its cluster back one slot, up to the
+     * first empty slot or run already at its home slot. A run that reaches its home slot is no
+     * longer shifted.
+     *
+     * @tparam T
+     * @param index
+     * @param home Home slot of the run holding index
+     * @param runStart Whether index is the first slot of its run, whose next slot then starts it
+     */
+    template <typename T>
+    void QuotientFilter<T>::removeSlot(size_t index, size_t home, bool runStart)
+    {
+        size_t hole = index;
+        size_t quotient = home;
+        for (size_t i = next(index); !isEmptySlot(i); i = next(i))
+        {
+            uint64_t content = getSlot(i) & ~OCCUPIED;
+            if (content & CONTINUATION)
+            {
+                if (runStart)
+                {
+                    content &= ~CONTINUATION;
+                    content &= hole == quotient ? ~SHIFTED : ~uint64_t{0};
+                }
+            }
+            else
+            {
+                // A new run begins, belonging to the next slot with its occupied bit set
+                do
+                {
+                    quotient = next(quotient);
+                } while (!(getSlot(quotient) & OCCUPIED));
+
+                if (quotient == i)
+                    break;
+
+                content &= hole == quotient ? ~SHIFTED : ~uint64_t{0};
+            }
+
+            setContent(hole, content);
+            hole = i;
+            runStart = false;
+        }
+        setContent(hole, 0);
+        --_usedSlots;
+    }
+
+    /**
+     * @brief Every stored fingerprint with its count, in ascending order
+     *
+     * @tparam T
+     * @return std::pmr::vector<Fingerprint>
+     */
+    template <typename T>
+    std::pmr::vector<typename QuotientFilter<T>::Fingerprint> QuotientFilter<T>::fingerprints() const
+    {
+        std::pmr::vector<Fingerprint> result(_words.get_allocator().resource());
+        if (_size == 0)
+            return result;
+
+        // Start after an empty slot, so the walk meets every cluster from its first slot
+        size_t empty = 0;
+        while (!isEmptySlot(empty))
+        {
+            ++empty;
+        }
+
+        size_t quotient = empty;
+        for (size_t offset = 1; offset < _numSlots;)
+        {
+            const size_t index = (empty + offset) & (_numSlots - 1);
+            const uint64_t slot = getSlot(index);
+            if (isEmptySlot(index))
+            {
+                ++offset;
+                continue;
+            }
+
+            if (!(slot & SHIFTED))
+            {
+                quotient = index;
+            }
+            else if (!(slot & CONTINUATION))
+            {
+                // A shifted run belongs to the next slot with its occupied bit set
+                do
+                {
+                    quotient = next(quotient);
+                } while (!(getSlot(quotient) & OCCUPIED));
+            }
+
+            const Entry entry = readEntry(index);
+            result.push_back({(static_cast<uint64_t>(quotient) << _remainderBits) | entry.remainder, entry.count});
+            offset += entry.length;
+        }
+
+        std::sort(result.begin(), result.end(), [](const Fingerprint& a, const Fingerprint& b) { return a.value < b.value; });
+        return result;
+    }
+
+    /**
+     * @brief Empties the filter and sizes the slots for the given split of the fingerprint
+     *
+     * @tparam T
+     * @param quotientBits
+     * @param remainderBits
+     */
+    template <typename T>
+    void QuotientFilter<T>::reset(size_t quotientBits, size_t remainderBits)
+    {
+        _quotientBits = quotientBits;
+        _remainderBits = remainderBits;
+        _slotBits = remainderBits + METADATA_BITS;
+        _numSlots = size_t{1} << quotientBits;
+        _size = 0;
+        _usedSlots = 0;
+        _words.assign((_numSlots * _slotBits + 63) / 64 + 1, 0);
+    }
+
+    template <typename T>
+    uint64_t QuotientFilter<T>::getSlot(size_t index) const
+    {
+        const size_t bit = index * _slotBits;
+        const size_t word = bit / 64;
+        const size_t offset = bit % 64;
+        uint64_t value = _words[word] >> offset;
+        if (offset + _slotBits > 64)
+        {
+            value |= _words[word + 1] << (64 - offset);
+        }
+        return _slotBits == 64 ? value : value & ((uint64_t{1} << _slotBits) - 1);
+    }
+
+    template <typename T>
+    void QuotientFilter<T>::setSlot(size_t index, uint64_t value)
+    {
+        const uint64_t mask = _slotBits == 64 ? ~uint64_t{0} : (uint64_t{1} << _slotBits) - 1;
+        const size_t bit = index * _slotBits;
+        const size_t word = bit / 64;
+        const size_t offset = bit % 64;
+        _words[word] = (_words[word] & ~(mask << offset)) | (value << offset);
+        if (offset + _slotBits > 64)
+        {
+            const size_t shift = 64 - offset;
+            _words[word + 1] = (_words[word + 1] & ~(mask >> shift)) | (value >> shift);
+        }
+    }
+}
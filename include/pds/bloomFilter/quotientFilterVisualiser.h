@@ -0,0 +1,79 @@
+#pragma once
+
+#include <iostream>
+#include <optional>
+#include <iomanip>
+
+#include "pds/core/common.h"
+
+namespace pds::bloomFilter
+{
+    template <typename T>
+    class QuotientFilter; // Forward declaration
+
+    template <typename T>
+    class QuotientFilterVisualiser
+    {
+        public:
+        /**
+         * @brief Logs every slot as its metadata bits (occupied, continuation, shifted, counter) and
+         * remainder, or count digit for a counter slot
+         *
+         * @param filter The quotient filter to log
+         * @param highlight Optional home slot to highlight
+         * @param ctx Context of the operation (INIT, INSERT, QUERY, ERASE)
+         */
+        void logState(const QuotientFilter<T>& filter,
+                      std::optional<size_t> highlight = std::nullopt,
+                      pds::VisualContext ctx = pds::VisualContext::UNKNOWN) const
+        {
+            constexpr size_t rowSize = 8;
+            std::cout << "\n[Quotient Filter State] Context: " << toString(ctx)
+                      << ", " << filter._size << " fingerprints in " << filter._numSlots << " slots, "
+                      << filter._remainderBits << " remainder bits\n\n";
+
+            for (size_t i = 0; i < filter._numSlots; ++i)
+            {
+                const uint64_t slot = filter.getSlot(i);
+
+                if (highlight.has_value() && highlight.value() == i)
+                {
+                    std::cout << (ctx == pds::VisualContext::QUERY ? "\033[43m" : "\033[44m"); // Yellow or Blue
+                }
+                else
+                {
+                    std::cout << (filter.isEmptySlot(i) ? "\033[41m" : "\033[42m"); // Red if empty, Green if filled
+                }
+
+                std::cout << ((slot & filter.OCCUPIED) ? 'o' : '-')
+                          << ((slot & filter.CONTINUATION) ? 'c' : '-')
+                          << ((slot & filter.SHIFTED) ? 's' : '-')
+                          << ((slot & filter.COUNTER) ? 'n' : '-') << ':'
+                          << std::setw(5) << (slot >> filter.METADATA_BITS) << "\033[0m ";
+
+                if ((i + 1) % rowSize == 0)
+                {
+                    std::cout << " <- [" << std::setw(3) << (i - rowSize + 1)
+                              << " - " << std::setw(3) << i << "]\n";
+                }
+            }
+
+            if (filter._numSlots % rowSize != 0)
+            {
+                std::cout << " <- [" << filter._numSlots - (filter._numSlots % rowSize)
+                          << " - " << filter._numSlots - 1 << "]\n";
+            }
+            std::cout << "\n";
+        }
+
+        /**
+         * @brief Logs the string describing an action taken on the quotient filter
+         *
+         * @param action
+         */
+        void logAction(const std::string& action) const
+        {
+            std::cout << "[LOG] " << action << "\n";
+        }
+    };
+}
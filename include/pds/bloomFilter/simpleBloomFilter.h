@@ -1,65 +1,144 @@
 #pragma once
 
-#include <bitset>
 #include <vector>
 #include <functional>
 #include <optional>
 #include <iomanip>
 #include <string>
 #include <iostream>
+#include <cmath>
+#include <memory_resource>
+#include <string_view>
+#include <type_traits>
 #include <unordered_set>
 
 #include "pds/core/common.h"
+#include "pds/core/bitArray.h"
+#include "pds/core/bitStream.h"
+#include "pds/core/concurrency.h"
+#include "pds/core/keyFileReader.h"
+#include "pds/core/metrics.h"
+#include "pds/core/hash.h"
 #include "simpleBloomFilterVisualiser.h"
 
 namespace pds::bloomFilter
 {
+    /**
+     * @brief Compressed forms of a filter's bit array for shipping it between nodes
+     */
+    enum class WireEncoding : uint8_t
+    {
+        GOLOMB_RICE = 1, // Gaps between set bits, Golomb-Rice coded: smallest for sparse, static filters
+        RUN_LENGTH = 2   // Alternating runs of clear and set bits, Elias-gamma coded: also compact where bits cluster
+    };
+
     template <typename T>
     class SimpleBloomFilter
     {
         friend class SimpleBloomFilterVisualiser<T>;
 
         public:
-        SimpleBloomFilter();
-        ~SimpleBloomFilter();
+        explicit SimpleBloomFilter(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
-        void init(size_t numHashFunctions);
+        void init(size_t numHashFunctions, size_t bitArraySize = BIT_ARRAY_SIZE);
 
         void insert(const T& item);
         std::optional<float> query(const T& item) const;
+        template <typename K, typename = std::enable_if_t<core::isTransparentKey<T, K>>>
+        std::optional<float> query(const K& item) const;
+        template <typename U = T, typename = std::enable_if_t<std::is_same_v<U, std::string>>>
+        bool contains(const char* data, size_t length) const;
+
+        template <typename InputIt>
+        void insertRange(InputIt first, InputIt last, size_t numThreads = 0);
+        template <typename U = T, typename = std::enable_if_t<std::is_same_v<U, std::string>>>
+        bool insertFromFile(const std::string& path, core::KeyFileFormat format = core::KeyFileFormat::NEWLINE, size_t numThreads = 0);
+
+        std::pmr::vector<uint8_t> encode(WireEncoding encoding = WireEncoding::GOLOMB_RICE) const;
+        bool decode(const uint8_t* data, size_t size);
+        template <typename K = T>
+        static std::optional<float> queryEncoded(const uint8_t* data, size_t size, const K& item);
 
         int32_t getLoadFactor() const;
         int32_t getSize() const;
         bool isEmpty() const;
 
+        core::Stats stats() const;
+        void setMetricsSink(core::MetricsSink* sink, uint64_t publishInterval = 1024);
+        void setSnapshotWriter(core::SnapshotWriter* writer);
+
         private:
+        static constexpr uint64_t MAX_WIRE_BITS = uint64_t{1} << 32; // Largest bit array decode will allocate
+        static constexpr uint64_t MAX_WIRE_HASHES = 64; // Most hash functions an encoded header may claim
+
+        /**
+         * @brief Fields that precede the coded bits of an encoded filter
+         */
+        struct WireHeader
+        {
+            WireEncoding encoding;
+            size_t numHashes;
+            size_t numBits;
+            size_t setBits;
+            size_t riceBits; // Golomb-Rice parameter, only for GOLOMB_RICE
+        };
+
+        static bool readWireHeader(core::BitReader& reader, WireHeader& header);
+        static size_t riceParameter(size_t numBits, size_t setBits);
+        template <typename Visit>
+        static bool forEachEncodedBit(core::BitReader& reader, const WireHeader& header, Visit visit);
+
         size_t _k; // Number of hash functions
         int32_t _count; // count of number of set bits in the bit array
-        std::bitset<BIT_ARRAY_SIZE>* _bitArray;
+        core::BitArray _bitArray;
 
-        std::vector<std::function<size_t(const T&)>> _hashFunctions;
+        std::pmr::vector<std::function<size_t(const T&)>> _hashFunctions;
 
         SimpleBloomFilterVisualiser<T> _visualiser;
-        std::unordered_set<T> _items; // To track inserted items
+        std::pmr::unordered_set<T> _items; // To track inserted items, only while visualising
+        mutable core::Metrics _metrics;
 
         private:
+        static constexpr size_t BULK_BATCH_SIZE = size_t{1} << 20; // Keys hashed per parallel round of a bulk build
+
+        /**
+         * @brief Bit positions produced by each hashing thread, bucketed by the region of
+         * the bit array they fall in. Reused across the batches of a bulk build.
+         */
+        struct BulkWorkspace
+        {
+            size_t numThreads;
+            size_t regionBits;
+            std::vector<std::vector<std::vector<size_t>>> positions; // [hashing thread][region]
+        };
+
+        BulkWorkspace makeBulkWorkspace(size_t numThreads) const;
+        template <typename RandomIt>
+        void insertBatch(RandomIt keys, size_t numKeys, BulkWorkspace& workspace);
+        void finishBulkInsert(size_t numKeys);
+        void publishMetrics() const;
 
         float computeFalsePositiveProbability() const
         {
-            if (_k == 0 || _count == 0)
+            return computeFalsePositiveProbability(_k, static_cast<size_t>(_count), _bitArray.size());
+        }
+
+        static float computeFalsePositiveProbability(size_t k, size_t setBits, size_t numBits)
+        {
+            if (k == 0 || setBits == 0)
                 return 0.0f;
 
-            float n = static_cast<float>(_count);              // Number of bits set
-            float m = static_cast<float>(BIT_ARRAY_SIZE);      // Bit array size
+            float n = static_cast<float>(setBits);              // Number of bits set
+            float m = static_cast<float>(numBits);              // Bit array size
 
-            float exponent = -static_cast<float>(_k) * (n / m);
+            float exponent = -static_cast<float>(k) * (n / m);
             float base = 1.0f - std::exp(exponent);
 
             // Clamp base to [0,1] to prevent domain errors in pow()
             if (base < 0.0f) base = 0.0f;
             if (base > 1.0f) base = 1.0f;
 
-            float falsePositiveProb = std::pow(base, static_cast<float>(_k));
+            float falsePositiveProb = std::pow(base, static_cast<float>(k));
 
             return falsePositiveProb;
         }
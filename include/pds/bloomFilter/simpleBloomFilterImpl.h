@@ -1,51 +1,53 @@
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <future>
+#include <iterator>
+
 namespace pds::bloomFilter
 {
     /**
      * @brief Construct a new Simple Bloom Filter< T>:: Simple Bloom Filter object
+     * with all of its storage drawn from the given memory resource
      *
      * @tparam T
+     * @param resource
      */
     template <typename T>
-    SimpleBloomFilter<T>::SimpleBloomFilter()
-        : _k(0), _count(0), _bitArray(new std::bitset<BIT_ARRAY_SIZE>()) {}
-
-
-    /**
-     * @brief Destroy the Simple Bloom Filter< T>:: Simple Bloom Filter object
-     *
-     * @tparam T
-     */
-    template <typename T>
-    SimpleBloomFilter<T>::~SimpleBloomFilter()
-    {
-        delete _bitArray;
-    }
+    SimpleBloomFilter<T>::SimpleBloomFilter(std::pmr::memory_resource* resource)
+        : _k(0), _count(0), _bitArray(BIT_ARRAY_SIZE, resource),
+          _hashFunctions(resource), _items(resource) {}
 
     /**
-     * @brief Initialise the Bloom Filter and set number of hash functions, k
+     * @brief Initialise the Bloom Filter and set number of hash functions, k,
+     * and the number of bits, m
      *
      * @tparam T
      * @param numHashFunctions
+     * @param bitArraySize
      */
     template <typename T>
-    void SimpleBloomFilter<T>::init(size_t numHashFunctions)
+    void SimpleBloomFilter<T>::init(size_t numHashFunctions, size_t bitArraySize)
     {
         _k = numHashFunctions;
         _count = 0;
-        _bitArray->reset();
+        _bitArray.resize(bitArraySize);
         _hashFunctions.clear();
+        _metrics.reset();
 
         for (size_t i = 0; i < _k; ++i)
         {
             _hashFunctions.emplace_back([i](const T& item) {
-                return std::hash<T>{}(item) ^ (i * 0x9e3779b9);
+                return core::seededHash(item, i);
             });
         }
 
-        _visualiser.logAction("[Init] Bloom Filter initialized with " + std::to_string(_k) + " hash functions");
-        _visualiser.logState(*this, std::nullopt, VisualContext::INIT);
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("[Init] Bloom Filter initialized with " + std::to_string(_k) + " hash functions");
+            _visualiser.logState(*this, std::nullopt, VisualContext::INIT);
+        }
     }
 
     /**
@@ -59,18 +61,23 @@ namespace pds::bloomFilter
     {
         for (const auto& hashFunc : _hashFunctions)
         {
-            size_t idx = hashFunc(item) % BIT_ARRAY_SIZE;
-            if (!_bitArray->test(idx))
+            size_t idx = hashFunc(item) % _bitArray.size();
+            if (!_bitArray.test(idx))
             {
                 ++_count;
-                _bitArray->set(idx);
+                _bitArray.set(idx);
             }
 
-            _items.insert(item); // Track inserted items
-
-            _visualiser.logAction("[Insert] " + item + " -> Hash index: " + std::to_string(idx));
-            _visualiser.logState(*this, idx, VisualContext::INSERT);
+            if constexpr (VISUALISE)
+            {
+                _items.insert(item); // Track inserted items
+                _visualiser.logAction("[Insert] " + toDisplayString(item) + " -> Hash index: " + std::to_string(idx));
+                _visualiser.logState(*this, idx, VisualContext::INSERT);
+            }
         }
+
+        _metrics.recordInsert();
+        publishMetrics();
     }
 
     /**
@@ -85,28 +92,456 @@ namespace pds::bloomFilter
     {
         for (const auto& hashFunc : _hashFunctions)
         {
-            size_t idx = hashFunc(item) % BIT_ARRAY_SIZE;
-            if (!_bitArray->test(idx))
+            size_t idx = hashFunc(item) % _bitArray.size();
+            if (!_bitArray.test(idx))
             {
-                _visualiser.logAction("\033[31m[Query Miss]\033[0m " + item + " at index " + std::to_string(idx));
-                _visualiser.logState(*this, idx, VisualContext::QUERY);
+                if constexpr (VISUALISE)
+                {
+                    _visualiser.logAction("\033[31m[Query Miss]\033[0m " + toDisplayString(item) + " at index " + std::to_string(idx));
+                    _visualiser.logState(*this, idx, VisualContext::QUERY);
+                }
+                _metrics.recordQuery(false);
+                publishMetrics();
                 return std::nullopt;
             }
         }
 
-        if(_items.find(item) == _items.end())
+        if constexpr (VISUALISE)
+        {
+            if (_items.find(item) == _items.end())
+            {
+                _visualiser.logAction("\033[33m[Query False Positive]\033[0m " + toDisplayString(item));
+            }
+            else
+            {
+                _visualiser.logAction("\033[34m[Query Hit]\033[0m " + toDisplayString(item));
+            }
+
+            _visualiser.logState(*this, std::nullopt, VisualContext::QUERY);
+        }
+
+        _metrics.recordQuery(true);
+        publishMetrics();
+        const auto falsePositiveProbability = computeFalsePositiveProbability();
+        return std::make_optional<float>(falsePositiveProbability);
+    }
+
+    /**
+     * @brief Query with a key that hashes like T without being one, e.g. a std::string_view
+     * slice of a network buffer for a filter of std::string. The key is hashed once and
+     * the k indices are derived from that hash, so nothing is allocated unless visualising.
+     *
+     * @tparam T
+     * @tparam K
+     * @param item
+     * @return std::optional<float>
+     */
+    template <typename T>
+    template <typename K, typename>
+    std::optional<float> SimpleBloomFilter<T>::query(const K& item) const
+    {
+        const size_t baseHash = core::transparentHash(item);
+        for (size_t i = 0; i < _k; ++i)
+        {
+            size_t idx = (baseHash ^ (i * core::HASH_SEED_MULTIPLIER)) % _bitArray.size();
+            if (!_bitArray.test(idx))
+            {
+                if constexpr (VISUALISE)
+                {
+                    _visualiser.logAction("\033[31m[Query Miss]\033[0m " + toDisplayString(item) + " at index " + std::to_string(idx));
+                    _visualiser.logState(*this, idx, VisualContext::QUERY);
+                }
+                _metrics.recordQuery(false);
+                publishMetrics();
+                return std::nullopt;
+            }
+        }
+
+        if constexpr (VISUALISE)
+        {
+            const T key(item);
+            if (_items.find(key) == _items.end())
+            {
+                _visualiser.logAction("\033[33m[Query False Positive]\033[0m " + toDisplayString(key));
+            }
+            else
+            {
+                _visualiser.logAction("\033[34m[Query Hit]\033[0m " + toDisplayString(key));
+            }
+
+            _visualiser.logState(*this, std::nullopt, VisualContext::QUERY);
+        }
+
+        _metrics.recordQuery(true);
+        publishMetrics();
+        return std::make_optional<float>(computeFalsePositiveProbability());
+    }
+
+    /**
+     * @brief Checks if the key held in a raw buffer is possibly in a filter of std::string
+     *
+     * @tparam T
+     * @param data
+     * @param length
+     * @return true
+     * @return false
+     */
+    template <typename T>
+    template <typename U, typename>
+    bool SimpleBloomFilter<T>::contains(const char* data, size_t length) const
+    {
+        return query(std::string_view(data, length)).has_value();
+    }
+
+    /**
+     * @brief Bulk insert of a range of keys. Each batch is hashed in parallel and the bit
+     * positions are partitioned by region of the bit array, so that every thread then sets
+     * the bits of the region it owns without atomics. The result is the same filter that
+     * inserting the keys one at a time would give.
+     *
+     * @tparam T
+     * @tparam InputIt Iterator over T or keys converting to it, such as character pointers
+     * or string views for a filter of std::string
+     * @param first
+     * @param last
+     * @param numThreads 0 for one per hardware thread
+     */
+    template <typename T>
+    template <typename InputIt>
+    void SimpleBloomFilter<T>::insertRange(InputIt first, InputIt last, size_t numThreads)
+    {
+        BulkWorkspace workspace = makeBulkWorkspace(numThreads);
+        size_t numKeys = 0;
+
+        if constexpr (std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>)
         {
-            _visualiser.logAction("\033[33m[Query False Positive]\033[0m " + item);
+            const size_t total = static_cast<size_t>(std::distance(first, last));
+            for (size_t offset = 0; offset < total; offset += BULK_BATCH_SIZE)
+            {
+                insertBatch(first + offset, std::min(BULK_BATCH_SIZE, total - offset), workspace);
+            }
+            numKeys = total;
         }
         else
         {
-            _visualiser.logAction("\033[34m[Query Hit]\033[0m " + item);
+            // Single pass iterators are buffered a batch at a time
+            std::vector<typename std::iterator_traits<InputIt>::value_type> batch;
+            batch.reserve(BULK_BATCH_SIZE);
+            while (first != last)
+            {
+                batch.clear();
+                for (; first != last && batch.size() < BULK_BATCH_SIZE; ++first)
+                {
+                    batch.push_back(*first);
+                }
+                insertBatch(batch.begin(), batch.size(), workspace);
+                numKeys += batch.size();
+            }
         }
 
-        _visualiser.logState(*this, std::nullopt, VisualContext::QUERY);
+        finishBulkInsert(numKeys);
+    }
 
-        const auto falsePositiveProbability = computeFalsePositiveProbability();
-        return std::make_optional<float>(falsePositiveProbability);
+    /**
+     * @brief Bulk insert of every key in a newline separated or length-prefixed dump.
+     * The next block of the file is read while the current one is hashed and inserted.
+     *
+     * @tparam T
+     * @param path
+     * @param format
+     * @param numThreads 0 for one per hardware thread
+     * @return true if the whole file was read
+     * @return false if it could not be opened or ended inside a record
+     */
+    template <typename T>
+    template <typename U, typename>
+    bool SimpleBloomFilter<T>::insertFromFile(const std::string& path, core::KeyFileFormat format, size_t numThreads)
+    {
+        core::KeyFileReader reader(path, format);
+        if (!reader.isOpen())
+            return false;
+
+        BulkWorkspace workspace = makeBulkWorkspace(numThreads);
+        std::vector<std::string_view> current, upcoming;
+        size_t numKeys = 0;
+
+        bool more = reader.next(current);
+        while (more)
+        {
+            auto pending = std::async(std::launch::async, [&reader, &upcoming] { return reader.next(upcoming); });
+            insertBatch(current.begin(), current.size(), workspace);
+            numKeys += current.size();
+            more = pending.get();
+            std::swap(current, upcoming);
+        }
+
+        finishBulkInsert(numKeys);
+        return !reader.isTruncated();
+    }
+
+    /**
+     * @brief Splits the bit array into one word aligned region per thread
+     *
+     * @tparam T
+     * @param numThreads
+     * @return BulkWorkspace
+     */
+    template <typename T>
+    typename SimpleBloomFilter<T>::BulkWorkspace SimpleBloomFilter<T>::makeBulkWorkspace(size_t numThreads) const
+    {
+        BulkWorkspace workspace;
+        workspace.numThreads = std::max<size_t>(1, std::min(core::resolveThreadCount(numThreads), _bitArray.numWords()));
+        workspace.regionBits = ((_bitArray.numWords() + workspace.numThreads - 1) / workspace.numThreads) * 64;
+        workspace.positions.assign(workspace.numThreads, std::vector<std::vector<size_t>>(workspace.numThreads));
+        return workspace;
+    }
+
+    /**
+     * @brief Hashes a slice of the batch per thread into per-region buckets, then has each
+     * thread set the bits of its own region from every thread's bucket for it
+     *
+     * @tparam T
+     * @tparam RandomIt
+     * @param keys
+     * @param numKeys
+     * @param workspace
+     */
+    template <typename T>
+    template <typename RandomIt>
+    void SimpleBloomFilter<T>::insertBatch(RandomIt keys, size_t numKeys, BulkWorkspace& workspace)
+    {
+        const size_t size = _bitArray.size();
+        if (size == 0 || _k == 0)
+            return;
+
+        const size_t numThreads = workspace.numThreads;
+        const size_t slice = (numKeys + numThreads - 1) / numThreads;
+
+        core::parallelFor(numThreads, [&](size_t t) {
+            auto& buckets = workspace.positions[t];
+            const size_t begin = std::min(numKeys, t * slice);
+            const size_t end = std::min(numKeys, begin + slice);
+            for (size_t i = begin; i < end; ++i)
+            {
+                // h_i(x) = std::hash(x) ^ (i * multiplier), as in the hash functions used by insert
+                const size_t baseHash = core::keyHash<T>(keys[i]);
+                for (size_t j = 0; j < _k; ++j)
+                {
+                    const size_t idx = (baseHash ^ (j * core::HASH_SEED_MULTIPLIER)) % size;
+                    buckets[idx / workspace.regionBits].push_back(idx);
+                }
+            }
+        });
+
+        uint64_t* words = _bitArray.data();
+        core::parallelFor(numThreads, [&](size_t region) {
+            for (auto& buckets : workspace.positions)
+            {
+                for (size_t idx : buckets[region])
+                {
+                    words[idx / 64] |= uint64_t{1} << (idx % 64);
+                }
+                buckets[region].clear();
+            }
+        });
+
+        if constexpr (VISUALISE)
+        {
+            for (size_t i = 0; i < numKeys; ++i)
+            {
+                _items.insert(T(keys[i]));
+            }
+        }
+    }
+
+    /**
+     * @brief Recounts the set bits once the bulk insert has finished
+     *
+     * @tparam T
+     * @param numKeys
+     */
+    template <typename T>
+    void SimpleBloomFilter<T>::finishBulkInsert(size_t numKeys)
+    {
+        _count = static_cast<int32_t>(_bitArray.recount());
+
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("[Bulk Insert] " + std::to_string(numKeys) + " items");
+            _visualiser.logState(*this, std::nullopt, VisualContext::INSERT);
+        }
+
+        _metrics.recordInsert(numKeys);
+        publishMetrics();
+    }
+
+    /**
+     * @brief Compresses the filter for shipping to another node. A filter with few bits set,
+     * as a sized-for-growth filter is for most of its life, shrinks severalfold; one near
+     * half full is close to incompressible either way. decode accepts at most 64 hash
+     * functions, far more than any useful false positive rate needs.
+     *
+     * @tparam T
+     * @param encoding GOLOMB_RICE codes the gaps between set bits, RUN_LENGTH the runs of equal bits
+     * @return std::pmr::vector<uint8_t> Drawn from the filter's memory resource
+     */
+    template <typename T>
+    std::pmr::vector<uint8_t> SimpleBloomFilter<T>::encode(WireEncoding encoding) const
+    {
+        const size_t numBits = _bitArray.size();
+        const size_t setBits = _bitArray.count();
+        const uint64_t* words = _bitArray.data();
+
+        core::BitWriter writer(_bitArray.resource());
+        writer.writeBits(static_cast<uint8_t>(encoding), 8);
+        writer.writeBits(_k, 32);
+        writer.writeBits(numBits, 64);
+        writer.writeBits(setBits, 64);
+
+        if (encoding == WireEncoding::GOLOMB_RICE)
+        {
+            const size_t riceBits = riceParameter(numBits, setBits);
+            writer.writeBits(riceBits, 6);
+
+            size_t next = 0; // Position the next gap is measured from
+            for (size_t w = 0; w < _bitArray.numWords(); ++w)
+            {
+                for (uint64_t word = words[w]; word != 0; word &= word - 1)
+                {
+                    const size_t pos = w * 64 + static_cast<size_t>(__builtin_ctzll(word));
+                    writer.writeRice(pos - next, riceBits);
+                    next = pos + 1;
+                }
+            }
+        }
+        else
+        {
+            // First position at or after start whose bit differs from value, or numBits
+            auto runEnd = [&](size_t start, bool value) {
+                for (size_t w = start / 64; w < _bitArray.numWords(); ++w)
+                {
+                    uint64_t differing = value ? ~words[w] : words[w];
+                    if (w == start / 64)
+                    {
+                        differing &= ~uint64_t{0} << (start % 64);
+                    }
+                    if (differing != 0)
+                        return std::min(numBits, w * 64 + static_cast<size_t>(__builtin_ctzll(differing)));
+                }
+                return numBits;
+            };
+
+            bool value = numBits > 0 && _bitArray.test(0);
+            writer.writeBits(value, 1);
+            for (size_t start = 0; start < numBits; value = !value)
+            {
+                const size_t end = runEnd(start, value);
+                writer.writeGamma(end - start);
+                start = end;
+            }
+        }
+
+        return writer.finish();
+    }
+
+    /**
+     * @brief Replaces the filter with one produced by encode(), taking its number of hash
+     * functions and bits from the encoding
+     *
+     * @tparam T
+     * @param data
+     * @param size
+     * @return true
+     * @return false if the encoding is truncated or malformed, leaving the filter unchanged
+     */
+    template <typename T>
+    bool SimpleBloomFilter<T>::decode(const uint8_t* data, size_t size)
+    {
+        core::BitReader reader(data, size);
+        WireHeader header;
+        if (!readWireHeader(reader, header))
+            return false;
+
+        // Check the whole encoding before allocating the bit array a corrupt header may ask for
+        core::BitReader check = reader;
+        size_t setBits = 0;
+        if (!forEachEncodedBit(check, header, [&setBits](size_t) { ++setBits; return true; }) || setBits != header.setBits)
+            return false;
+
+        core::BitArray bits(header.numBits, _bitArray.resource());
+        if (!forEachEncodedBit(reader, header, [&bits](size_t pos) { bits.set(pos); return true; }) ||
+            bits.count() != header.setBits)
+            return false;
+
+        init(header.numHashes, header.numBits);
+        _bitArray = std::move(bits);
+        _count = static_cast<int32_t>(_bitArray.count());
+        _items.clear();
+
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("[Decode] " + std::to_string(size) + " bytes -> " + std::to_string(_count) +
+                                  " of " + std::to_string(_bitArray.size()) + " bits set");
+            _visualiser.logState(*this, std::nullopt, VisualContext::INIT);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Answers a query straight from an encoded filter, decoding set bits in order only
+     * until the item's k positions have been passed. Costs time linear in the encoded size and
+     * no allocation for k up to 32, so suits small filters on nodes that never expand them.
+     *
+     * @tparam T
+     * @tparam K T, or a key that hashes like it such as a std::string_view
+     * @param data
+     * @param size
+     * @param item
+     * @return std::optional<float> The false positive probability if the item may be present;
+     * std::nullopt if it is not, or if the encoding is malformed
+     */
+    template <typename T>
+    template <typename K>
+    std::optional<float> SimpleBloomFilter<T>::queryEncoded(const uint8_t* data, size_t size, const K& item)
+    {
+        static_assert(std::is_same_v<K, T> || core::isTransparentKey<T, K>, "K must be T or hash like it");
+
+        core::BitReader reader(data, size);
+        WireHeader header;
+        if (!readWireHeader(reader, header))
+            return std::nullopt;
+
+        std::array<size_t, 32> buffer;
+        std::pmr::monotonic_buffer_resource arena(buffer.data(), sizeof(buffer));
+        std::pmr::vector<size_t> targets(&arena);
+        targets.reserve(header.numHashes);
+
+        const size_t baseHash = core::transparentHash(item);
+        for (size_t i = 0; i < header.numHashes; ++i)
+        {
+            targets.push_back((baseHash ^ (i * core::HASH_SEED_MULTIPLIER)) % header.numBits);
+        }
+        std::sort(targets.begin(), targets.end());
+
+        size_t next = 0; // First target not yet found set
+        bool missed = false;
+        auto visit = [&](size_t pos) {
+            if (next < targets.size() && targets[next] < pos)
+            {
+                missed = true; // The target lies in a run of clear bits
+                return false;
+            }
+            while (next < targets.size() && targets[next] == pos)
+            {
+                ++next;
+            }
+            return next < targets.size();
+        };
+
+        if (next < targets.size() && (!forEachEncodedBit(reader, header, visit) || missed || next < targets.size()))
+            return std::nullopt;
+
+        return std::make_optional<float>(computeFalsePositiveProbability(header.numHashes, header.setBits, header.numBits));
     }
 
     /**
@@ -119,7 +554,7 @@ namespace pds::bloomFilter
     template <typename T>
     int32_t SimpleBloomFilter<T>::getLoadFactor() const
     {
-        return (_count * 100) / BIT_ARRAY_SIZE;
+        return static_cast<int32_t>((static_cast<size_t>(_count) * 100) / _bitArray.size());
     }
 
     /**
@@ -146,4 +581,160 @@ namespace pds::bloomFilter
     {
         return _count == 0;
     }
-}
\ No newline at end of file
+
+    /**
+     * @brief Snapshot of the operation counters and the fraction of bits set
+     *
+     * @tparam T
+     * @return core::Stats
+     */
+    template <typename T>
+    core::Stats SimpleBloomFilter<T>::stats() const
+    {
+        const size_t size = _bitArray.size();
+        return _metrics.snapshot(size == 0 ? 0.0f : static_cast<float>(_bitArray.count()) / static_cast<float>(size));
+    }
+
+    /**
+     * @brief Attaches a sink that receives stats() every publishInterval operations, or detaches it given nullptr.
+     * Has no effect unless PDS_METRICS is 1.
+     *
+     * @tparam T
+     * @param sink
+     * @param publishInterval
+     */
+    template <typename T>
+    void SimpleBloomFilter<T>::setMetricsSink(core::MetricsSink* sink, uint64_t publishInterval)
+    {
+        _metrics.setSink(sink, publishInterval);
+    }
+
+    /**
+     * @brief Has the visualiser emit sampled, run-length encoded snapshots to the writer
+     * instead of drawing every operation to std::cout. Only has an effect while PDS_VISUALISE is 1.
+     *
+     * @tparam T
+     * @param writer
+     */
+    template <typename T>
+    void SimpleBloomFilter<T>::setSnapshotWriter(core::SnapshotWriter* writer)
+    {
+        _visualiser.setSnapshotWriter(writer);
+    }
+
+    template <typename T>
+    void SimpleBloomFilter<T>::publishMetrics() const
+    {
+        if (_metrics.publishDue())
+        {
+            _metrics.publish("SimpleBloomFilter", stats());
+        }
+    }
+
+    template <typename T>
+    bool SimpleBloomFilter<T>::readWireHeader(core::BitReader& reader, WireHeader& header)
+    {
+        uint64_t encoding = 0;
+        uint64_t numHashes = 0;
+        uint64_t numBits = 0;
+        uint64_t setBits = 0;
+        if (!reader.readBits(8, encoding) || !reader.readBits(32, numHashes) ||
+            !reader.readBits(64, numBits) || !reader.readBits(64, setBits))
+            return false;
+
+        if (encoding != static_cast<uint8_t>(WireEncoding::GOLOMB_RICE) && encoding != static_cast<uint8_t>(WireEncoding::RUN_LENGTH))
+            return false;
+        if (numBits == 0 || numBits > MAX_WIRE_BITS || setBits > numBits || numHashes == 0 || numHashes > MAX_WIRE_HASHES)
+            return false;
+
+        uint64_t riceBits = 0;
+        if (encoding == static_cast<uint8_t>(WireEncoding::GOLOMB_RICE) && !reader.readBits(6, riceBits))
+            return false;
+
+        header = {static_cast<WireEncoding>(encoding), static_cast<size_t>(numHashes), static_cast<size_t>(numBits),
+                  static_cast<size_t>(setBits), static_cast<size_t>(riceBits)};
+        return true;
+    }
+
+    /**
+     * @brief Golomb-Rice parameter for gaps that are roughly geometric with mean numBits / setBits:
+     * the largest power of two not above ln(2) times the mean
+     *
+     * @tparam T
+     * @param numBits
+     * @param setBits
+     * @return size_t
+     */
+    template <typename T>
+    size_t SimpleBloomFilter<T>::riceParameter(size_t numBits, size_t setBits)
+    {
+        if (setBits == 0)
+            return 0;
+
+        const double target = 0.6931471805599453 * static_cast<double>(numBits) / static_cast<double>(setBits);
+        size_t riceBits = 0;
+        while (riceBits < 62 && std::ldexp(1.0, static_cast<int>(riceBits + 1)) <= target)
+        {
+            ++riceBits;
+        }
+        return riceBits;
+    }
+
+    /**
+     * @brief Decodes the set bit positions that follow the header, in increasing order, calling
+     * visit on each until it returns false
+     *
+     * @tparam T
+     * @tparam Visit bool(size_t position)
+     * @param reader Positioned just past the header
+     * @param header
+     * @param visit
+     * @return true if the bits decoded, or visit stopped early
+     * @return false if the encoding is truncated or malformed
+     */
+    template <typename T>
+    template <typename Visit>
+    bool SimpleBloomFilter<T>::forEachEncodedBit(core::BitReader& reader, const WireHeader& header, Visit visit)
+    {
+        if (header.encoding == WireEncoding::GOLOMB_RICE)
+        {
+            size_t next = 0;
+            for (size_t i = 0; i < header.setBits; ++i)
+            {
+                uint64_t gap = 0;
+                if (!reader.readRice(header.riceBits, gap) || gap >= header.numBits - next)
+                    return false;
+
+                const size_t pos = next + static_cast<size_t>(gap);
+                if (!visit(pos))
+                    return true;
+                next = pos + 1;
+            }
+            return true;
+        }
+
+        uint64_t value = 0;
+        if (!reader.readBits(1, value))
+            return false;
+
+        size_t setBits = 0;
+        for (size_t pos = 0; pos < header.numBits; value ^= 1)
+        {
+            uint64_t run = 0;
+            if (!reader.readGamma(run) || run > header.numBits - pos)
+                return false;
+
+            if (value)
+            {
+                for (size_t i = 0; i < run; ++i)
+                {
+                    if (!visit(pos + i))
+                        return true;
+                }
+                setBits += static_cast<size_t>(run);
+            }
+            pos += static_cast<size_t>(run);
+        }
+        return setBits == header.setBits;
+    }
+}
@@ -2,10 +2,10 @@
 
 #include <iostream>
 #include <optional>
-#include <bitset>
 #include <iomanip>
 
 #include "pds/core/common.h"
+#include "pds/core/snapshotWriter.h"
 
 namespace pds::bloomFilter
 {
@@ -17,6 +17,16 @@ namespace pds::bloomFilter
     class SimpleBloomFilterVisualiser
     {
         public:
+        /**
+         * @brief Sends sampled snapshots to the writer instead of drawing to std::cout, or draws again given nullptr
+         *
+         * @param writer
+         */
+        void setSnapshotWriter(core::SnapshotWriter* writer)
+        {
+            _writer = writer;
+        }
+
         /**
          * @brief Logs the current state of the Bloom Filter by printing the bit array
          *
@@ -28,7 +38,15 @@ namespace pds::bloomFilter
                       std::optional<size_t> highlight = std::nullopt,
                       pds::VisualContext ctx = pds::VisualContext::UNKNOWN) const
         {
+            if (_writer != nullptr)
+            {
+                _writer->capture("SimpleBloomFilter", ctx, highlight, _lastAction, table._bitArray.size(),
+                                 [&table](size_t i) { return table._bitArray.test(i); });
+                return;
+            }
+
             constexpr size_t rowSize = 32;
+            const size_t bitArraySize = table._bitArray.size();
             std::cout << "\nBit Array State:\n\n";
 
             if(ctx == pds::VisualContext::QUERY)
@@ -42,9 +60,9 @@ namespace pds::bloomFilter
             }
             
 
-            for (size_t i = 0; i < BIT_ARRAY_SIZE; ++i)
+            for (size_t i = 0; i < bitArraySize; ++i)
             {
-                bool isSet = table._bitArray->test(i);
+                bool isSet = table._bitArray.test(i);
 
                 if (highlight.has_value() && highlight.value() == i)
                 {
@@ -67,10 +85,10 @@ namespace pds::bloomFilter
                 }
             }
 
-            if (BIT_ARRAY_SIZE % rowSize != 0)
+            if (bitArraySize % rowSize != 0)
             {
-                std::cout << "  <- [" << BIT_ARRAY_SIZE - (BIT_ARRAY_SIZE % rowSize)
-                          << " - " << BIT_ARRAY_SIZE - 1 << "]\n";
+                std::cout << "  <- [" << bitArraySize - (bitArraySize % rowSize)
+                          << " - " << bitArraySize - 1 << "]\n";
             }
 
             std::cout << "\n";
@@ -101,7 +119,16 @@ namespace pds::bloomFilter
          */
         void logAction(const std::string& action) const
         {
+            if (_writer != nullptr)
+            {
+                _lastAction = action;
+                return;
+            }
             std::cout << "[LOG] " << action << "\n";
         }
+
+        private:
+        core::SnapshotWriter* _writer = nullptr;
+        mutable std::string _lastAction; // Attached to the next snapshot
     };
 }
\ No newline at end of file
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <memory_resource>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "pds/core/common.h"
+#include "pds/core/hash.h"
+
+namespace pds::bloomFilter
+{
+    /**
+     * @brief Blocked Bloom filter kept in a file, for sets whose filter is larger than memory.
+     * Each item hashes to one 4KB block and sets all k of its bits inside it, so a query reads
+     * at most one page, through a small LRU cache of pages. Inserts are buffered in memory and
+     * written out in batches sorted by block, so each dirty block is read and rewritten once
+     * per flush and runs of neighbouring blocks move in single pread/pwrite calls.
+     *
+     * The first page of the file is a header recording the number of blocks, hash functions and
+     * items, so a filter can be reopened. Needs a POSIX system. The filter owns a file
+     * descriptor, so it cannot be copied.
+     *
+     * @tparam T
+     */
+    template <typename T>
+    class SsdBloomFilter
+    {
+        public:
+        static constexpr size_t PAGE_SIZE = 4096;
+        static constexpr size_t BLOCK_BITS = PAGE_SIZE * 8;
+
+        explicit SsdBloomFilter(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+        ~SsdBloomFilter();
+
+        SsdBloomFilter(const SsdBloomFilter&) = delete;
+        SsdBloomFilter& operator=(const SsdBloomFilter&) = delete;
+
+        bool create(const std::string& path, size_t numBlocks, size_t numHashFunctions = 7,
+                    size_t maxBufferedInserts = 1 << 16, size_t cachePages = 64);
+        bool open(const std::string& path, size_t maxBufferedInserts = 1 << 16, size_t cachePages = 64);
+        bool flush();
+        bool close();
+
+        bool insert(const T& item);
+        std::optional<float> query(const T& item) const;
+
+        size_t getNumBlocks() const;
+        size_t getInsertedCount() const;
+        size_t getBufferedCount() const;
+        uint64_t getPageReads() const;
+        bool isEmpty() const;
+        bool isOpen() const;
+
+        private:
+        static constexpr uint64_t MAGIC = 0x3130464253534450; // "PDSSBF01"
+        static constexpr size_t MAX_RUN_PAGES = 256; // Longest run of blocks moved in one pread/pwrite
+        static constexpr size_t NO_BLOCK = ~size_t{0};
+
+        struct Header
+        {
+            uint64_t magic;
+            uint64_t numBlocks;
+            uint64_t numHashes;
+            uint64_t inserted;
+        };
+
+        size_t blockOf(uint64_t hash) const;
+        template <typename Visit>
+        void forEachBit(uint64_t hash, Visit visit) const;
+        const uint8_t* page(size_t block) const;
+        bool writeHeader();
+        bool readPages(uint8_t* buffer, size_t firstBlock, size_t numPages) const;
+        bool writePages(const uint8_t* buffer, size_t firstBlock, size_t numPages);
+        void setup(size_t maxBufferedInserts, size_t cachePages);
+        void release();
+
+        float computeFalsePositiveProbability() const
+        {
+            if (_numHashes == 0 || _inserted == 0)
+                return 0.0f;
+
+            // Items spread evenly over the blocks, each setting k bits of its own block
+            const float perBlock = static_cast<float>(_inserted) / static_cast<float>(_numBlocks);
+            const float base = 1.0f - std::exp(-static_cast<float>(_numHashes) * perBlock / static_cast<float>(BLOCK_BITS));
+            return std::pow(base, static_cast<float>(_numHashes));
+        }
+
+        std::pmr::memory_resource* _resource;
+        int _fd;
+        size_t _numBlocks;
+        size_t _numHashes;
+        size_t _inserted;
+        size_t _maxBuffered;
+
+        std::pmr::unordered_set<uint64_t> _buffer; // Hashes of items inserted since the last flush
+        std::pmr::vector<uint64_t> _sorted; // Buffer in block order, reused by flush
+        uint8_t* _ioBuffer; // MAX_RUN_PAGES pages, page aligned
+
+        // Page cache, mutable as queries fill it
+        size_t _cachePages;
+        uint8_t* _cacheFrames; // _cachePages pages, page aligned
+        mutable std::pmr::vector<size_t> _frameBlock; // Block held by each frame, or NO_BLOCK
+        mutable std::pmr::vector<uint64_t> _frameUsed; // Tick of each frame's last use, for LRU eviction
+        mutable std::pmr::unordered_map<size_t, size_t> _cachedFrame; // Block -> frame
+        mutable uint64_t _tick;
+        mutable uint64_t _pageReads;
+    };
+}
+
+#include "ssdBloomFilterImpl.h"
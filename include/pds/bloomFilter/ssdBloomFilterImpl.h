@@ -0,0 +1,446 @@
+#pragma once
+
+namespace pds::bloomFilter
+{
+    /**
+     * @brief Construct a new Ssd Bloom Filter< T>:: Ssd Bloom Filter object, with its insert
+     * buffer and page cache drawn from the given memory resource. Call create or open before use.
+     *
+     * @tparam T
+     * @param resource
+     */
+    template <typename T>
+    SsdBloomFilter<T>::SsdBloomFilter(std::pmr::memory_resource* resource)
+        : _resource(resource), _fd(-1), _numBlocks(0), _numHashes(0), _inserted(0), _maxBuffered(0),
+          _buffer(resource), _sorted(resource), _ioBuffer(nullptr), _cachePages(0), _cacheFrames(nullptr),
+          _frameBlock(resource), _frameUsed(resource), _cachedFrame(resource), _tick(0), _pageReads(0) {}
+
+    /**
+     * @brief Flushes buffered inserts and closes the file
+     *
+     * @tparam T
+     */
+    template <typename T>
+    SsdBloomFilter<T>::~SsdBloomFilter()
+    {
+        close();
+    }
+
+    /**
+     * @brief Creates, or truncates, the file at path as an empty filter of numBlocks 4KB blocks.
+     * The blocks are allocated lazily by the file system, so creation is quick.
+     *
+     * @tparam T
+     * @param path
+     * @param numBlocks
+     * @param numHashFunctions Bits set per item, all within its block
+     * @param maxBufferedInserts Inserts held in memory before they are flushed
+     * @param cachePages Pages of the file kept in memory for queries
+     * @return true
+     * @return false if the file could not be created
+     */
+    template <typename T>
+    bool SsdBloomFilter<T>::create(const std::string& path, size_t numBlocks, size_t numHashFunctions,
+                                   size_t maxBufferedInserts, size_t cachePages)
+    {
+        close();
+        if (numBlocks == 0 || numHashFunctions == 0)
+            return false;
+
+        _fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+        if (_fd < 0)
+            return false;
+
+        _numBlocks = numBlocks;
+        _numHashes = numHashFunctions;
+        _inserted = 0;
+        if (::ftruncate(_fd, static_cast<off_t>((numBlocks + 1) * PAGE_SIZE)) != 0 || !writeHeader())
+        {
+            release();
+            return false;
+        }
+
+        setup(maxBufferedInserts, cachePages);
+        return true;
+    }
+
+    /**
+     * @brief Opens a filter file written earlier by this class
+     *
+     * @tparam T
+     * @param path
+     * @param maxBufferedInserts
+     * @param cachePages
+     * @return true
+     * @return false if the file is missing, is not a filter, or is shorter than its header says
+     */
+    template <typename T>
+    bool SsdBloomFilter<T>::open(const std::string& path, size_t maxBufferedInserts, size_t cachePages)
+    {
+        close();
+        _fd = ::open(path.c_str(), O_RDWR);
+        if (_fd < 0)
+            return false;
+
+        Header header{};
+        struct stat info{};
+        if (::pread(_fd, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) || ::fstat(_fd, &info) != 0 ||
+            header.magic != MAGIC || header.numBlocks == 0 || header.numHashes == 0 ||
+            static_cast<uint64_t>(info.st_size) < (header.numBlocks + 1) * PAGE_SIZE)
+        {
+            release();
+            return false;
+        }
+
+        _numBlocks = static_cast<size_t>(header.numBlocks);
+        _numHashes = static_cast<size_t>(header.numHashes);
+        _inserted = static_cast<size_t>(header.inserted);
+        setup(maxBufferedInserts, cachePages);
+        return true;
+    }
+
+    /**
+     * @brief Writes the buffered inserts to the file. They are sorted by block, and each run of
+     * consecutive dirty blocks is read, updated and written back with one pread and one pwrite.
+     *
+     * @tparam T
+     * @return true
+     * @return false on an I/O error, in which case the buffered inserts are kept
+     */
+    template <typename T>
+    bool SsdBloomFilter<T>::flush()
+    {
+        if (_fd < 0)
+            return false;
+        if (_buffer.empty())
+            return true;
+
+        _sorted.assign(_buffer.begin(), _buffer.end());
+        std::sort(_sorted.begin(), _sorted.end(), [this](uint64_t a, uint64_t b) { return blockOf(a) < blockOf(b); });
+
+        size_t i = 0;
+        while (i < _sorted.size())
+        {
+            // Extend the run while the next dirty block directly follows the last one
+            const size_t firstBlock = blockOf(_sorted[i]);
+            size_t end = i;
+            size_t lastBlock = firstBlock;
+            while (end < _sorted.size())
+            {
+                const size_t block = blockOf(_sorted[end]);
+                if (block != lastBlock && (block != lastBlock + 1 || block - firstBlock >= MAX_RUN_PAGES))
+                    break;
+                lastBlock = block;
+                ++end;
+            }
+
+            const size_t numPages = lastBlock - firstBlock + 1;
+            if (!readPages(_ioBuffer, firstBlock, numPages))
+                return false;
+
+            for (size_t j = i; j < end; ++j)
+            {
+                uint8_t* bits = _ioBuffer + (blockOf(_sorted[j]) - firstBlock) * PAGE_SIZE;
+                forEachBit(_sorted[j], [bits](size_t bit) { bits[bit / 8] |= static_cast<uint8_t>(1u << (bit % 8)); });
+            }
+
+            if (!writePages(_ioBuffer, firstBlock, numPages))
+                return false;
+
+            // Keep cached copies of the rewritten pages current
+            for (size_t block = firstBlock; block <= lastBlock; ++block)
+            {
+                auto cached = _cachedFrame.find(block);
+                if (cached != _cachedFrame.end())
+                {
+                    std::memcpy(_cacheFrames + cached->second * PAGE_SIZE, _ioBuffer + (block - firstBlock) * PAGE_SIZE, PAGE_SIZE);
+                }
+            }
+            i = end;
+        }
+
+        _buffer.clear();
+        return writeHeader();
+    }
+
+    /**
+     * @brief Flushes buffered inserts and closes the file
+     *
+     * @tparam T
+     * @return true
+     * @return false if the final flush failed
+     */
+    template <typename T>
+    bool SsdBloomFilter<T>::close()
+    {
+        if (_fd < 0)
+            return true;
+
+        const bool flushed = flush();
+        release();
+        return flushed;
+    }
+
+    /**
+     * @brief Insert an item, flushing first if the buffer is full
+     *
+     * @tparam T
+     * @param item
+     * @return true
+     * @return false if the filter is not open or the flush failed
+     */
+    template <typename T>
+    bool SsdBloomFilter<T>::insert(const T& item)
+    {
+        if (_fd < 0 || (_buffer.size() >= _maxBuffered && !flush()))
+            return false;
+
+        _buffer.insert(core::mixedHash(item));
+        ++_inserted;
+        return true;
+    }
+
+    /**
+     * @brief Query if an item is possibly in the filter. Buffered inserts are checked in memory;
+     * otherwise the item's block is looked up in the page cache and read on a miss, so a query
+     * costs at most one page read. An unreadable page reports the item as possibly present.
+     *
+     * @tparam T
+     * @param item
+     * @return std::optional<float>
+     */
+    template <typename T>
+    std::optional<float> SsdBloomFilter<T>::query(const T& item) const
+    {
+        if (_fd < 0)
+            return std::nullopt;
+
+        const uint64_t hash = core::mixedHash(item);
+        if (_buffer.find(hash) != _buffer.end())
+            return std::make_optional<float>(computeFalsePositiveProbability());
+
+        const uint8_t* bits = page(blockOf(hash));
+        if (bits == nullptr)
+            return std::make_optional<float>(1.0f);
+
+        bool present = true;
+        forEachBit(hash, [bits, &present](size_t bit) { present = present && ((bits[bit / 8] >> (bit % 8)) & 1); });
+        if (!present)
+            return std::nullopt;
+
+        return std::make_optional<float>(computeFalsePositiveProbability());
+    }
+
+    template <typename T>
+    size_t SsdBloomFilter<T>::getNumBlocks() const
+    {
+        return _numBlocks;
+    }
+
+    template <typename T>
+    size_t SsdBloomFilter<T>::getInsertedCount() const
+    {
+        return _inserted;
+    }
+
+    template <typename T>
+    size_t SsdBloomFilter<T>::getBufferedCount() const
+    {
+        return _buffer.size();
+    }
+
+    /**
+     * @brief Pages read from the file by queries, i.e. page cache misses
+     *
+     * @tparam T
+     * @return uint64_t
+     */
+    template <typename T>
+    uint64_t SsdBloomFilter<T>::getPageReads() const
+    {
+        return _pageReads;
+    }
+
+    template <typename T>
+    bool SsdBloomFilter<T>::isEmpty() const
+    {
+        return _inserted == 0;
+    }
+
+    template <typename T>
+    bool SsdBloomFilter<T>::isOpen() const
+    {
+        return _fd >= 0;
+    }
+
+    /**
+     * @brief Block of an item, from the high half of its hash
+     *
+     * @tparam T
+     * @param hash
+     * @return size_t
+     */
+    template <typename T>
+    size_t SsdBloomFilter<T>::blockOf(uint64_t hash) const
+    {
+        return static_cast<size_t>(((hash >> 32) * _numBlocks) >> 32);
+    }
+
+    /**
+     * @brief Calls visit with each of the k bit positions of an item within its block, by double
+     * hashing on a remix of its hash
+     *
+     * @tparam T
+     * @tparam Visit
+     * @param hash
+     * @param visit
+     */
+    template <typename T>
+    template <typename Visit>
+    void SsdBloomFilter<T>::forEachBit(uint64_t hash, Visit visit) const
+    {
+        const uint64_t mixed = core::mix64(hash);
+        const size_t first = static_cast<size_t>(mixed);
+        const size_t step = static_cast<size_t>(mixed >> 32) | 1;
+        for (size_t i = 0; i < _numHashes; ++i)
+        {
+            visit((first + i * step) % BLOCK_BITS);
+        }
+    }
+
+    /**
+     * @brief Returns a cached copy of a block, reading it into the least recently used frame on a miss
+     *
+     * @tparam T
+     * @param block
+     * @return const uint8_t* nullptr if the read failed
+     */
+    template <typename T>
+    const uint8_t* SsdBloomFilter<T>::page(size_t block) const
+    {
+        ++_tick;
+        auto cached = _cachedFrame.find(block);
+        if (cached != _cachedFrame.end())
+        {
+            _frameUsed[cached->second] = _tick;
+            return _cacheFrames + cached->second * PAGE_SIZE;
+        }
+
+        const size_t frame = static_cast<size_t>(std::min_element(_frameUsed.begin(), _frameUsed.end()) - _frameUsed.begin());
+        if (_frameBlock[frame] != NO_BLOCK)
+        {
+            _cachedFrame.erase(_frameBlock[frame]);
+            _frameBlock[frame] = NO_BLOCK;
+            _frameUsed[frame] = 0;
+        }
+
+        uint8_t* bits = _cacheFrames + frame * PAGE_SIZE;
+        ++_pageReads;
+        if (!readPages(bits, block, 1))
+            return nullptr;
+
+        _frameBlock[frame] = block;
+        _frameUsed[frame] = _tick;
+        _cachedFrame.emplace(block, frame);
+        return bits;
+    }
+
+    template <typename T>
+    bool SsdBloomFilter<T>::writeHeader()
+    {
+        Header header{MAGIC, _numBlocks, _numHashes, _inserted};
+        return ::pwrite(_fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header));
+    }
+
+    /**
+     * @brief Reads numPages consecutive blocks, retrying short reads
+     *
+     * @tparam T
+     * @param buffer
+     * @param firstBlock
+     * @param numPages
+     * @return true
+     * @return false
+     */
+    template <typename T>
+    bool SsdBloomFilter<T>::readPages(uint8_t* buffer, size_t firstBlock, size_t numPages) const
+    {
+        const size_t bytes = numPages * PAGE_SIZE;
+        const off_t offset = static_cast<off_t>((firstBlock + 1) * PAGE_SIZE); // Past the header page
+        for (size_t done = 0; done < bytes;)
+        {
+            const ssize_t n = ::pread(_fd, buffer + done, bytes - done, offset + static_cast<off_t>(done));
+            if (n <= 0)
+                return false;
+            done += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    template <typename T>
+    bool SsdBloomFilter<T>::writePages(const uint8_t* buffer, size_t firstBlock, size_t numPages)
+    {
+        const size_t bytes = numPages * PAGE_SIZE;
+        const off_t offset = static_cast<off_t>((firstBlock + 1) * PAGE_SIZE);
+        for (size_t done = 0; done < bytes;)
+        {
+            const ssize_t n = ::pwrite(_fd, buffer + done, bytes - done, offset + static_cast<off_t>(done));
+            if (n <= 0)
+                return false;
+            done += static_cast<size_t>(n);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Allocates the page-aligned I/O buffer and cache frames for a newly opened file
+     *
+     * @tparam T
+     * @param maxBufferedInserts
+     * @param cachePages
+     */
+    template <typename T>
+    void SsdBloomFilter<T>::setup(size_t maxBufferedInserts, size_t cachePages)
+    {
+        _maxBuffered = std::max<size_t>(maxBufferedInserts, 1);
+        _cachePages = std::max<size_t>(cachePages, 1);
+        _buffer.clear();
+        _buffer.reserve(_maxBuffered);
+        _ioBuffer = static_cast<uint8_t*>(_resource->allocate(MAX_RUN_PAGES * PAGE_SIZE, PAGE_SIZE));
+        _cacheFrames = static_cast<uint8_t*>(_resource->allocate(_cachePages * PAGE_SIZE, PAGE_SIZE));
+        _frameBlock.assign(_cachePages, NO_BLOCK);
+        _frameUsed.assign(_cachePages, 0);
+        _cachedFrame.clear();
+        _tick = 0;
+        _pageReads = 0;
+    }
+
+    /**
+     * @brief Closes the file without flushing and frees the buffers
+     *
+     * @tparam T
+     */
+    template <typename T>
+    void SsdBloomFilter<T>::release()
+    {
+        if (_fd >= 0)
+        {
+            ::close(_fd);
+            _fd = -1;
+        }
+        if (_ioBuffer != nullptr)
+        {
+            _resource->deallocate(_ioBuffer, MAX_RUN_PAGES * PAGE_SIZE, PAGE_SIZE);
+            _ioBuffer = nullptr;
+        }
+        if (_cacheFrames != nullptr)
+        {
+            _resource->deallocate(_cacheFrames, _cachePages * PAGE_SIZE, PAGE_SIZE);
+            _cacheFrames = nullptr;
+        }
+        _buffer.clear();
+        _frameBlock.clear();
+        _frameUsed.clear();
+        _cachedFrame.clear();
+    }
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory_resource>
+#include <utility>
+#include <vector>
+
+#include "pds/core/common.h"
+#include "pds/core/popcount.h"
+
+namespace pds::core
+{
+    /**
+     * @brief Runtime sized bit array backed by 64-bit words, with storage drawn from a
+     * std::pmr::memory_resource so that structures can live in a caller-supplied arena.
+     * Mirrors the std::bitset interface used throughout the library.
+     *
+     * The number of set bits is maintained as bits change, so count() is O(1) and can be
+     * polled freely, also from another thread such as a metrics publisher: the count is a
+     * relaxed atomic, so a concurrent count() reads a recent value without a data race.
+     * Everything else, including the bits, is single-threaded. Code that writes words
+     * directly through data() calls recount(), which uses the vectorised popcount.
+     */
+    class BitArray
+    {
+        public:
+        explicit BitArray(size_t numBits = BIT_ARRAY_SIZE,
+                          std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : _numBits(numBits), _setBits(0), _words(wordsFor(numBits), 0, resource) {}
+
+        BitArray(const BitArray& other)
+            : _numBits(other._numBits), _setBits(other.count()), _words(other._words) {}
+
+        BitArray& operator=(const BitArray& other)
+        {
+            _numBits = other._numBits;
+            _setBits.store(other.count(), std::memory_order_relaxed);
+            _words = other._words;
+            return *this;
+        }
+
+        BitArray(BitArray&& other) noexcept
+            : _numBits(std::exchange(other._numBits, 0)), _setBits(other._setBits.exchange(0, std::memory_order_relaxed)),
+              _words(std::move(other._words)) {}
+
+        BitArray& operator=(BitArray&& other) noexcept
+        {
+            _numBits = std::exchange(other._numBits, 0);
+            _setBits.store(other._setBits.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+            _words = std::move(other._words);
+            return *this;
+        }
+
+        bool test(size_t idx) const
+        {
+            return (_words[idx / 64] >> (idx % 64)) & 1;
+        }
+
+        void set(size_t idx)
+        {
+            uint64_t& word = _words[idx / 64];
+            const uint64_t bit = uint64_t{1} << (idx % 64);
+            addSetBits((word & bit) == 0);
+            word |= bit;
+        }
+
+        void reset(size_t idx)
+        {
+            uint64_t& word = _words[idx / 64];
+            const uint64_t bit = uint64_t{1} << (idx % 64);
+            addSetBits(-static_cast<size_t>((word & bit) != 0));
+            word &= ~bit;
+        }
+
+        void reset()
+        {
+            std::fill(_words.begin(), _words.end(), 0);
+            _setBits.store(0, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Changes the number of bits, clearing all of them
+         *
+         * @param numBits
+         */
+        void resize(size_t numBits)
+        {
+            _numBits = numBits;
+            _setBits.store(0, std::memory_order_relaxed);
+            _words.assign(wordsFor(numBits), 0);
+        }
+
+        /**
+         * @brief Word-wise OR of another array of the same size into this one
+         *
+         * @param other
+         * @return BitArray&
+         */
+        BitArray& operator|=(const BitArray& other)
+        {
+            const size_t n = std::min(_words.size(), other._words.size());
+            for (size_t i = 0; i < n; ++i)
+            {
+                _words[i] |= other._words[i];
+            }
+            recount();
+            return *this;
+        }
+
+        size_t count() const { return _setBits.load(std::memory_order_relaxed); }
+
+        /**
+         * @brief Calls visit with the index of every set bit in increasing order, a word at a
+         * time, so runs of 64 clear bits cost one comparison
+         *
+         * @tparam Visit
+         * @param visit
+         */
+        template <typename Visit>
+        void forEachSet(Visit&& visit) const
+        {
+            for (size_t w = 0; w < _words.size(); ++w)
+            {
+                for (uint64_t word = _words[w]; word != 0; word &= word - 1)
+                {
+                    visit(w * 64 + static_cast<size_t>(__builtin_ctzll(word)));
+                }
+            }
+        }
+
+        /**
+         * @brief Recomputes the number of set bits after words were written through data()
+         *
+         * @return size_t
+         */
+        size_t recount()
+        {
+            const size_t setBits = popcount(_words.data(), _words.size());
+            _setBits.store(setBits, std::memory_order_relaxed);
+            return setBits;
+        }
+
+        size_t size() const { return _numBits; }
+        size_t numWords() const { return _words.size(); }
+        uint64_t* data() { return _words.data(); }
+        const uint64_t* data() const { return _words.data(); }
+
+        std::pmr::memory_resource* resource() const
+        {
+            return _words.get_allocator().resource();
+        }
+
+        private:
+        static size_t wordsFor(size_t numBits)
+        {
+            return (numBits + 63) / 64;
+        }
+
+        // Only the owning thread writes the count, so a plain load and store suffice, with no
+        // locked read-modify-write on the set() and reset() path
+        void addSetBits(size_t delta)
+        {
+            _setBits.store(_setBits.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+        }
+
+        size_t _numBits;
+        std::atomic<size_t> _setBits;
+        std::pmr::vector<uint64_t> _words;
+    };
+}
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+namespace pds::core
+{
+    /**
+     * @brief Appends bit fields, least significant bit first, to a byte buffer, along with the
+     * variable length codes used by the compressed wire formats: unary, Golomb-Rice and
+     * Elias-gamma. Each code's unary prefix is a run of zeros ended by a one.
+     */
+    class BitWriter
+    {
+        public:
+        explicit BitWriter(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : _bytes(resource), _buffer(0), _bufferBits(0) {}
+
+        /**
+         * @brief Appends the low numBits bits of value
+         *
+         * @param value
+         * @param numBits At most 64
+         */
+        void writeBits(uint64_t value, size_t numBits)
+        {
+            while (numBits > 0)
+            {
+                const size_t take = numBits < 64 - _bufferBits ? numBits : 64 - _bufferBits;
+                const uint64_t chunk = take == 64 ? value : value & ((uint64_t{1} << take) - 1);
+                _buffer |= chunk << _bufferBits;
+                _bufferBits += take;
+                value = take == 64 ? 0 : value >> take;
+                numBits -= take;
+
+                if (_bufferBits == 64)
+                {
+                    flushBuffer();
+                }
+            }
+        }
+
+        void writeUnary(uint64_t value)
+        {
+            for (; value >= 64; value -= 64)
+            {
+                writeBits(0, 64);
+            }
+            writeBits(uint64_t{1} << value, value + 1);
+        }
+
+        /**
+         * @brief Golomb-Rice code with parameter 2^k: value >> k in unary, then its low k bits
+         *
+         * @param value
+         * @param k
+         */
+        void writeRice(uint64_t value, size_t k)
+        {
+            writeUnary(value >> k);
+            writeBits(value, k);
+        }
+
+        /**
+         * @brief Elias-gamma code of a value of at least 1: its bit length minus one in unary,
+         * then the bits below its leading one
+         *
+         * @param value
+         */
+        void writeGamma(uint64_t value)
+        {
+            const size_t bits = 63 - static_cast<size_t>(__builtin_clzll(value));
+            writeUnary(bits);
+            writeBits(value, bits);
+        }
+
+        size_t bitCount() const
+        {
+            return _bytes.size() * 8 + _bufferBits;
+        }
+
+        /**
+         * @brief Pads the last byte with zeros and hands over the encoded bytes
+         *
+         * @return std::pmr::vector<uint8_t>
+         */
+        std::pmr::vector<uint8_t> finish()
+        {
+            flushBuffer();
+            return std::move(_bytes);
+        }
+
+        private:
+        void flushBuffer()
+        {
+            for (size_t i = 0; i < _bufferBits; i += 8)
+            {
+                _bytes.push_back(static_cast<uint8_t>(_buffer >> i));
+            }
+            _buffer = 0;
+            _bufferBits = 0;
+        }
+
+        std::pmr::vector<uint8_t> _bytes;
+        uint64_t _buffer;
+        size_t _bufferBits;
+    };
+
+    /**
+     * @brief Reads back what a BitWriter wrote, from a buffer it does not own. Every read
+     * returns false, leaving the output untouched, if it would run past the end.
+     */
+    class BitReader
+    {
+        public:
+        BitReader(const uint8_t* data, size_t size)
+            : _data(data), _sizeBits(size * 8), _position(0) {}
+
+        bool readBits(size_t numBits, uint64_t& value)
+        {
+            if (numBits > _sizeBits - _position)
+                return false;
+
+            uint64_t result = 0;
+            size_t written = 0;
+            while (written < numBits)
+            {
+                const size_t offset = _position % 8;
+                const size_t take = numBits - written < 8 - offset ? numBits - written : 8 - offset;
+                const uint64_t bits = (_data[_position / 8] >> offset) & ((1u << take) - 1);
+                result |= bits << written;
+                written += take;
+                _position += take;
+            }
+            value = result;
+            return true;
+        }
+
+        bool readUnary(uint64_t& value)
+        {
+            uint64_t zeros = 0;
+            while (_position < _sizeBits)
+            {
+                const size_t offset = _position % 8;
+                const unsigned rest = _data[_position / 8] >> offset;
+                if (rest != 0)
+                {
+                    const size_t run = static_cast<size_t>(__builtin_ctz(rest));
+                    _position += run + 1;
+                    value = zeros + run;
+                    return _position <= _sizeBits;
+                }
+                zeros += 8 - offset;
+                _position += 8 - offset;
+            }
+            return false;
+        }
+
+        bool readRice(size_t k, uint64_t& value)
+        {
+            uint64_t quotient = 0;
+            uint64_t remainder = 0;
+            if (!readUnary(quotient) || quotient > (~uint64_t{0} >> k) || !readBits(k, remainder))
+                return false;
+
+            value = (quotient << k) | remainder;
+            return true;
+        }
+
+        bool readGamma(uint64_t& value)
+        {
+            uint64_t bits = 0;
+            uint64_t low = 0;
+            if (!readUnary(bits) || bits > 63 || !readBits(static_cast<size_t>(bits), low))
+                return false;
+
+            value = (uint64_t{1} << bits) | low;
+            return true;
+        }
+
+        size_t bitsRemaining() const
+        {
+            return _sizeBits - _position;
+        }
+
+        private:
+        const uint8_t* _data;
+        size_t _sizeBits;
+        size_t _position;
+    };
+}
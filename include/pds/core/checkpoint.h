@@ -0,0 +1,340 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <istream>
+#include <memory_resource>
+#include <ostream>
+#include <vector>
+
+#include "pds/core/bitArray.h"
+#include "pds/core/hash.h"
+
+namespace pds::core
+{
+    inline constexpr size_t CHECKPOINT_PAGE_SIZE = 4096;
+    inline constexpr size_t MAX_CHECKPOINT_REGIONS = 4;
+    inline constexpr size_t CHECKPOINT_STATE_WORDS = 4;
+
+    /**
+     * @brief One bit per 4KB page of a byte region, set when the page is written, so a delta
+     * checkpoint copies only the pages changed since the last one
+     */
+    class DirtyPages
+    {
+        public:
+        explicit DirtyPages(size_t numBytes = 0, std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : _pages(pagesFor(numBytes), resource) {}
+
+        /**
+         * @brief Tracks a region of a new size, with every page dirty
+         *
+         * @param numBytes
+         */
+        void resize(size_t numBytes)
+        {
+            _pages.resize(pagesFor(numBytes));
+            markAll();
+        }
+
+        /**
+         * @brief Marks the pages covering length bytes from offset
+         *
+         * @param offset
+         * @param length At least 1
+         */
+        void mark(size_t offset, size_t length = 1)
+        {
+            for (size_t page = offset / CHECKPOINT_PAGE_SIZE; page <= (offset + length - 1) / CHECKPOINT_PAGE_SIZE; ++page)
+            {
+                _pages.set(page);
+            }
+        }
+
+        void markAll()
+        {
+            for (size_t page = 0; page < _pages.size(); ++page)
+            {
+                _pages.set(page);
+            }
+        }
+
+        void clear() { _pages.reset(); }
+        size_t count() const { return _pages.count(); }
+        size_t size() const { return _pages.size(); }
+
+        template <typename Visit>
+        void forEachDirty(Visit&& visit) const
+        {
+            _pages.forEachSet(visit);
+        }
+
+        static size_t pagesFor(size_t numBytes)
+        {
+            return (numBytes + CHECKPOINT_PAGE_SIZE - 1) / CHECKPOINT_PAGE_SIZE;
+        }
+
+        private:
+        BitArray _pages;
+    };
+
+    enum class CheckpointKind : uint8_t
+    {
+        BASE = 1, // Every page, starting a new chain
+        DELTA = 2 // Pages dirtied since the previous record of the chain
+    };
+
+    /**
+     * @brief A region of a structure's memory saved page by page, with the pages to save
+     */
+    struct CheckpointRegion
+    {
+        const void* data;
+        size_t size; // Bytes
+        DirtyPages* dirty;
+    };
+
+    /**
+     * @brief A region a checkpoint record is restored into
+     */
+    struct CheckpointTarget
+    {
+        void* data;
+        size_t size; // Bytes
+    };
+
+    /**
+     * @brief Header of one record of a checkpoint stream as read back, with the staging
+     * buffer for the pages of a delta
+     */
+    struct CheckpointRecord
+    {
+        explicit CheckpointRecord(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : payload(resource) {}
+
+        uint64_t tag = 0; // Identifies the structure and layout that wrote the record
+        CheckpointKind kind = CheckpointKind::BASE;
+        uint64_t sequence = 0; // 1 for a base, then one more for each delta of its chain
+        std::array<uint64_t, CHECKPOINT_STATE_WORDS> state{}; // Scalar members of the structure
+        size_t numRegions = 0;
+        std::array<uint64_t, MAX_CHECKPOINT_REGIONS> regionSizes{};
+        std::array<uint64_t, MAX_CHECKPOINT_REGIONS> dirtyPages{}; // Pages in the record, per region
+        uint64_t checksum = 0; // Of the header, checked on its own, then continued over the pages
+        std::pmr::vector<uint8_t> payload;
+    };
+
+    namespace detail
+    {
+        inline constexpr uint64_t CHECKPOINT_MAGIC = 0x31544b43534450; // "PDSCKT1"
+
+        inline uint64_t checksum(uint64_t h, const uint8_t* data, size_t size)
+        {
+            for (size_t i = 0; i < size; i += 8)
+            {
+                uint64_t word = 0;
+                std::memcpy(&word, data + i, std::min<size_t>(8, size - i));
+                h = mix64(h ^ word);
+            }
+            return h;
+        }
+
+        inline uint64_t pageBytes(uint64_t regionSize, uint64_t page)
+        {
+            return std::min<uint64_t>(CHECKPOINT_PAGE_SIZE, regionSize - page * CHECKPOINT_PAGE_SIZE);
+        }
+    }
+
+    /**
+     * @brief Appends one record to a checkpoint stream: a header with the structure's scalar
+     * state and region sizes and a checksum of it, then each dirty page, or every page for a
+     * base, then the checksum continued over the pages. The dirty pages are cleared once the
+     * record is written.
+     *
+     * @param out
+     * @param tag
+     * @param kind
+     * @param sequence
+     * @param state
+     * @param regions At most MAX_CHECKPOINT_REGIONS
+     * @return true
+     * @return false if the stream failed; the pages stay dirty
+     */
+    inline bool writeCheckpoint(std::ostream& out, uint64_t tag, CheckpointKind kind, uint64_t sequence,
+                                const std::array<uint64_t, CHECKPOINT_STATE_WORDS>& state,
+                                std::initializer_list<CheckpointRegion> regions)
+    {
+        if (regions.size() > MAX_CHECKPOINT_REGIONS)
+            return false;
+
+        if (kind == CheckpointKind::BASE)
+        {
+            for (const CheckpointRegion& region : regions)
+            {
+                region.dirty->markAll();
+            }
+        }
+
+        std::vector<uint64_t> header = {detail::CHECKPOINT_MAGIC, tag, static_cast<uint64_t>(kind), sequence};
+        header.insert(header.end(), state.begin(), state.end());
+        header.push_back(regions.size());
+        for (const CheckpointRegion& region : regions)
+        {
+            header.push_back(region.size);
+            header.push_back(region.dirty->count());
+        }
+
+        const auto* headerBytes = reinterpret_cast<const uint8_t*>(header.data());
+        uint64_t sum = detail::checksum(0, headerBytes, header.size() * sizeof(uint64_t));
+        out.write(reinterpret_cast<const char*>(headerBytes), static_cast<std::streamsize>(header.size() * sizeof(uint64_t)));
+        out.write(reinterpret_cast<const char*>(&sum), sizeof(sum));
+
+        uint64_t index = 0;
+        for (const CheckpointRegion& region : regions)
+        {
+            const auto* bytes = static_cast<const uint8_t*>(region.data);
+            region.dirty->forEachDirty([&](size_t page) {
+                const uint64_t position[2] = {index, page};
+                const uint8_t* data = bytes + page * CHECKPOINT_PAGE_SIZE;
+                const size_t size = static_cast<size_t>(detail::pageBytes(region.size, page));
+                sum = detail::checksum(sum, reinterpret_cast<const uint8_t*>(position), sizeof(position));
+                sum = detail::checksum(sum, data, size);
+                out.write(reinterpret_cast<const char*>(position), sizeof(position));
+                out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+            });
+            ++index;
+        }
+        out.write(reinterpret_cast<const char*>(&sum), sizeof(sum));
+        out.flush();
+        if (!out.good())
+            return false;
+
+        for (const CheckpointRegion& region : regions)
+        {
+            region.dirty->clear();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Reads the header of the next record of a checkpoint stream and verifies its
+     * checksum, so the structure can be sized from its state before readCheckpointPages fills
+     * it. Only the region count is trusted before the checksum, and it is bounded.
+     *
+     * @param in
+     * @param record
+     * @return true
+     * @return false at the end of the stream, or on a torn, corrupt or malformed header
+     */
+    inline bool readCheckpointHeader(std::istream& in, CheckpointRecord& record)
+    {
+        std::vector<uint64_t> header(4 + CHECKPOINT_STATE_WORDS + 1);
+        auto read = [&in](uint64_t* words, size_t count) {
+            return static_cast<bool>(in.read(reinterpret_cast<char*>(words), static_cast<std::streamsize>(count * sizeof(uint64_t))));
+        };
+        if (!read(header.data(), header.size()) || header[0] != detail::CHECKPOINT_MAGIC ||
+            (header[2] != static_cast<uint64_t>(CheckpointKind::BASE) && header[2] != static_cast<uint64_t>(CheckpointKind::DELTA)) ||
+            header.back() > MAX_CHECKPOINT_REGIONS)
+            return false;
+
+        const size_t numRegions = static_cast<size_t>(header.back());
+        header.resize(header.size() + 2 * numRegions);
+        uint64_t expected = 0;
+        if (!read(header.data() + header.size() - 2 * numRegions, 2 * numRegions) || !read(&expected, 1))
+            return false;
+
+        const uint64_t sum = detail::checksum(0, reinterpret_cast<const uint8_t*>(header.data()), header.size() * sizeof(uint64_t));
+        if (sum != expected)
+            return false;
+
+        record.tag = header[1];
+        record.kind = static_cast<CheckpointKind>(header[2]);
+        record.sequence = header[3];
+        std::copy(header.begin() + 4, header.begin() + 4 + CHECKPOINT_STATE_WORDS, record.state.begin());
+        record.numRegions = numRegions;
+        for (size_t r = 0; r < numRegions; ++r)
+        {
+            record.regionSizes[r] = header[5 + CHECKPOINT_STATE_WORDS + 2 * r];
+            record.dirtyPages[r] = header[6 + CHECKPOINT_STATE_WORDS + 2 * r];
+            if (record.dirtyPages[r] > DirtyPages::pagesFor(static_cast<size_t>(record.regionSizes[r])))
+                return false;
+        }
+        record.checksum = sum;
+        return true;
+    }
+
+    /**
+     * @brief Reads the pages of the record whose header was just read into the structure's
+     * regions, and verifies the checksum. A base's pages go straight into the regions, which
+     * the caller stages apart from the chain it already restored. A delta's pages are held
+     * back until the checksum passes, so a torn delta, as a crash mid-write leaves the last
+     * one, changes nothing.
+     *
+     * @param in
+     * @param record
+     * @param targets One per region of the record, sized as when it was written
+     * @return true
+     * @return false if the targets do not match the record's regions, or the record is torn or corrupt
+     */
+    inline bool readCheckpointPages(std::istream& in, CheckpointRecord& record, std::initializer_list<CheckpointTarget> targets)
+    {
+        if (targets.size() != record.numRegions)
+            return false;
+
+        for (size_t r = 0; r < record.numRegions; ++r)
+        {
+            if (targets.begin()[r].size != record.regionSizes[r])
+                return false;
+        }
+
+        // Pages of a delta are staged as (region, page, bytes) one after another
+        const bool staged = record.kind == CheckpointKind::DELTA;
+        uint64_t sum = record.checksum;
+        record.payload.clear();
+        for (size_t r = 0; r < record.numRegions; ++r)
+        {
+            const CheckpointTarget& target = targets.begin()[r];
+            for (uint64_t i = 0; i < record.dirtyPages[r]; ++i)
+            {
+                uint64_t position[2];
+                if (!in.read(reinterpret_cast<char*>(position), sizeof(position)) || position[0] != r ||
+                    position[1] >= DirtyPages::pagesFor(target.size))
+                    return false;
+
+                const size_t size = static_cast<size_t>(detail::pageBytes(target.size, position[1]));
+                uint8_t* page = static_cast<uint8_t*>(target.data) + position[1] * CHECKPOINT_PAGE_SIZE;
+                if (staged)
+                {
+                    const size_t at = record.payload.size();
+                    record.payload.resize(at + sizeof(position) + size);
+                    std::memcpy(record.payload.data() + at, position, sizeof(position));
+                    page = record.payload.data() + at + sizeof(position);
+                }
+                if (!in.read(reinterpret_cast<char*>(page), static_cast<std::streamsize>(size)))
+                    return false;
+
+                sum = detail::checksum(sum, reinterpret_cast<const uint8_t*>(position), sizeof(position));
+                sum = detail::checksum(sum, page, size);
+            }
+        }
+
+        uint64_t expected = 0;
+        if (!in.read(reinterpret_cast<char*>(&expected), sizeof(expected)) || expected != sum)
+            return false;
+
+        for (size_t at = 0; at < record.payload.size();)
+        {
+            uint64_t position[2];
+            std::memcpy(position, record.payload.data() + at, sizeof(position));
+            const CheckpointTarget& target = targets.begin()[position[0]];
+            const size_t size = static_cast<size_t>(detail::pageBytes(target.size, position[1]));
+            std::memcpy(static_cast<uint8_t*>(target.data) + position[1] * CHECKPOINT_PAGE_SIZE,
+                        record.payload.data() + at + sizeof(position), size);
+            at += sizeof(position) + size;
+        }
+        return true;
+    }
+}
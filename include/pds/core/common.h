@@ -1,11 +1,29 @@
 #pragma once
 
+#include <cstdint>
 #include <iostream>
+#include <sstream>
+#include <string>
 
 #define BIT_ARRAY_SIZE 1024
 
+// Every structure logs its operations through its visualiser. Define PDS_VISUALISE as 0
+// to compile the logging, and the bookkeeping only the visualisers need, out of the hot paths.
+#ifndef PDS_VISUALISE
+#define PDS_VISUALISE 1
+#endif
+
+// Define PDS_METRICS as 1 to count operations in every structure, see pds/core/metrics.h.
+// When 0, the default, the counters and the calls recording them compile to nothing.
+#ifndef PDS_METRICS
+#define PDS_METRICS 0
+#endif
+
 namespace pds
 {
+    inline constexpr bool VISUALISE = PDS_VISUALISE != 0;
+    inline constexpr bool METRICS = PDS_METRICS != 0;
+
     enum class VisualContext : uint8_t
     {
         INIT,
@@ -15,7 +33,7 @@ namespace pds
         UNKNOWN
     };
 
-    inline std::string toString(VisualContext ctx) const
+    inline std::string toString(VisualContext ctx)
     {
         switch (ctx)
         {
@@ -26,4 +44,19 @@ namespace pds
             default: return "UNKNOWN";
         }
     }
+
+    /**
+     * @brief Renders any streamable item as text for the visualisers' log lines
+     *
+     * @tparam T
+     * @param item
+     * @return std::string
+     */
+    template <typename T>
+    inline std::string toDisplayString(const T& item)
+    {
+        std::ostringstream out;
+        out << item;
+        return out.str();
+    }
 }
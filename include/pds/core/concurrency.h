@@ -0,0 +1,165 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace pds::core
+{
+    /**
+     * @brief Size of the cache line that shared, independently written state is padded to
+     */
+    inline constexpr size_t CACHE_LINE_SIZE = 64;
+
+    /**
+     * @brief Hint to the CPU that the calling thread is spinning
+     */
+    inline void cpuRelax()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_ia32_pause();
+#elif defined(__aarch64__)
+        asm volatile("yield");
+#else
+        std::this_thread::yield();
+#endif
+    }
+
+    /**
+     * @brief Test-and-test-and-set spinlock for short critical sections, usable with std::lock_guard
+     */
+    class SpinLock
+    {
+        public:
+        void lock()
+        {
+            while (_locked.exchange(true, std::memory_order_acquire))
+            {
+                while (_locked.load(std::memory_order_relaxed))
+                {
+                    cpuRelax();
+                }
+            }
+        }
+
+        bool try_lock()
+        {
+            return !_locked.load(std::memory_order_relaxed) &&
+                   !_locked.exchange(true, std::memory_order_acquire);
+        }
+
+        void unlock()
+        {
+            _locked.store(false, std::memory_order_release);
+        }
+
+        private:
+        std::atomic<bool> _locked{false};
+    };
+
+    /**
+     * @brief Array of trivially copyable values, each held as 64-bit words loaded and stored
+     * with relaxed atomics, so a seqlock reader can copy a value while a writer replaces it
+     * without a data race. The copy may be torn; the reader's sequence check discards it.
+     *
+     * @tparam T
+     */
+    template <typename T>
+    class AtomicWordArray
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Values are copied word by word");
+
+        public:
+        static constexpr size_t WORDS = (sizeof(T) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+        explicit AtomicWordArray(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+            : _words(resource) {}
+
+        /**
+         * @brief Replaces the contents with n copies of value. Not thread-safe.
+         *
+         * @param n
+         * @param value
+         */
+        void assign(size_t n, const T& value)
+        {
+            // Atomics cannot be moved into place, so the words are allocated afresh
+            std::pmr::vector<std::atomic<uint64_t>> fresh(n * WORDS, _words.get_allocator().resource());
+            _words.swap(fresh);
+            for (size_t i = 0; i < n; ++i)
+            {
+                store(i, value);
+            }
+        }
+
+        T load(size_t index) const
+        {
+            uint64_t words[WORDS];
+            for (size_t w = 0; w < WORDS; ++w)
+            {
+                words[w] = _words[index * WORDS + w].load(std::memory_order_relaxed);
+            }
+            T value;
+            std::memcpy(&value, words, sizeof(T));
+            return value;
+        }
+
+        void store(size_t index, const T& value)
+        {
+            uint64_t words[WORDS] = {};
+            std::memcpy(words, &value, sizeof(T));
+            for (size_t w = 0; w < WORDS; ++w)
+            {
+                _words[index * WORDS + w].store(words[w], std::memory_order_relaxed);
+            }
+        }
+
+        private:
+        std::pmr::vector<std::atomic<uint64_t>> _words;
+    };
+
+    /**
+     * @brief Resolves a requested worker count, where 0 means one per hardware thread
+     *
+     * @param requested
+     * @return size_t
+     */
+    inline size_t resolveThreadCount(size_t requested)
+    {
+        if (requested != 0)
+            return requested;
+
+        const size_t hardware = std::thread::hardware_concurrency();
+        return hardware == 0 ? 1 : hardware;
+    }
+
+    /**
+     * @brief Runs fn(threadIndex) on numThreads threads, the calling thread taking index 0,
+     * and returns once all of them have finished
+     *
+     * @tparam Fn
+     * @param numThreads
+     * @param fn
+     */
+    template <typename Fn>
+    void parallelFor(size_t numThreads, Fn&& fn)
+    {
+        std::vector<std::thread> workers;
+        workers.reserve(numThreads > 0 ? numThreads - 1 : 0);
+        for (size_t t = 1; t < numThreads; ++t)
+        {
+            workers.emplace_back([&fn, t] { fn(t); });
+        }
+
+        fn(size_t{0});
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+    }
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace pds::core
+{
+    /**
+     * @brief Golden ratio constant used to derive independent hash functions from a seed
+     */
+    constexpr size_t HASH_SEED_MULTIPLIER = 0x9e3779b9;
+
+    /**
+     * @brief Finaliser from SplitMix64, spreads entropy of the input over all output bits
+     *
+     * @param x
+     * @return uint64_t
+     */
+    inline uint64_t mix64(uint64_t x)
+    {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return x;
+    }
+
+    /**
+     * @brief Types that hash and compare like a std::string without being one: string views
+     * and character arrays (string literals). Pointers are excluded, std::hash hashes the address.
+     *
+     * @tparam K
+     */
+    template <typename K>
+    inline constexpr bool isStringLike = std::is_same_v<K, std::string> || std::is_same_v<K, std::string_view> ||
+        (std::is_array_v<K> && std::is_same_v<std::remove_cv_t<std::remove_extent_t<K>>, char>);
+
+    /**
+     * @brief Checks if K can be looked up in a structure keyed by T without constructing a T
+     *
+     * @tparam T
+     * @tparam K
+     */
+    template <typename T, typename K>
+    inline constexpr bool isTransparentKey = std::is_same_v<T, std::string> && isStringLike<K> && !std::is_same_v<K, T>;
+
+    /**
+     * @brief std::hash of a key, with string-like keys hashed as a std::string_view.
+     * The standard guarantees this equals std::hash<std::string> of the same characters.
+     *
+     * @tparam K
+     * @param key
+     * @return size_t
+     */
+    template <typename K>
+    inline size_t transparentHash(const K& key)
+    {
+        if constexpr (isStringLike<K>)
+        {
+            return std::hash<std::string_view>{}(std::string_view(key));
+        }
+        else
+        {
+            return std::hash<K>{}(key);
+        }
+    }
+
+    /**
+     * @brief Hash of a key given to a structure keyed by T, equal to the hash of the T it
+     * converts to. Keys that hash like T are hashed directly; a character pointer given for
+     * a std::string key is hashed as the characters it points to, not as an address; any
+     * other key is converted to T first.
+     *
+     * @tparam T
+     * @tparam K
+     * @param key
+     * @return size_t
+     */
+    template <typename T, typename K>
+    inline size_t keyHash(const K& key)
+    {
+        if constexpr (std::is_same_v<K, T> || isTransparentKey<T, K>)
+        {
+            return transparentHash(key);
+        }
+        else if constexpr (std::is_same_v<T, std::string> && std::is_convertible_v<K, const char*>)
+        {
+            return transparentHash(std::string_view(key));
+        }
+        else
+        {
+            return transparentHash(T(key));
+        }
+    }
+
+    /**
+     * @brief The i-th hash function of the library, h_i(x) = std::hash(x) ^ (i * 0x9e3779b9)
+     *
+     * @tparam T
+     * @param item
+     * @param seed Index of the hash function
+     * @return size_t
+     */
+    template <typename T>
+    inline size_t seededHash(const T& item, size_t seed)
+    {
+        return transparentHash(item) ^ (seed * HASH_SEED_MULTIPLIER);
+    }
+
+    /**
+     * @brief Seeded hash with a mixing step, for structures that use the high bits of the hash
+     * or need good distribution for integer keys (std::hash is the identity for those)
+     *
+     * @tparam T
+     * @param item
+     * @param seed Index of the hash function
+     * @return uint64_t
+     */
+    template <typename T>
+    inline uint64_t mixedHash(const T& item, size_t seed = 0)
+    {
+        return mix64(static_cast<uint64_t>(seededHash(item, seed)));
+    }
+}
@@ -0,0 +1,323 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory_resource>
+#include <mutex>
+#include <string>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace pds::core
+{
+    enum class PageMode : uint8_t
+    {
+        DEFAULT, // Regular pages from the upstream resource
+        TRANSPARENT, // Anonymous mapping aligned to the huge page size and madvise(MADV_HUGEPAGE)
+        EXPLICIT // MAP_HUGETLB from the reserved huge page pool, falling back to TRANSPARENT
+    };
+
+    enum class NumaPolicy : uint8_t
+    {
+        NONE, // First-touch placement by the kernel
+        INTERLEAVE, // Spread pages round-robin across the nodes in nodeMask
+        BIND // Place all pages on the nodes in nodeMask
+    };
+
+    struct HugePageOptions
+    {
+        PageMode pageMode = PageMode::TRANSPARENT;
+        NumaPolicy numaPolicy = NumaPolicy::NONE;
+        uint64_t nodeMask = 0; // Bit i selects NUMA node i
+        size_t minMappedBytes = 64 * 1024; // Smaller allocations go to the upstream resource
+    };
+
+    /**
+     * @brief Memory resource backing large bit and counter arrays with huge pages, optionally
+     * interleaved or bound across NUMA nodes. Pass it to any structure's constructor; small
+     * bookkeeping allocations are forwarded upstream so only the bulk storage is mapped.
+     */
+    class HugePageResource : public std::pmr::memory_resource
+    {
+        public:
+        explicit HugePageResource(HugePageOptions options = {},
+                                  std::pmr::memory_resource* upstream = std::pmr::get_default_resource())
+            : _options(options), _upstream(upstream) {}
+
+        HugePageResource(const HugePageResource&) = delete;
+        HugePageResource& operator=(const HugePageResource&) = delete;
+
+        ~HugePageResource() override
+        {
+#if defined(__linux__)
+            for (const auto& [address, mapping] : _mappings)
+            {
+                ::munmap(const_cast<void*>(address), mapping.length);
+            }
+#endif
+        }
+
+        /**
+         * @brief Page size actually backing an allocation, or 0 if it was not mapped by this resource.
+         * Transparent huge pages are only reported once the kernel has faulted them in.
+         *
+         * @param p
+         * @return size_t
+         */
+        size_t pageSizeOf(const void* p) const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it = _mappings.find(p);
+            if (it == _mappings.end())
+                return 0;
+
+            return effectivePageSize(it->first, it->second);
+        }
+
+        /**
+         * @brief Smallest page size across all live mapped allocations, or the base page size
+         * if nothing is mapped. With one resource per structure this is the page size its
+         * storage got.
+         *
+         * @return size_t
+         */
+        size_t pageSize() const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            size_t smallest = 0;
+            for (const auto& [address, mapping] : _mappings)
+            {
+                const size_t size = effectivePageSize(address, mapping);
+                smallest = smallest == 0 ? size : std::min(smallest, size);
+            }
+            return smallest == 0 ? basePageSize() : smallest;
+        }
+
+        /**
+         * @brief Checks if the NUMA policy was applied to an allocation
+         *
+         * @param p
+         * @return true
+         * @return false
+         */
+        bool isNumaPolicyApplied(const void* p) const
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            auto it = _mappings.find(p);
+            return it != _mappings.end() && it->second.numaApplied;
+        }
+
+        const HugePageOptions& options() const { return _options; }
+
+        static size_t basePageSize()
+        {
+#if defined(__linux__)
+            return static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+#else
+            return 4096;
+#endif
+        }
+
+        /**
+         * @brief Default huge page size of the system, as reported by /proc/meminfo
+         *
+         * @return size_t
+         */
+        static size_t hugePageSize()
+        {
+            std::ifstream meminfo("/proc/meminfo");
+            std::string key;
+            size_t value = 0;
+            std::string unit;
+            while (meminfo >> key >> value)
+            {
+                std::getline(meminfo, unit);
+                if (key == "Hugepagesize:")
+                    return value * 1024;
+            }
+            return 2 * 1024 * 1024;
+        }
+
+        private:
+        struct Mapping
+        {
+            size_t length;
+            size_t pageSize; // Page size if known at mapping time, 0 for transparent huge pages
+            bool numaApplied;
+        };
+
+        void* do_allocate(size_t bytes, size_t alignment) override
+        {
+#if defined(__linux__)
+            if (_options.pageMode != PageMode::DEFAULT && bytes >= _options.minMappedBytes)
+            {
+                const size_t hugeSize = hugePageSize();
+                if (alignment <= hugeSize)
+                {
+                    const size_t length = (bytes + hugeSize - 1) / hugeSize * hugeSize;
+                    void* address = nullptr;
+                    Mapping mapping{length, 0, false};
+
+                    if (_options.pageMode == PageMode::EXPLICIT)
+                    {
+                        address = ::mmap(nullptr, length, PROT_READ | PROT_WRITE,
+                                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                        if (address == MAP_FAILED)
+                            address = nullptr;
+                        else
+                            mapping.pageSize = hugeSize;
+                    }
+
+                    if (address == nullptr)
+                    {
+                        address = mapTransparent(length, hugeSize);
+                    }
+
+                    if (address != nullptr)
+                    {
+                        mapping.numaApplied = applyNumaPolicy(address, length);
+                        std::lock_guard<std::mutex> lock(_mutex);
+                        _mappings.emplace(address, mapping);
+                        return address;
+                    }
+                }
+            }
+#endif
+            return _upstream->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* p, size_t bytes, size_t alignment) override
+        {
+#if defined(__linux__)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto it = _mappings.find(p);
+                if (it != _mappings.end())
+                {
+                    ::munmap(p, it->second.length);
+                    _mappings.erase(it);
+                    return;
+                }
+            }
+#endif
+            _upstream->deallocate(p, bytes, alignment);
+        }
+
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+        {
+            return this == &other;
+        }
+
+#if defined(__linux__)
+        /**
+         * @brief Maps length bytes aligned to the huge page size, so that the kernel can back
+         * the whole range with huge pages, and asks for them with madvise
+         *
+         * @param length
+         * @param hugeSize
+         * @return void*
+         */
+        static void* mapTransparent(size_t length, size_t hugeSize)
+        {
+            const size_t padded = length + hugeSize;
+            void* raw = ::mmap(nullptr, padded, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (raw == MAP_FAILED)
+                return nullptr;
+
+            const uintptr_t start = reinterpret_cast<uintptr_t>(raw);
+            const uintptr_t aligned = (start + hugeSize - 1) / hugeSize * hugeSize;
+            if (aligned > start)
+            {
+                ::munmap(raw, aligned - start);
+            }
+            const uintptr_t end = start + padded;
+            if (end > aligned + length)
+            {
+                ::munmap(reinterpret_cast<void*>(aligned + length), end - (aligned + length));
+            }
+
+            void* address = reinterpret_cast<void*>(aligned);
+#ifdef MADV_HUGEPAGE
+            ::madvise(address, length, MADV_HUGEPAGE);
+#endif
+            return address;
+        }
+
+        /**
+         * @brief Applies the NUMA policy with the mbind system call, before any page is touched
+         *
+         * @param address
+         * @param length
+         * @return true
+         * @return false
+         */
+        bool applyNumaPolicy(void* address, size_t length) const
+        {
+#if defined(SYS_mbind)
+            if (_options.numaPolicy == NumaPolicy::NONE || _options.nodeMask == 0)
+                return false;
+
+            constexpr int MPOL_BIND_MODE = 2;
+            constexpr int MPOL_INTERLEAVE_MODE = 3;
+            const int mode = _options.numaPolicy == NumaPolicy::BIND ? MPOL_BIND_MODE : MPOL_INTERLEAVE_MODE;
+            unsigned long nodeMask = static_cast<unsigned long>(_options.nodeMask);
+            return ::syscall(SYS_mbind, address, length, mode, &nodeMask, sizeof(nodeMask) * 8 + 1, 0) == 0;
+#else
+            (void)address;
+            (void)length;
+            return false;
+#endif
+        }
+#endif
+
+        /**
+         * @brief Page size of a mapping. For transparent huge pages this reads the mapping's
+         * AnonHugePages from /proc/self/smaps, since the kernel decides at fault time.
+         *
+         * @param address
+         * @param mapping
+         * @return size_t
+         */
+        static size_t effectivePageSize(const void* address, const Mapping& mapping)
+        {
+            if (mapping.pageSize != 0)
+                return mapping.pageSize;
+
+            std::ifstream smaps("/proc/self/smaps");
+            std::string line;
+            const uintptr_t target = reinterpret_cast<uintptr_t>(address);
+            bool inMapping = false;
+            while (std::getline(smaps, line))
+            {
+                unsigned long start = 0;
+                unsigned long end = 0;
+                if (std::sscanf(line.c_str(), "%lx-%lx ", &start, &end) == 2 && line.find(':') > line.find(' '))
+                {
+                    inMapping = target >= start && target < end;
+                    continue;
+                }
+
+                if (inMapping && line.rfind("AnonHugePages:", 0) == 0)
+                {
+                    size_t hugeKb = 0;
+                    std::sscanf(line.c_str() + std::strlen("AnonHugePages:"), "%zu", &hugeKb);
+                    return hugeKb > 0 ? hugePageSize() : basePageSize();
+                }
+            }
+            return basePageSize();
+        }
+
+        HugePageOptions _options;
+        std::pmr::memory_resource* _upstream;
+        std::map<const void*, Mapping> _mappings;
+        mutable std::mutex _mutex;
+    };
+}
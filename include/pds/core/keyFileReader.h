@@ -0,0 +1,157 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace pds::core
+{
+    /**
+     * @brief Layout of the records in a key dump
+     */
+    enum class KeyFileFormat : uint8_t
+    {
+        NEWLINE,        // One key per line; a trailing '\r' is stripped and empty lines are skipped
+        LENGTH_PREFIXED // Each key preceded by its length as a 32-bit little-endian integer
+    };
+
+    /**
+     * @brief Streams the keys of a dump too large to hold in memory, a block at a time.
+     * Each call to next returns views into one of two alternating buffers, so the keys of
+     * one batch stay valid while the following batch is read, e.g. on another thread.
+     */
+    class KeyFileReader
+    {
+        public:
+        static constexpr size_t DEFAULT_BLOCK_SIZE = size_t{16} << 20;
+
+        KeyFileReader(const std::string& path, KeyFileFormat format, size_t blockSize = DEFAULT_BLOCK_SIZE)
+            : _file(path, std::ios::binary), _format(format), _blockSize(blockSize == 0 ? 1 : blockSize), _current(0),
+              _eof(false), _truncated(false) {}
+
+        bool isOpen() const { return _file.is_open(); }
+
+        /**
+         * @brief True if the file ended inside a length-prefixed record
+         */
+        bool isTruncated() const { return _truncated; }
+
+        /**
+         * @brief Reads blocks until at least one record completes, and replaces keys with views
+         * of the complete records read. Every block of one call goes into the same buffer, so
+         * the views of the previous call stay valid however many blocks this one needs, e.g.
+         * for a run of empty lines or a record longer than a block.
+         *
+         * @param keys
+         * @return true if any keys were read
+         * @return false at the end of the file
+         */
+        bool next(std::vector<std::string_view>& keys)
+        {
+            keys.clear();
+            if (_eof && _carry.empty())
+                return false;
+
+            std::string& buffer = _buffers[_current];
+            _current ^= 1;
+
+            // Records cut by the previous block boundary start this buffer
+            buffer.assign(_carry);
+            _carry.clear();
+            size_t consumed = 0;
+            while (true)
+            {
+                if (!_eof && _file.is_open())
+                {
+                    const size_t filled = buffer.size();
+                    buffer.resize(filled + _blockSize);
+                    _file.read(buffer.data() + filled, static_cast<std::streamsize>(_blockSize));
+                    buffer.resize(filled + static_cast<size_t>(_file.gcount()));
+                    _eof = _file.gcount() < static_cast<std::streamsize>(_blockSize);
+                }
+                else
+                {
+                    _eof = true;
+                }
+
+                consumed = _format == KeyFileFormat::NEWLINE ? splitLines(buffer, consumed, keys) : splitPrefixed(buffer, consumed, keys);
+                if (!keys.empty() || _eof)
+                    break;
+
+                // Nothing points into the buffer yet, so drop what was skipped, e.g. empty lines
+                buffer.erase(0, consumed);
+                consumed = 0;
+            }
+
+            if (!_eof)
+            {
+                _carry.assign(buffer, consumed, std::string::npos);
+            }
+            else if (consumed < buffer.size())
+            {
+                if (_format == KeyFileFormat::NEWLINE)
+                {
+                    addKey(std::string_view(buffer).substr(consumed), keys);
+                }
+                else
+                {
+                    _truncated = true;
+                }
+            }
+            return !keys.empty();
+        }
+
+        private:
+        static void addKey(std::string_view key, std::vector<std::string_view>& keys)
+        {
+            if (!key.empty() && key.back() == '\r')
+            {
+                key.remove_suffix(1);
+            }
+            if (!key.empty())
+            {
+                keys.push_back(key);
+            }
+        }
+
+        static size_t splitLines(const std::string& buffer, size_t start, std::vector<std::string_view>& keys)
+        {
+            const std::string_view view(buffer);
+            for (size_t end = view.find('\n', start); end != std::string_view::npos; end = view.find('\n', start))
+            {
+                addKey(view.substr(start, end - start), keys);
+                start = end + 1;
+            }
+            return start;
+        }
+
+        static size_t splitPrefixed(const std::string& buffer, size_t start, std::vector<std::string_view>& keys)
+        {
+            const std::string_view view(buffer);
+            while (start + 4 <= view.size())
+            {
+                const auto* prefix = reinterpret_cast<const unsigned char*>(view.data() + start);
+                const size_t length = static_cast<size_t>(prefix[0]) | static_cast<size_t>(prefix[1]) << 8 |
+                                      static_cast<size_t>(prefix[2]) << 16 | static_cast<size_t>(prefix[3]) << 24;
+                if (start + 4 + length > view.size())
+                    break;
+
+                keys.push_back(view.substr(start + 4, length));
+                start += 4 + length;
+            }
+            return start;
+        }
+
+        std::ifstream _file;
+        KeyFileFormat _format;
+        size_t _blockSize;
+        std::string _buffers[2];
+        size_t _current; // Buffer the next block is read into
+        std::string _carry; // Incomplete record at the end of the last block
+        bool _eof;
+        bool _truncated;
+    };
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <string_view>
+
+#include "pds/core/common.h"
+
+namespace pds::core
+{
+    /**
+     * @brief Number of buckets in the probe length histogram; the last one counts every longer probe
+     */
+    inline constexpr size_t PROBE_HISTOGRAM_SIZE = 16;
+
+    /**
+     * @brief Snapshot of a structure's operation counters. Fields that do not apply to a
+     * structure stay zero, as do all counters when PDS_METRICS is 0.
+     */
+    struct Stats
+    {
+        uint64_t inserts = 0;
+        uint64_t queries = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t erases = 0;
+        uint64_t saturations = 0; // Counter increments dropped because the counter was at its maximum
+        std::array<uint64_t, PROBE_HISTOGRAM_SIZE> probeLengths{}; // Operations by slots probed past the home slot
+        float fillRatio = 0.0f; // Set bits or occupied slots over the total, always computed
+    };
+
+    /**
+     * @brief Receives snapshots from the structures it is attached to, every publishInterval
+     * operations, on the thread performing the operation
+     */
+    class MetricsSink
+    {
+        public:
+        virtual ~MetricsSink() = default;
+        virtual void publish(std::string_view structure, const Stats& stats) = 0;
+    };
+
+    /**
+     * @brief Sink writing one line of space separated key=value pairs per snapshot
+     */
+    class StreamMetricsSink : public MetricsSink
+    {
+        public:
+        explicit StreamMetricsSink(std::ostream& out) : _out(out) {}
+
+        void publish(std::string_view structure, const Stats& stats) override
+        {
+            _out << structure << " inserts=" << stats.inserts << " queries=" << stats.queries
+                 << " hits=" << stats.hits << " misses=" << stats.misses << " erases=" << stats.erases
+                 << " saturations=" << stats.saturations << " fill=" << stats.fillRatio << " probes=";
+            for (size_t i = 0; i < PROBE_HISTOGRAM_SIZE; ++i)
+            {
+                _out << (i == 0 ? "" : ",") << stats.probeLengths[i];
+            }
+            _out << "\n";
+        }
+
+        private:
+        std::ostream& _out;
+    };
+
+    /**
+     * @brief Operation counters embedded in each structure. Recording is a plain increment,
+     * so a structure's stats are read on the thread that uses it or through a sink.
+     *
+     * @tparam Enabled
+     */
+    template <bool Enabled>
+    class BasicMetrics
+    {
+        public:
+        void recordInsert(uint64_t count = 1) { _stats.inserts += count; tick(); }
+        void recordErase() { _stats.erases += 1; tick(); }
+        void recordSaturation() { _stats.saturations += 1; }
+
+        void recordQuery(bool hit)
+        {
+            _stats.queries += 1;
+            (hit ? _stats.hits : _stats.misses) += 1;
+            tick();
+        }
+
+        void recordQuery()
+        {
+            _stats.queries += 1;
+            tick();
+        }
+
+        void recordProbeLength(size_t probes)
+        {
+            _stats.probeLengths[probes < PROBE_HISTOGRAM_SIZE ? probes : PROBE_HISTOGRAM_SIZE - 1] += 1;
+        }
+
+        void setSink(MetricsSink* sink, uint64_t publishInterval)
+        {
+            _sink = sink;
+            _publishInterval = publishInterval;
+        }
+
+        /**
+         * @brief True once every publishInterval operations while a sink is attached
+         */
+        bool publishDue() const
+        {
+            return _sink != nullptr && _publishInterval != 0 && _operations % _publishInterval == 0;
+        }
+
+        void publish(std::string_view structure, const Stats& stats) const
+        {
+            _sink->publish(structure, stats);
+        }
+
+        Stats snapshot(float fillRatio) const
+        {
+            Stats stats = _stats;
+            stats.fillRatio = fillRatio;
+            return stats;
+        }
+
+        void reset()
+        {
+            _stats = Stats{};
+            _operations = 0;
+        }
+
+        private:
+        void tick() { ++_operations; }
+
+        Stats _stats;
+        uint64_t _operations = 0;
+        MetricsSink* _sink = nullptr;
+        uint64_t _publishInterval = 0;
+    };
+
+    /**
+     * @brief Disabled metrics: an empty member whose calls compile to nothing
+     */
+    template <>
+    class BasicMetrics<false>
+    {
+        public:
+        void recordInsert(uint64_t = 1) {}
+        void recordErase() {}
+        void recordSaturation() {}
+        void recordQuery(bool) {}
+        void recordQuery() {}
+        void recordProbeLength(size_t) {}
+        void setSink(MetricsSink*, uint64_t) {}
+        bool publishDue() const { return false; }
+        void publish(std::string_view, const Stats&) const {}
+        void reset() {}
+
+        Stats snapshot(float fillRatio) const
+        {
+            Stats stats;
+            stats.fillRatio = fillRatio;
+            return stats;
+        }
+    };
+
+    using Metrics = BasicMetrics<METRICS>;
+}
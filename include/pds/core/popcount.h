@@ -0,0 +1,168 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define PDS_POPCOUNT_X86 1
+#include <immintrin.h>
+#else
+#define PDS_POPCOUNT_X86 0
+#endif
+
+namespace pds::core
+{
+    namespace detail
+    {
+        inline size_t popcountScalar(const uint64_t* words, size_t numWords)
+        {
+            size_t a = 0, b = 0, c = 0, d = 0;
+            size_t i = 0;
+            for (; i + 4 <= numWords; i += 4)
+            {
+                a += static_cast<size_t>(__builtin_popcountll(words[i]));
+                b += static_cast<size_t>(__builtin_popcountll(words[i + 1]));
+                c += static_cast<size_t>(__builtin_popcountll(words[i + 2]));
+                d += static_cast<size_t>(__builtin_popcountll(words[i + 3]));
+            }
+            for (; i < numWords; ++i)
+            {
+                a += static_cast<size_t>(__builtin_popcountll(words[i]));
+            }
+            return a + b + c + d;
+        }
+
+#if PDS_POPCOUNT_X86
+        /**
+         * @brief Per 64-bit lane popcount of a 256-bit vector, by nibble lookup and sum of absolute differences
+         */
+        __attribute__((target("avx2"))) inline __m256i popcount256(__m256i v)
+        {
+            const __m256i lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                    0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+            const __m256i lowMask = _mm256_set1_epi8(0x0f);
+            const __m256i low = _mm256_and_si256(v, lowMask);
+            const __m256i high = _mm256_and_si256(_mm256_srli_epi16(v, 4), lowMask);
+            const __m256i counts = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low), _mm256_shuffle_epi8(lookup, high));
+            return _mm256_sad_epu8(counts, _mm256_setzero_si256());
+        }
+
+        /**
+         * @brief Carry-save adder: adds three bit vectors into a sum and a carry
+         */
+        __attribute__((target("avx2"))) inline void carrySaveAdd(__m256i& high, __m256i& low, __m256i a, __m256i b, __m256i c)
+        {
+            const __m256i u = _mm256_xor_si256(a, b);
+            high = _mm256_or_si256(_mm256_and_si256(a, b), _mm256_and_si256(u, c));
+            low = _mm256_xor_si256(u, c);
+        }
+
+        /**
+         * @brief Harley-Seal popcount: a tree of carry-save adders reduces 16 vectors to
+         * one whose bits each stand for 16, so only one in 16 vectors needs a full popcount
+         */
+        __attribute__((target("avx2"))) inline size_t popcountAvx2(const uint64_t* words, size_t numWords)
+        {
+            const auto* data = reinterpret_cast<const __m256i*>(words);
+            const size_t numVectors = numWords / 4;
+
+            __m256i total = _mm256_setzero_si256();
+            __m256i ones = _mm256_setzero_si256(), twos = _mm256_setzero_si256();
+            __m256i fours = _mm256_setzero_si256(), eights = _mm256_setzero_si256();
+            __m256i sixteens, twosA, twosB, foursA, foursB, eightsA, eightsB;
+
+            size_t i = 0;
+            for (; i + 16 <= numVectors; i += 16)
+            {
+                carrySaveAdd(twosA, ones, ones, _mm256_loadu_si256(data + i), _mm256_loadu_si256(data + i + 1));
+                carrySaveAdd(twosB, ones, ones, _mm256_loadu_si256(data + i + 2), _mm256_loadu_si256(data + i + 3));
+                carrySaveAdd(foursA, twos, twos, twosA, twosB);
+                carrySaveAdd(twosA, ones, ones, _mm256_loadu_si256(data + i + 4), _mm256_loadu_si256(data + i + 5));
+                carrySaveAdd(twosB, ones, ones, _mm256_loadu_si256(data + i + 6), _mm256_loadu_si256(data + i + 7));
+                carrySaveAdd(foursB, twos, twos, twosA, twosB);
+                carrySaveAdd(eightsA, fours, fours, foursA, foursB);
+                carrySaveAdd(twosA, ones, ones, _mm256_loadu_si256(data + i + 8), _mm256_loadu_si256(data + i + 9));
+                carrySaveAdd(twosB, ones, ones, _mm256_loadu_si256(data + i + 10), _mm256_loadu_si256(data + i + 11));
+                carrySaveAdd(foursA, twos, twos, twosA, twosB);
+                carrySaveAdd(twosA, ones, ones, _mm256_loadu_si256(data + i + 12), _mm256_loadu_si256(data + i + 13));
+                carrySaveAdd(twosB, ones, ones, _mm256_loadu_si256(data + i + 14), _mm256_loadu_si256(data + i + 15));
+                carrySaveAdd(foursB, twos, twos, twosA, twosB);
+                carrySaveAdd(eightsB, fours, fours, foursA, foursB);
+                carrySaveAdd(sixteens, eights, eights, eightsA, eightsB);
+                total = _mm256_add_epi64(total, popcount256(sixteens));
+            }
+
+            total = _mm256_slli_epi64(total, 4);
+            total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount256(eights), 3));
+            total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount256(fours), 2));
+            total = _mm256_add_epi64(total, _mm256_slli_epi64(popcount256(twos), 1));
+            total = _mm256_add_epi64(total, popcount256(ones));
+            for (; i < numVectors; ++i)
+            {
+                total = _mm256_add_epi64(total, popcount256(_mm256_loadu_si256(data + i)));
+            }
+
+            alignas(32) uint64_t lanes[4];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), total);
+            return static_cast<size_t>(lanes[0] + lanes[1] + lanes[2] + lanes[3]) +
+                   popcountScalar(words + numVectors * 4, numWords % 4);
+        }
+
+        /**
+         * @brief Popcount with the AVX-512 VPOPCNTQ instruction, eight words at a time
+         */
+        __attribute__((target("avx512f,avx512vpopcntdq"))) inline size_t popcountAvx512(const uint64_t* words, size_t numWords)
+        {
+            __m512i total = _mm512_setzero_si512();
+            size_t i = 0;
+            for (; i + 8 <= numWords; i += 8)
+            {
+                total = _mm512_add_epi64(total, _mm512_popcnt_epi64(_mm512_loadu_si512(words + i)));
+            }
+
+            alignas(64) uint64_t lanes[8];
+            _mm512_store_si512(lanes, total);
+            size_t count = popcountScalar(words + i, numWords - i);
+            for (uint64_t lane : lanes)
+            {
+                count += static_cast<size_t>(lane);
+            }
+            return count;
+        }
+#endif
+    }
+
+    /**
+     * @brief Number of set bits in an array of words, using the widest popcount the CPU
+     * supports: AVX-512 VPOPCNTQ, then AVX2 Harley-Seal, then a scalar loop. The choice is
+     * made once at runtime, so no -m flags are needed.
+     *
+     * @param words
+     * @param numWords
+     * @return size_t
+     */
+    inline size_t popcount(const uint64_t* words, size_t numWords)
+    {
+#if PDS_POPCOUNT_X86
+        enum class Path { SCALAR, AVX2, AVX512 };
+        static const Path path = [] {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512vpopcntdq"))
+                return Path::AVX512;
+            if (__builtin_cpu_supports("avx2"))
+                return Path::AVX2;
+            return Path::SCALAR;
+        }();
+
+        // Below a few vectors the dispatch and reduction cost more than they save
+        if (numWords >= 64)
+        {
+            if (path == Path::AVX512)
+                return detail::popcountAvx512(words, numWords);
+            if (path == Path::AVX2)
+                return detail::popcountAvx2(words, numWords);
+        }
+#endif
+        return detail::popcountScalar(words, numWords);
+    }
+}
@@ -0,0 +1,250 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "pds/core/concurrency.h"
+
+namespace pds::core
+{
+    namespace detail
+    {
+        /**
+         * @brief Small index fixed for the lifetime of the calling thread, used to spread
+         * threads over reader slots
+         *
+         * @return size_t
+         */
+        inline size_t threadIndex()
+        {
+            static std::atomic<size_t> next{0};
+            thread_local const size_t index = next.fetch_add(1, std::memory_order_relaxed);
+            return index;
+        }
+    }
+
+    /**
+     * @brief Read-copy-update handle to an immutable T, for structures rebuilt in the background
+     * while other threads query them. Readers take a Guard, which is wait-free: two atomic
+     * increments and a load, with no lock shared with the writer. A writer publishes a
+     * replacement with one atomic exchange; the version it replaces is retired and destroyed
+     * once every reader that could have seen it has dropped its Guard.
+     *
+     * Reclamation is epoch based. Each reader slot counts the readers that entered under an
+     * even and under an odd epoch. The epoch only advances once the parity it is about to
+     * reuse has no readers, so a version retired at epoch e is unreachable by epoch e + 2.
+     * Threads share slots by thread index, so any number of threads may read.
+     *
+     * Readers must only call const members of T that do not write to it. The structures of this
+     * library write to their metrics and visualiser from const queries, so compile with
+     * PDS_METRICS and PDS_VISUALISE at 0 to share them through a Snapshot.
+     *
+     * @tparam T
+     */
+    template <typename T>
+    class Snapshot
+    {
+        struct alignas(CACHE_LINE_SIZE) ReaderSlot
+        {
+            std::atomic<uint64_t> readers[2] = {0, 0}; // Readers inside, by parity of the epoch they entered under
+        };
+
+        struct Retired
+        {
+            T* value;
+            uint64_t epoch; // Epoch at which it was replaced
+        };
+
+        public:
+        /**
+         * @brief Keeps a reader's version alive until it is destroyed
+         */
+        class Guard
+        {
+            public:
+            Guard(Guard&& other) noexcept
+                : _slot(std::exchange(other._slot, nullptr)), _parity(other._parity), _value(other._value) {}
+
+            Guard(const Guard&) = delete;
+            Guard& operator=(const Guard&) = delete;
+            Guard& operator=(Guard&&) = delete;
+
+            ~Guard()
+            {
+                if (_slot != nullptr)
+                {
+                    _slot->readers[_parity].fetch_sub(1, std::memory_order_release);
+                }
+            }
+
+            const T* get() const { return _value; }
+            const T& operator*() const { return *_value; }
+            const T* operator->() const { return _value; }
+            explicit operator bool() const { return _value != nullptr; }
+
+            private:
+            friend class Snapshot;
+
+            Guard(ReaderSlot* slot, size_t parity, const T* value)
+                : _slot(slot), _parity(parity), _value(value) {}
+
+            ReaderSlot* _slot;
+            size_t _parity;
+            const T* _value;
+        };
+
+        explicit Snapshot(std::pmr::memory_resource* resource = std::pmr::get_default_resource(), size_t readerSlots = 64)
+            : _allocator(resource), _current(nullptr), _epoch(0), _slots(std::max<size_t>(readerSlots, 1)),
+              _retired(resource)
+        {
+            _readerSlots = std::pmr::polymorphic_allocator<ReaderSlot>(resource).allocate(_slots);
+            for (size_t i = 0; i < _slots; ++i)
+            {
+                new (&_readerSlots[i]) ReaderSlot();
+            }
+        }
+
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator=(const Snapshot&) = delete;
+
+        /**
+         * @brief Destroys every version. No Guard may outlive the Snapshot.
+         */
+        ~Snapshot()
+        {
+            destroy(_current.load(std::memory_order_acquire));
+            for (const Retired& retired : _retired)
+            {
+                destroy(retired.value);
+            }
+            std::pmr::polymorphic_allocator<ReaderSlot>(_allocator.resource()).deallocate(_readerSlots, _slots);
+        }
+
+        /**
+         * @brief Wait-free access to the current version, null until the first publish
+         *
+         * @return Guard
+         */
+        Guard read() const
+        {
+            ReaderSlot* slot = &_readerSlots[detail::threadIndex() % _slots];
+            const size_t parity = static_cast<size_t>(_epoch.load(std::memory_order_seq_cst) & 1);
+            slot->readers[parity].fetch_add(1, std::memory_order_seq_cst);
+            return Guard(slot, parity, _current.load(std::memory_order_seq_cst));
+        }
+
+        /**
+         * @brief Constructs a new version from args, e.g. a freshly built T to move in, and makes it
+         * the one new readers see. The version it replaces is retired, and any retired versions no
+         * reader can still hold are destroyed.
+         *
+         * @tparam Args
+         * @param args
+         */
+        template <typename... Args>
+        void publish(Args&&... args)
+        {
+            T* value = _allocator.allocate(1);
+            new (value) T(std::forward<Args>(args)...);
+
+            std::lock_guard<std::mutex> lock(_writerMutex);
+            T* old = _current.exchange(value, std::memory_order_seq_cst);
+            if (old != nullptr)
+            {
+                _retired.push_back({old, _epoch.load(std::memory_order_relaxed)});
+            }
+            reclaimLocked();
+        }
+
+        /**
+         * @brief Destroys the retired versions no reader can still hold. Called by publish, and
+         * useful after the last publish of a burst so that old versions are not kept waiting.
+         *
+         * @return size_t Number of versions destroyed
+         */
+        size_t reclaim()
+        {
+            std::lock_guard<std::mutex> lock(_writerMutex);
+            return reclaimLocked();
+        }
+
+        /**
+         * @brief Retired versions still waiting for their readers
+         *
+         * @return size_t
+         */
+        size_t getRetiredCount() const
+        {
+            std::lock_guard<std::mutex> lock(_writerMutex);
+            return _retired.size();
+        }
+
+        uint64_t getEpoch() const
+        {
+            return _epoch.load(std::memory_order_acquire);
+        }
+
+        private:
+        size_t reclaimLocked()
+        {
+            if (_retired.empty())
+                return 0;
+
+            // Advance at most twice: enough for everything retired so far to become unreachable
+            const uint64_t target = _retired.back().epoch + 2;
+            for (uint64_t epoch = _epoch.load(std::memory_order_relaxed); epoch < target; ++epoch)
+            {
+                const size_t reused = static_cast<size_t>((epoch + 1) & 1);
+                for (size_t i = 0; i < _slots; ++i)
+                {
+                    if (_readerSlots[i].readers[reused].load(std::memory_order_seq_cst) != 0)
+                        return freeUpTo(epoch);
+                }
+                _epoch.store(epoch + 1, std::memory_order_seq_cst);
+            }
+            return freeUpTo(_epoch.load(std::memory_order_relaxed));
+        }
+
+        /**
+         * @brief Destroys the retired versions that are unreachable at the given epoch
+         *
+         * @param epoch
+         * @return size_t
+         */
+        size_t freeUpTo(uint64_t epoch)
+        {
+            size_t freed = 0;
+            while (freed < _retired.size() && _retired[freed].epoch + 2 <= epoch)
+            {
+                destroy(_retired[freed].value);
+                ++freed;
+            }
+            _retired.erase(_retired.begin(), _retired.begin() + static_cast<std::ptrdiff_t>(freed));
+            return freed;
+        }
+
+        void destroy(T* value)
+        {
+            if (value != nullptr)
+            {
+                value->~T();
+                _allocator.deallocate(value, 1);
+            }
+        }
+
+        std::pmr::polymorphic_allocator<T> _allocator;
+        std::atomic<T*> _current;
+        std::atomic<uint64_t> _epoch;
+        size_t _slots;
+        ReaderSlot* _readerSlots;
+        std::pmr::vector<Retired> _retired; // In order of retirement, so of epoch
+        mutable std::mutex _writerMutex; // Serialises publishers and reclamation
+    };
+}
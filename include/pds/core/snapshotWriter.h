@@ -0,0 +1,317 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "pds/core/common.h"
+
+namespace pds::core
+{
+    enum class SnapshotFormat : uint8_t
+    {
+        JSON, // One JSON object per line
+        CSV   // A header row, then one row per snapshot
+    };
+
+    /**
+     * @brief A structure's array at one operation, run-length encoded as (value, length)
+     * pairs: bits for bit arrays and occupancy, counts for counter arrays
+     */
+    struct StateSnapshot
+    {
+        std::string structure;
+        uint64_t sequence = 0; // Index of the operation among all those seen by the writer
+        VisualContext context = VisualContext::UNKNOWN;
+        std::optional<size_t> highlight;
+        std::string action; // Last action logged before the snapshot, without colour codes
+        size_t length = 0;
+        std::vector<std::pair<uint32_t, uint64_t>> runs;
+
+        /**
+         * @brief Run-length encodes numValues values read through valueAt(i)
+         *
+         * @tparam Fn
+         * @param numValues
+         * @param valueAt
+         */
+        template <typename Fn>
+        void encode(size_t numValues, Fn&& valueAt)
+        {
+            length = numValues;
+            runs.clear();
+            for (size_t i = 0; i < numValues; ++i)
+            {
+                const uint32_t value = static_cast<uint32_t>(valueAt(i));
+                if (!runs.empty() && runs.back().first == value)
+                {
+                    ++runs.back().second;
+                }
+                else
+                {
+                    runs.emplace_back(value, 1);
+                }
+            }
+        }
+    };
+
+    /**
+     * @brief Machine-readable backend for the visualisers. Once attached to a structure with
+     * setSnapshotWriter, its visualiser stops drawing to std::cout and hands every sampleEvery-th
+     * state to this writer as a compact run-length encoded snapshot instead. With a background
+     * thread the formatting and I/O leave the operation's thread; if the queue is full the
+     * snapshot is dropped and counted rather than blocking the operation.
+     */
+    class SnapshotWriter
+    {
+        public:
+        static constexpr size_t DEFAULT_QUEUE_CAPACITY = 4096;
+
+        SnapshotWriter(std::ostream& out, SnapshotFormat format, uint64_t sampleEvery = 1, bool background = true,
+                       size_t queueCapacity = DEFAULT_QUEUE_CAPACITY)
+            : _out(out), _format(format), _sampleEvery(sampleEvery == 0 ? 1 : sampleEvery),
+              _queueCapacity(queueCapacity), _operations(0), _dropped(0), _stopping(false)
+        {
+            if (_format == SnapshotFormat::CSV)
+            {
+                _out << "structure,sequence,context,highlight,action,length,runs\n";
+            }
+
+            if (background)
+            {
+                _worker = std::thread([this] { run(); });
+            }
+        }
+
+        SnapshotWriter(const SnapshotWriter&) = delete;
+        SnapshotWriter& operator=(const SnapshotWriter&) = delete;
+
+        ~SnapshotWriter()
+        {
+            if (_worker.joinable())
+            {
+                {
+                    std::lock_guard<std::mutex> guard(_mutex);
+                    _stopping = true;
+                }
+                _ready.notify_one();
+                _worker.join();
+            }
+            _out.flush();
+        }
+
+        /**
+         * @brief Counts an operation and returns its sequence number if it is to be sampled
+         *
+         * @return std::optional<uint64_t>
+         */
+        std::optional<uint64_t> sample()
+        {
+            std::lock_guard<std::mutex> guard(_mutex);
+            const uint64_t sequence = _operations++;
+            if (sequence % _sampleEvery != 0)
+                return std::nullopt;
+
+            return sequence;
+        }
+
+        /**
+         * @brief Queues a snapshot for the background thread, or writes it now without one
+         *
+         * @param snapshot
+         */
+        void submit(StateSnapshot snapshot)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            if (!_worker.joinable())
+            {
+                write(snapshot);
+                return;
+            }
+
+            if (_queue.size() >= _queueCapacity)
+            {
+                ++_dropped;
+                return;
+            }
+
+            _queue.push_back(std::move(snapshot));
+            lock.unlock();
+            _ready.notify_one();
+        }
+
+        /**
+         * @brief Samples the operation and, if it is chosen, encodes the array read through
+         * valueAt and submits it along with the last action logged
+         *
+         * @tparam Fn
+         * @param structure
+         * @param context
+         * @param highlight
+         * @param action
+         * @param length
+         * @param valueAt
+         */
+        template <typename Fn>
+        void capture(std::string_view structure, VisualContext context, std::optional<size_t> highlight,
+                     std::string_view action, size_t length, Fn&& valueAt)
+        {
+            const auto sequence = sample();
+            if (!sequence.has_value())
+                return;
+
+            StateSnapshot snapshot;
+            snapshot.structure = structure;
+            snapshot.sequence = *sequence;
+            snapshot.context = context;
+            snapshot.highlight = highlight;
+            snapshot.action = stripColour(action);
+            snapshot.encode(length, std::forward<Fn>(valueAt));
+            submit(std::move(snapshot));
+        }
+
+        /**
+         * @brief Blocks until every queued snapshot has been written
+         */
+        void flush()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _drained.wait(lock, [this] { return _queue.empty() && !_writing; });
+            _out.flush();
+        }
+
+        uint64_t getDropped() const
+        {
+            std::lock_guard<std::mutex> guard(_mutex);
+            return _dropped;
+        }
+
+        /**
+         * @brief Removes ANSI colour codes, which the visualisers put in their action strings
+         *
+         * @param text
+         * @return std::string
+         */
+        static std::string stripColour(std::string_view text)
+        {
+            std::string plain;
+            plain.reserve(text.size());
+            for (size_t i = 0; i < text.size(); ++i)
+            {
+                if (text[i] == '\033' && i + 1 < text.size() && text[i + 1] == '[')
+                {
+                    i += 2;
+                    while (i < text.size() && !(text[i] >= '@' && text[i] <= '~'))
+                    {
+                        ++i;
+                    }
+                    continue;
+                }
+                plain += text[i];
+            }
+            return plain;
+        }
+
+        private:
+        void run()
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            while (true)
+            {
+                _ready.wait(lock, [this] { return _stopping || !_queue.empty(); });
+                if (_queue.empty())
+                    return;
+
+                StateSnapshot snapshot = std::move(_queue.front());
+                _queue.pop_front();
+                _writing = true;
+                lock.unlock();
+
+                write(snapshot);
+
+                lock.lock();
+                _writing = false;
+                if (_queue.empty())
+                {
+                    _drained.notify_all();
+                }
+            }
+        }
+
+        void write(const StateSnapshot& snapshot)
+        {
+            const std::string highlight = snapshot.highlight.has_value() ? std::to_string(*snapshot.highlight) : "";
+            if (_format == SnapshotFormat::JSON)
+            {
+                _out << "{\"structure\":\"" << snapshot.structure << "\",\"sequence\":" << snapshot.sequence
+                     << ",\"context\":\"" << toString(snapshot.context) << "\",\"highlight\":"
+                     << (highlight.empty() ? "null" : highlight) << ",\"action\":";
+                writeQuoted(snapshot.action, '\\');
+                _out << ",\"length\":" << snapshot.length << ",\"runs\":[";
+                for (size_t i = 0; i < snapshot.runs.size(); ++i)
+                {
+                    _out << (i == 0 ? "[" : ",[") << snapshot.runs[i].first << "," << snapshot.runs[i].second << "]";
+                }
+                _out << "]}\n";
+            }
+            else
+            {
+                _out << snapshot.structure << "," << snapshot.sequence << "," << toString(snapshot.context) << ","
+                     << highlight << ",";
+                writeQuoted(snapshot.action, '"');
+                _out << "," << snapshot.length << ",";
+                for (size_t i = 0; i < snapshot.runs.size(); ++i)
+                {
+                    _out << (i == 0 ? "" : " ") << snapshot.runs[i].first << "x" << snapshot.runs[i].second;
+                }
+                _out << "\n";
+            }
+        }
+
+        /**
+         * @brief Writes text in double quotes, escaping quotes with the given character,
+         * backslash for JSON and a doubled quote for CSV
+         */
+        void writeQuoted(const std::string& text, char escape)
+        {
+            _out << '"';
+            for (char c : text)
+            {
+                if (c == '"' || (escape == '\\' && c == '\\'))
+                {
+                    _out << escape;
+                }
+                if (escape == '\\' && static_cast<unsigned char>(c) < 0x20)
+                {
+                    _out << ' ';
+                    continue;
+                }
+                _out << c;
+            }
+            _out << '"';
+        }
+
+        std::ostream& _out;
+        SnapshotFormat _format;
+        uint64_t _sampleEvery;
+        size_t _queueCapacity;
+        uint64_t _operations;
+        uint64_t _dropped;
+        bool _stopping;
+        bool _writing = false;
+
+        mutable std::mutex _mutex;
+        std::condition_variable _ready;
+        std::condition_variable _drained;
+        std::deque<StateSnapshot> _queue;
+        std::thread _worker;
+    };
+}
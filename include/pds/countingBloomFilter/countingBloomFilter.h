@@ -6,8 +6,14 @@
 #include <functional>
 #include <optional>
 #include <cmath>
+#include <limits>
+#include <memory_resource>
 
 #include "pds/core/common.h"
+#include "pds/core/bitArray.h"
+#include "pds/core/checkpoint.h"
+#include "pds/core/hash.h"
+#include "pds/core/metrics.h"
 #include "countingBloomFilterVisualiser.h"
 
 namespace pds::bloomFilter
@@ -19,10 +25,9 @@ namespace pds::bloomFilter
         friend class CountingBloomFilterVisualiser<T>;
 
         public:
-        CountingBloomFilter();
-        ~CountingBloomFilter();
+        explicit CountingBloomFilter(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
-        void init(size_t numHashFunctions);
+        void init(size_t numHashFunctions, size_t bitArraySize = BIT_ARRAY_SIZE);
         void insert(const T& item);
         std::optional<float> query(const T& item) const;
         void erase(const T& item);
@@ -31,22 +36,42 @@ namespace pds::bloomFilter
         int32_t getSize() const;
         bool isEmpty() const;
 
+        core::Stats stats() const;
+        void setMetricsSink(core::MetricsSink* sink, uint64_t publishInterval = 1024);
+        void setSnapshotWriter(core::SnapshotWriter* writer);
+
+        bool checkpoint(std::ostream& out);
+        bool checkpointDelta(std::ostream& out);
+        bool restore(std::istream& in);
+        size_t getDirtyPages() const;
+
         private:
+        // A counter that reaches the maximum sticks there: its true count is unknown, so erase
+        // leaves it alone rather than risk a false negative
+        static constexpr uint8_t COUNTER_MAX = std::numeric_limits<uint8_t>::max();
+        static constexpr uint64_t CHECKPOINT_TAG = 0x3130464243534450; // "PDSCBF01"
+
         size_t _k; // Number of hash functions
         int32_t _count; // Count of number of set bits in the bit array
-        std::bitset<BIT_ARRAY_SIZE>* _bitArray; // Using vector to allow counting
-        std::vector<uint8_t>* _counterArray; // counter for enabling deletions
+        core::BitArray _bitArray;
+        std::pmr::vector<uint8_t> _counterArray; // counter for enabling deletions
+        core::DirtyPages _dirtyCounters; // Pages of _counterArray changed since the last checkpoint
+        uint64_t _checkpointSequence; // Sequence of the last checkpoint record written or restored, 0 before a base
+
+        std::pmr::vector<std::function<size_t(const T&)>> _hashFunctions;
+
+        std::pmr::unordered_set<T> _items; // To track inserted items, only while visualising
+        mutable core::Metrics _metrics;
 
-        std::vector<std::function<size_t(const T&)>> _hashFunctions;
+        void publishMetrics() const;
 
-        std::unordered_set<T> _items; // To track inserted items
         float computeFalsePositiveProbability() const
         {
             if (_k == 0 || _count == 0)
                 return 0.0f;
 
             float n = static_cast<float>(_count);              // Number of bits set
-            float m = static_cast<float>(_bitArray->size());   // Bit array size
+            float m = static_cast<float>(_bitArray.size());   // Bit array size
 
             float exponent = -static_cast<float>(_k) * (n / m);
             float base = 1.0f - std::exp(exponent);
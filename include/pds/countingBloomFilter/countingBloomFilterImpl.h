@@ -6,36 +6,37 @@
 namespace pds::bloomFilter
 {
     template <typename T>
-    CountingBloomFilter<T>::CountingBloomFilter()
+    CountingBloomFilter<T>::CountingBloomFilter(std::pmr::memory_resource* resource)
         : _k(0), _count(0),
-          _bitArray(new std::bitset<BIT_ARRAY_SIZE>()),
-          _counterArray(new std::vector<uint8_t>(BIT_ARRAY_SIZE, 0)) {}
+          _bitArray(BIT_ARRAY_SIZE, resource),
+          _counterArray(BIT_ARRAY_SIZE, 0, resource),
+          _dirtyCounters(BIT_ARRAY_SIZE, resource), _checkpointSequence(0),
+          _hashFunctions(resource), _items(resource) {}
 
     template <typename T>
-    CountingBloomFilter<T>::~CountingBloomFilter()
-    {
-        delete _bitArray;
-        delete _counterArray;
-    }
-
-    template <typename T>
-    void CountingBloomFilter<T>::init(size_t numHashFunctions)
+    void CountingBloomFilter<T>::init(size_t numHashFunctions, size_t bitArraySize)
     {
         _k = numHashFunctions;
         _count = 0;
-        _bitArray->reset();
-        _counterArray->assign(BIT_ARRAY_SIZE, 0);
+        _bitArray.resize(bitArraySize);
+        _counterArray.assign(bitArraySize, 0);
+        _dirtyCounters.resize(bitArraySize);
+        _checkpointSequence = 0;
         _hashFunctions.clear();
+        _metrics.reset();
 
         for (size_t i = 0; i < _k; ++i)
         {
             _hashFunctions.emplace_back([i](const T& item) {
-                return std::hash<T>{}(item) ^ (i * 0x9e3779b9);
+                return core::seededHash(item, i);
             });
         }
 
-        _visualiser.logAction("[Init] Counting Bloom Filter initialized with " + std::to_string(_k) + " hash functions");
-        _visualiser.logState(*this, std::nullopt, VisualContext::INIT);
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("[Init] Counting Bloom Filter initialized with " + std::to_string(_k) + " hash functions");
+            _visualiser.logState(*this, std::nullopt, VisualContext::INIT);
+        }
     }
 
     template <typename T>
@@ -43,19 +44,33 @@ namespace pds::bloomFilter
     {
         for (const auto& hashFunc : _hashFunctions)
         {
-            size_t idx = hashFunc(item) % BIT_ARRAY_SIZE;
-            if ((*_counterArray)[idx] == 0)
+            size_t idx = hashFunc(item) % _counterArray.size();
+            if (_counterArray[idx] == 0)
+            {
+                _bitArray.set(idx);
+            }
+
+            if (_counterArray[idx] == COUNTER_MAX)
+            {
+                _metrics.recordSaturation();
+            }
+            else
             {
-                _bitArray->set(idx);
+                ++_counterArray[idx];
+                _dirtyCounters.mark(idx);
             }
-            ++(*_counterArray)[idx];
         }
 
-        _items.insert(item);
         ++_count;
+        _metrics.recordInsert();
+        publishMetrics();
 
-        _visualiser.logAction("\033[32m[Insert]\033[0m " + item);
-        _visualiser.logState(*this, std::nullopt, VisualContext::INSERT);
+        if constexpr (VISUALISE)
+        {
+            _items.insert(item);
+            _visualiser.logAction("\033[32m[Insert]\033[0m " + toDisplayString(item));
+            _visualiser.logState(*this, std::nullopt, VisualContext::INSERT);
+        }
     }
 
     template <typename T>
@@ -63,26 +78,36 @@ namespace pds::bloomFilter
     {
         for (const auto& hashFunc : _hashFunctions)
         {
-            size_t idx = hashFunc(item) % BIT_ARRAY_SIZE;
-            if ((*_counterArray)[idx] == 0)
+            size_t idx = hashFunc(item) % _counterArray.size();
+            if (_counterArray[idx] == 0)
             {
-                _visualiser.logAction("\033[31m[Query Miss]\033[0m " + item + " at index " + std::to_string(idx));
-                _visualiser.logState(*this, idx, VisualContext::QUERY);
+                if constexpr (VISUALISE)
+                {
+                    _visualiser.logAction("\033[31m[Query Miss]\033[0m " + toDisplayString(item) + " at index " + std::to_string(idx));
+                    _visualiser.logState(*this, idx, VisualContext::QUERY);
+                }
+                _metrics.recordQuery(false);
+                publishMetrics();
                 return std::nullopt;
             }
         }
 
-        if (_items.find(item) == _items.end())
+        if constexpr (VISUALISE)
         {
-            _visualiser.logAction("\033[33m[Query False Positive]\033[0m " + item);
-        }
-        else
-        {
-            _visualiser.logAction("\033[34m[Query Hit]\033[0m " + item);
-        }
+            if (_items.find(item) == _items.end())
+            {
+                _visualiser.logAction("\033[33m[Query False Positive]\033[0m " + toDisplayString(item));
+            }
+            else
+            {
+                _visualiser.logAction("\033[34m[Query Hit]\033[0m " + toDisplayString(item));
+            }
 
-        _visualiser.logState(*this, std::nullopt, VisualContext::QUERY);
+            _visualiser.logState(*this, std::nullopt, VisualContext::QUERY);
+        }
 
+        _metrics.recordQuery(true);
+        publishMetrics();
         return std::make_optional<float>(computeFalsePositiveProbability());
     }
 
@@ -91,30 +116,34 @@ namespace pds::bloomFilter
     {
         for (const auto& hashFunc : _hashFunctions)
         {
-            size_t idx = hashFunc(item) % BIT_ARRAY_SIZE;
-            if ((*_counterArray)[idx] > 0)
+            size_t idx = hashFunc(item) % _counterArray.size();
+            if (_counterArray[idx] > 0 && _counterArray[idx] < COUNTER_MAX)
             {
-                --(*_counterArray)[idx];
-                if ((*_counterArray)[idx] == 0)
+                --_counterArray[idx];
+                _dirtyCounters.mark(idx);
+                if (_counterArray[idx] == 0)
                 {
-                    _bitArray->reset(idx);
+                    _bitArray.reset(idx);
                     --_count;
                 }
             }
         }
 
-        if(_items.find(item) != _items.end())
+        if constexpr (VISUALISE)
         {
             _items.erase(item);
+            _visualiser.logAction("\033[32m[Erase]\033[0m " + toDisplayString(item));
+            _visualiser.logState(*this, std::nullopt, VisualContext::ERASE);
         }
-        _visualiser.logAction("\033[32m[Erase]\033[0m " + item);
-        _visualiser.logState(*this, std::nullopt, VisualContext::ERASE);
+
+        _metrics.recordErase();
+        publishMetrics();
     }
 
     template <typename T>
     int32_t CountingBloomFilter<T>::getLoadFactor() const
     {
-        return (_count * 100) / BIT_ARRAY_SIZE;
+        return static_cast<int32_t>((static_cast<size_t>(_count) * 100) / _counterArray.size());
     }
 
     template <typename T>
@@ -128,4 +157,180 @@ namespace pds::bloomFilter
     {
         return _count == 0;
     }
-}
\ No newline at end of file
+
+    /**
+     * @brief Snapshot of the operation counters, saturated counter increments and the fraction of non-zero counters
+     *
+     * @tparam T
+     * @return core::Stats
+     */
+    template <typename T>
+    core::Stats CountingBloomFilter<T>::stats() const
+    {
+        const size_t size = _counterArray.size();
+        return _metrics.snapshot(size == 0 ? 0.0f : static_cast<float>(_bitArray.count()) / static_cast<float>(size));
+    }
+
+    /**
+     * @brief Attaches a sink that receives stats() every publishInterval operations, or detaches it given nullptr.
+     * Has no effect unless PDS_METRICS is 1.
+     *
+     * @tparam T
+     * @param sink
+     * @param publishInterval
+     */
+    template <typename T>
+    void CountingBloomFilter<T>::setMetricsSink(core::MetricsSink* sink, uint64_t publishInterval)
+    {
+        _metrics.setSink(sink, publishInterval);
+    }
+
+    /**
+     * @brief Has the visualiser emit sampled, run-length encoded snapshots to the writer
+     * instead of drawing every operation to std::cout. Only has an effect while PDS_VISUALISE is 1.
+     *
+     * @tparam T
+     * @param writer
+     */
+    template <typename T>
+    void CountingBloomFilter<T>::setSnapshotWriter(core::SnapshotWriter* writer)
+    {
+        _visualiser.setSnapshotWriter(writer);
+    }
+
+    /**
+     * @brief Writes a base checkpoint, every counter page, to the stream and starts a new
+     * chain of deltas after it
+     *
+     * @tparam T
+     * @param out
+     * @return true
+     * @return false if the stream failed
+     */
+    template <typename T>
+    bool CountingBloomFilter<T>::checkpoint(std::ostream& out)
+    {
+        if (!core::writeCheckpoint(out, CHECKPOINT_TAG, core::CheckpointKind::BASE, 1,
+                                   {_k, static_cast<uint64_t>(_count), 0, 0},
+                                   {{_counterArray.data(), _counterArray.size(), &_dirtyCounters}}))
+            return false;
+
+        _checkpointSequence = 1;
+        return true;
+    }
+
+    /**
+     * @brief Writes only the 4KB pages of counters changed since the last checkpoint, so its
+     * cost follows the write rate rather than the size of the filter. Append it to the stream
+     * holding the base, or keep it with the base for restore to replay.
+     *
+     * @tparam T
+     * @param out
+     * @return true
+     * @return false if no base was written since init, or the stream failed
+     */
+    template <typename T>
+    bool CountingBloomFilter<T>::checkpointDelta(std::ostream& out)
+    {
+        if (_checkpointSequence == 0 ||
+            !core::writeCheckpoint(out, CHECKPOINT_TAG, core::CheckpointKind::DELTA, _checkpointSequence + 1,
+                                   {_k, static_cast<uint64_t>(_count), 0, 0},
+                                   {{_counterArray.data(), _counterArray.size(), &_dirtyCounters}}))
+            return false;
+
+        ++_checkpointSequence;
+        return true;
+    }
+
+    /**
+     * @brief Rebuilds the filter from a stream of checkpoint records: a base, then the deltas
+     * written after it. Replay stops at the end of the stream or at the first torn, corrupt or
+     * out of sequence record, which is where a crash mid-write leaves the stream. Further deltas
+     * can then be appended after the last record applied.
+     *
+     * A later base starts a new chain only once all of its pages are verified, so a base torn
+     * after an earlier chain keeps that chain. The filter is untouched until replay ends.
+     *
+     * @tparam T
+     * @param in
+     * @return true if a base was restored
+     * @return false if the stream does not start with an intact base, leaving the filter empty
+     */
+    template <typename T>
+    bool CountingBloomFilter<T>::restore(std::istream& in)
+    {
+        std::pmr::memory_resource* resource = _counterArray.get_allocator().resource();
+        core::CheckpointRecord record(resource);
+        std::pmr::vector<uint8_t> counters(resource); // Last verified chain
+        std::pmr::vector<uint8_t> staged(resource); // Base being read
+        uint64_t k = 0;
+        uint64_t count = 0;
+        uint64_t sequence = 0;
+        while (core::readCheckpointHeader(in, record) && record.tag == CHECKPOINT_TAG && record.numRegions == 1)
+        {
+            if (record.kind == core::CheckpointKind::BASE)
+            {
+                if (record.sequence != 1 || record.state[0] == 0 || record.regionSizes[0] == 0)
+                    break;
+
+                staged.assign(static_cast<size_t>(record.regionSizes[0]), 0);
+                if (!core::readCheckpointPages(in, record, {{staged.data(), staged.size()}}))
+                    break;
+
+                counters.swap(staged);
+                k = record.state[0];
+            }
+            else if (sequence == 0 || record.sequence != sequence + 1 ||
+                     !core::readCheckpointPages(in, record, {{counters.data(), counters.size()}}))
+            {
+                break;
+            }
+
+            count = record.state[1];
+            sequence = record.sequence;
+        }
+
+        if (sequence == 0)
+        {
+            init(_k, _counterArray.size());
+            return false;
+        }
+
+        init(static_cast<size_t>(k), counters.size());
+        _counterArray.swap(counters);
+        _count = static_cast<int32_t>(count);
+        _checkpointSequence = sequence;
+
+        // The bit array mirrors which counters are non-zero
+        for (size_t i = 0; i < _counterArray.size(); ++i)
+        {
+            if (_counterArray[i] != 0)
+            {
+                _bitArray.set(i);
+            }
+        }
+        _dirtyCounters.clear();
+        return true;
+    }
+
+    /**
+     * @brief Pages of counters the next delta checkpoint would write
+     *
+     * @tparam T
+     * @return size_t
+     */
+    template <typename T>
+    size_t CountingBloomFilter<T>::getDirtyPages() const
+    {
+        return _dirtyCounters.count();
+    }
+
+    template <typename T>
+    void CountingBloomFilter<T>::publishMetrics() const
+    {
+        if (_metrics.publishDue())
+        {
+            _metrics.publish("CountingBloomFilter", stats());
+        }
+    }
+}
@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "pds/core/common.h"
+#include "pds/core/snapshotWriter.h"
 
 namespace pds::bloomFilter
 {
@@ -17,8 +18,23 @@ namespace pds::bloomFilter
     class CountingBloomFilterVisualiser
     {
     public:
+        /**
+         * @brief Sends sampled snapshots to the writer instead of drawing to std::cout, or draws again given nullptr
+         *
+         * @param writer
+         */
+        void setSnapshotWriter(core::SnapshotWriter* writer)
+        {
+            _writer = writer;
+        }
+
         void logAction(const std::string& action) const
         {
+            if (_writer != nullptr)
+            {
+                _lastAction = action;
+                return;
+            }
             std::cout << action << "\n";
         }
 
@@ -26,11 +42,19 @@ namespace pds::bloomFilter
                       std::optional<size_t> highlight = std::nullopt,
                       pds::VisualContext ctx = pds::VisualContext::UNKNOWN) const
         {
+            if (_writer != nullptr)
+            {
+                _writer->capture("CountingBloomFilter", ctx, highlight, _lastAction, table._counterArray.size(),
+                                 [&table](size_t i) { return table._counterArray[i]; });
+                return;
+            }
+
             constexpr size_t rowSize = 32;
+            const size_t counterArraySize = table._counterArray.size();
             std::cout << "\n[Counting Bloom Filter State] Context: " << toString(ctx) << "\n\n";
 
             // Print Counter Array
-            for (size_t i = 0; i < BIT_ARRAY_SIZE; ++i)
+            for (size_t i = 0; i < counterArraySize; ++i)
             {
                 if (i % rowSize == 0)
                 {
@@ -38,7 +62,7 @@ namespace pds::bloomFilter
                 }
 
                 bool isHighlighted = highlight.has_value() && highlight.value() == i;
-                int32_t count = (*table._counterArray)[i];
+                int32_t count = table._counterArray[i];
 
                 if (isHighlighted)
                 {
@@ -64,10 +88,10 @@ namespace pds::bloomFilter
                 }
             }
 
-            if (BIT_ARRAY_SIZE % rowSize != 0)
+            if (counterArraySize % rowSize != 0)
             {
-                size_t start = BIT_ARRAY_SIZE - (BIT_ARRAY_SIZE % rowSize);
-                std::cout << "  <- [" << start << " - " << BIT_ARRAY_SIZE - 1 << "]\n";
+                size_t start = counterArraySize - (counterArraySize % rowSize);
+                std::cout << "  <- [" << start << " - " << counterArraySize - 1 << "]\n";
             }
 
             std::cout << "\n";
@@ -89,5 +113,9 @@ namespace pds::bloomFilter
             }
             std::cout << '\n';
         }
+
+    private:
+        core::SnapshotWriter* _writer = nullptr;
+        mutable std::string _lastAction; // Attached to the next snapshot
     };
 }
\ No newline at end of file
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <memory_resource>
+
+#include "pds/core/common.h"
+#include "pds/core/bitStream.h"
+#include "pds/core/hash.h"
+
+namespace pds::bloomFilter
+{
+    /**
+     * @brief Invertible Bloom Lookup Table for set reconciliation. Like a counting Bloom filter,
+     * each item lands in k cells. Besides a count, each cell keeps the XOR of the keys in it
+     * and the XOR of a check hash of those keys. Subtracting one replica's table from another's
+     * cancels the items they share. The cells that remain can then be peeled one pure cell,
+     * holding a single key, at a time. The result lists the items each side is missing.
+     *
+     * A table sized by cellsFor for the expected difference decodes with high probability,
+     * whatever the size of the sets, and encode writes it in a few bytes per cell. Each of the k
+     * hashes indexes its own run of cells, so an item never hits one cell twice.
+     *
+     * Keys are XORed byte by byte, so T must be trivially copyable.
+     *
+     * @tparam T
+     */
+    template <typename T>
+    class InvertibleBloomLookupTable
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "InvertibleBloomLookupTable XORs the bytes of T");
+
+        public:
+        explicit InvertibleBloomLookupTable(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+        static size_t cellsFor(size_t expectedDifference, size_t numHashFunctions = 3);
+
+        void init(size_t numCells, size_t numHashFunctions = 3, uint64_t seed = 0);
+        void insert(const T& item);
+        void erase(const T& item);
+
+        bool subtract(const InvertibleBloomLookupTable& other);
+        bool peel(std::pmr::vector<T>& onlyHere, std::pmr::vector<T>& onlyThere) const;
+
+        std::pmr::vector<uint8_t> encode() const;
+        bool decode(const uint8_t* data, size_t size);
+
+        size_t getNumCells() const;
+        size_t getNumHashFunctions() const;
+        bool isEmpty() const;
+
+        private:
+        static constexpr size_t MAX_HASH_FUNCTIONS = 16;
+        static constexpr uint64_t MAX_WIRE_CELLS = uint64_t{1} << 28; // Most cells decode will allocate
+        static constexpr uint64_t CHECK_SALT = 0x2545f4914f6cdd1d;
+
+        struct Cell
+        {
+            int32_t count; // Insertions minus erasures, or differences after subtract
+            uint32_t hashXor; // XOR of the check hashes of the keys
+            std::array<unsigned char, sizeof(T)> keyXor; // XOR of the key bytes
+
+            bool isZero() const;
+            bool isPure(uint64_t seed) const;
+        };
+
+        static uint64_t keyHash(const T& item, uint64_t seed);
+        static uint32_t checkOf(uint64_t h);
+        size_t cellOf(uint64_t h, size_t i) const;
+        static void apply(Cell& cell, const unsigned char* key, uint32_t check, int32_t delta);
+        void update(const T& item, int32_t delta);
+
+        size_t _k; // Number of hash functions, each with its own run of cells
+        uint64_t _seed;
+        std::pmr::vector<Cell> _cells;
+    };
+}
+
+#include "invertibleBloomLookupTableImpl.h"
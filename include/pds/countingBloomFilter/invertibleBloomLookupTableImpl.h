@@ -0,0 +1,347 @@
+#pragma once
+
+#include <cmath>
+
+namespace pds::bloomFilter
+{
+    template <typename T>
+    InvertibleBloomLookupTable<T>::InvertibleBloomLookupTable(std::pmr::memory_resource* resource)
+        : _k(0), _seed(0), _cells(resource) {}
+
+    /**
+     * @brief Cells for a table that peels a difference of the given size with high probability.
+     * With 3 hash functions peeling succeeds once there are more than about 1.22 cells per
+     * item, so this allows 1.5 plus a margin for small differences, where variance dominates.
+     *
+     * @tparam T
+     * @param expectedDifference Items in either set but not both
+     * @param numHashFunctions
+     * @return size_t
+     */
+    template <typename T>
+    size_t InvertibleBloomLookupTable<T>::cellsFor(size_t expectedDifference, size_t numHashFunctions)
+    {
+        const size_t cells = static_cast<size_t>(std::ceil(1.5 * static_cast<double>(expectedDifference))) + 30;
+        const size_t k = std::clamp<size_t>(numHashFunctions, 1, MAX_HASH_FUNCTIONS);
+        return (cells + k - 1) / k * k;
+    }
+
+    /**
+     * @brief Clears the table and sizes it. Tables that will be subtracted must share all three
+     * parameters.
+     *
+     * @tparam T
+     * @param numCells Rounded up to a multiple of the number of hash functions
+     * @param numHashFunctions Between 1 and 16
+     * @param seed
+     */
+    template <typename T>
+    void InvertibleBloomLookupTable<T>::init(size_t numCells, size_t numHashFunctions, uint64_t seed)
+    {
+        _k = std::clamp<size_t>(numHashFunctions, 1, MAX_HASH_FUNCTIONS);
+        _seed = seed;
+        const size_t perHash = std::max<size_t>((numCells + _k - 1) / _k, 1);
+        _cells.assign(perHash * _k, Cell{});
+    }
+
+    template <typename T>
+    void InvertibleBloomLookupTable<T>::insert(const T& item)
+    {
+        update(item, 1);
+    }
+
+    /**
+     * @brief Removes an item inserted earlier. Erasing an item that was never inserted leaves
+     * it listed as missing from this side when the table is peeled.
+     *
+     * @tparam T
+     * @param item
+     */
+    template <typename T>
+    void InvertibleBloomLookupTable<T>::erase(const T& item)
+    {
+        update(item, -1);
+    }
+
+    /**
+     * @brief Subtracts another replica's table cell by cell, leaving only the items in one
+     * set but not the other
+     *
+     * @tparam T
+     * @param other
+     * @return true
+     * @return false if the tables differ in cells, hash functions or seed, leaving this one unchanged
+     */
+    template <typename T>
+    bool InvertibleBloomLookupTable<T>::subtract(const InvertibleBloomLookupTable& other)
+    {
+        if (_k != other._k || _seed != other._seed || _cells.size() != other._cells.size())
+            return false;
+
+        for (size_t i = 0; i < _cells.size(); ++i)
+        {
+            const Cell& theirs = other._cells[i];
+            apply(_cells[i], theirs.keyXor.data(), theirs.hashXor, -theirs.count);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Lists the items of a subtracted table: those inserted only into this table and
+     * those only in the table subtracted from it. Works on a copy of the cells, so the table
+     * can still be encoded or subtracted again.
+     *
+     * @tparam T
+     * @param onlyHere Items with a positive count, appended
+     * @param onlyThere Items with a negative count, appended
+     * @return true if every cell peeled to zero, so the lists are complete
+     * @return false if the difference was too large for the table; the lists hold what peeled
+     */
+    template <typename T>
+    bool InvertibleBloomLookupTable<T>::peel(std::pmr::vector<T>& onlyHere, std::pmr::vector<T>& onlyThere) const
+    {
+        std::pmr::vector<Cell> cells(_cells, _cells.get_allocator().resource());
+        std::pmr::vector<size_t> pure(_cells.get_allocator().resource());
+        for (size_t i = 0; i < cells.size(); ++i)
+        {
+            if (cells[i].isPure(_seed))
+            {
+                pure.push_back(i);
+            }
+        }
+
+        // A difference larger than the table cannot peel, and a cell that only looks pure
+        // could otherwise keep a corrupt table going forever
+        size_t peeled = 0;
+        while (!pure.empty() && peeled < cells.size())
+        {
+            const size_t index = pure.back();
+            pure.pop_back();
+            if (!cells[index].isPure(_seed))
+                continue;
+
+            const Cell cell = cells[index];
+            T item;
+            std::memcpy(&item, cell.keyXor.data(), sizeof(T));
+            (cell.count > 0 ? onlyHere : onlyThere).push_back(item);
+            ++peeled;
+
+            const uint64_t h = keyHash(item, _seed);
+            for (size_t i = 0; i < _k; ++i)
+            {
+                const size_t target = cellOf(h, i);
+                apply(cells[target], cell.keyXor.data(), cell.hashXor, -cell.count);
+                if (cells[target].isPure(_seed))
+                {
+                    pure.push_back(target);
+                }
+            }
+        }
+
+        return std::all_of(cells.begin(), cells.end(), [](const Cell& cell) { return cell.isZero(); });
+    }
+
+    /**
+     * @brief Serialises the table for another replica. Each cell costs one bit when empty and
+     * a gamma-coded count, 32 check bits and the key bytes otherwise, so the payload grows with
+     * the table, which cellsFor sizes to the expected difference rather than the sets.
+     *
+     * Layout: 64-bit cell count, 8-bit number of hash functions, 64-bit seed, then per cell
+     * an occupied bit followed, if set, by its fields.
+     *
+     * @tparam T
+     * @return std::pmr::vector<uint8_t>
+     */
+    template <typename T>
+    std::pmr::vector<uint8_t> InvertibleBloomLookupTable<T>::encode() const
+    {
+        core::BitWriter writer(_cells.get_allocator().resource());
+        writer.writeBits(_cells.size(), 64);
+        writer.writeBits(_k, 8);
+        writer.writeBits(_seed, 64);
+
+        for (const Cell& cell : _cells)
+        {
+            if (cell.isZero())
+            {
+                writer.writeBits(0, 1);
+                continue;
+            }
+
+            // Zigzag, so small negative counts stay short
+            const uint32_t count = static_cast<uint32_t>(cell.count);
+            const uint64_t zigzag = cell.count < 0 ? uint64_t{~count} * 2 + 1 : uint64_t{count} * 2;
+            writer.writeBits(1, 1);
+            writer.writeGamma(zigzag + 1);
+            writer.writeBits(cell.hashXor, 32);
+            for (unsigned char byte : cell.keyXor)
+            {
+                writer.writeBits(byte, 8);
+            }
+        }
+        return writer.finish();
+    }
+
+    /**
+     * @brief Replaces the table with one written by encode
+     *
+     * @tparam T
+     * @param data
+     * @param size
+     * @return true
+     * @return false if the encoding is truncated or malformed, leaving the table unchanged
+     */
+    template <typename T>
+    bool InvertibleBloomLookupTable<T>::decode(const uint8_t* data, size_t size)
+    {
+        core::BitReader reader(data, size);
+        uint64_t numCells = 0;
+        uint64_t k = 0;
+        uint64_t seed = 0;
+        if (!reader.readBits(64, numCells) || !reader.readBits(8, k) || !reader.readBits(64, seed))
+            return false;
+
+        // Every cell takes at least its occupied bit, which bounds what a corrupt header can allocate
+        if (k == 0 || k > MAX_HASH_FUNCTIONS || numCells == 0 || numCells % k != 0 || numCells > MAX_WIRE_CELLS ||
+            numCells > reader.bitsRemaining())
+            return false;
+
+        std::pmr::vector<Cell> cells(static_cast<size_t>(numCells), Cell{}, _cells.get_allocator().resource());
+        for (Cell& cell : cells)
+        {
+            uint64_t occupied = 0;
+            if (!reader.readBits(1, occupied))
+                return false;
+            if (occupied == 0)
+                continue;
+
+            uint64_t zigzag = 0;
+            uint64_t hashXor = 0;
+            if (!reader.readGamma(zigzag) || zigzag > (uint64_t{1} << 32) || !reader.readBits(32, hashXor))
+                return false;
+
+            --zigzag;
+            cell.count = static_cast<int32_t>(zigzag & 1 ? ~static_cast<uint32_t>(zigzag >> 1) : static_cast<uint32_t>(zigzag >> 1));
+            cell.hashXor = static_cast<uint32_t>(hashXor);
+            for (unsigned char& byte : cell.keyXor)
+            {
+                uint64_t value = 0;
+                if (!reader.readBits(8, value))
+                    return false;
+                byte = static_cast<unsigned char>(value);
+            }
+        }
+
+        _k = static_cast<size_t>(k);
+        _seed = seed;
+        _cells = std::move(cells);
+        return true;
+    }
+
+    template <typename T>
+    size_t InvertibleBloomLookupTable<T>::getNumCells() const
+    {
+        return _cells.size();
+    }
+
+    template <typename T>
+    size_t InvertibleBloomLookupTable<T>::getNumHashFunctions() const
+    {
+        return _k;
+    }
+
+    /**
+     * @brief Whether every cell is zero, as after subtracting the table of an identical set
+     *
+     * @tparam T
+     * @return true
+     * @return false
+     */
+    template <typename T>
+    bool InvertibleBloomLookupTable<T>::isEmpty() const
+    {
+        return std::all_of(_cells.begin(), _cells.end(), [](const Cell& cell) { return cell.isZero(); });
+    }
+
+    template <typename T>
+    bool InvertibleBloomLookupTable<T>::Cell::isZero() const
+    {
+        return count == 0 && hashXor == 0 &&
+               std::all_of(keyXor.begin(), keyXor.end(), [](unsigned char byte) { return byte == 0; });
+    }
+
+    /**
+     * @brief Whether the cell holds exactly one key, on one side: a count of plus or minus one
+     * and a check hash that matches the key
+     *
+     * @tparam T
+     * @param seed
+     * @return true
+     * @return false
+     */
+    template <typename T>
+    bool InvertibleBloomLookupTable<T>::Cell::isPure(uint64_t seed) const
+    {
+        if (count != 1 && count != -1)
+            return false;
+
+        T item;
+        std::memcpy(&item, keyXor.data(), sizeof(T));
+        return hashXor == checkOf(keyHash(item, seed));
+    }
+
+    template <typename T>
+    uint64_t InvertibleBloomLookupTable<T>::keyHash(const T& item, uint64_t seed)
+    {
+        return core::mixedHash(item, seed);
+    }
+
+    template <typename T>
+    uint32_t InvertibleBloomLookupTable<T>::checkOf(uint64_t h)
+    {
+        return static_cast<uint32_t>(core::mix64(h ^ CHECK_SALT));
+    }
+
+    /**
+     * @brief Cell of the i-th hash function, inside that function's own run of cells
+     *
+     * @tparam T
+     * @param h
+     * @param i
+     * @return size_t
+     */
+    template <typename T>
+    size_t InvertibleBloomLookupTable<T>::cellOf(uint64_t h, size_t i) const
+    {
+        const uint64_t perHash = _cells.size() / _k;
+        const uint64_t g = core::mix64(h + i * core::HASH_SEED_MULTIPLIER);
+        return static_cast<size_t>(i * perHash + (((g >> 32) * perHash) >> 32));
+    }
+
+    template <typename T>
+    void InvertibleBloomLookupTable<T>::apply(Cell& cell, const unsigned char* key, uint32_t check, int32_t delta)
+    {
+        cell.count = static_cast<int32_t>(static_cast<uint32_t>(cell.count) + static_cast<uint32_t>(delta));
+        cell.hashXor ^= check;
+        for (size_t b = 0; b < sizeof(T); ++b)
+        {
+            cell.keyXor[b] ^= key[b];
+        }
+    }
+
+    template <typename T>
+    void InvertibleBloomLookupTable<T>::update(const T& item, int32_t delta)
+    {
+        if (_cells.empty())
+            return;
+
+        unsigned char key[sizeof(T)];
+        std::memcpy(key, &item, sizeof(T));
+        const uint64_t h = keyHash(item, _seed);
+        const uint32_t check = checkOf(h);
+        for (size_t i = 0; i < _k; ++i)
+        {
+            apply(_cells[cellOf(h, i)], key, check, delta);
+        }
+    }
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <vector>
+#include <optional>
+#include <utility>
+#include <memory_resource>
+#include <type_traits>
+
+#include "pds/core/common.h"
+#include "pds/core/concurrency.h"
+#include "pds/core/hash.h"
+
+namespace pds::hashTable
+{
+    /**
+     * @brief Thread-safe open addressing hash table for a cache shared by many threads.
+     * Keys are partitioned by the high bits of their hash into cache-line padded shards,
+     * each a linear probing table. Writers take the shard's spinlock; readers of trivially
+     * copyable keys and values never lock and validate what they read against the shard's
+     * sequence counter (a seqlock), other types are read under the spinlock. Trivially
+     * copyable keys and values are stored as relaxed atomic words, so the optimistic reads
+     * do not race with the writers.
+     *
+     * The capacity is fixed by init.
+     *
+     * @tparam Key
+     * @tparam Value
+     */
+    template<typename Key, typename Value>
+    class ConcurrentOpenAddressingHashTable
+    {
+        public:
+        explicit ConcurrentOpenAddressingHashTable(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+        void init(size_t capacity, size_t numShards = 64);
+
+        bool insert(const Key& key, const Value& value);
+        std::optional<Value> query(const Key& key) const;
+        bool contains(const Key& key) const;
+        bool erase(const Key& key);
+
+        int32_t getLoadFactor() const;
+        int32_t getSize() const;
+        bool isEmpty() const;
+
+    private:
+        static constexpr bool OPTIMISTIC_READS = std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<Value>;
+
+        enum SlotState : uint8_t
+        {
+            EMPTY,
+            FULL,
+            TOMBSTONE
+        };
+
+        struct alignas(core::CACHE_LINE_SIZE) Shard
+        {
+            std::atomic<uint64_t> sequence{0}; // Odd while a writer is modifying the shard
+            mutable core::SpinLock lock;
+            std::atomic<size_t> size{0};
+            size_t tombstones = 0;
+        };
+
+        struct Location
+        {
+            size_t shard;
+            size_t home; // First slot of the probe sequence, relative to the shard
+        };
+
+        Location locate(const Key& key) const;
+        std::optional<size_t> find(const Location& location, const Key& key) const;
+        std::optional<Value> lockedQuery(const Location& location, const Key& key) const;
+        std::optional<Value> optimisticQuery(const Location& location, const Key& key) const;
+        bool keyMatches(size_t index, const Key& key) const;
+        Value valueAt(size_t index) const;
+        void storeKey(size_t index, Key key);
+        void storeValue(size_t index, Value value);
+        void beginWrite(Shard& shard);
+        void endWrite(Shard& shard);
+        void rehashShard(size_t shard);
+
+        size_t _slotsPerShard; // Power of two
+        size_t _shardBits;
+        std::pmr::vector<Shard> _shards;
+        std::pmr::vector<std::atomic<uint8_t>> _states;
+        std::conditional_t<OPTIMISTIC_READS, core::AtomicWordArray<Key>, std::pmr::vector<Key>> _keys;
+        std::conditional_t<OPTIMISTIC_READS, core::AtomicWordArray<Value>, std::pmr::vector<Value>> _values;
+    };
+}
+
+#include "concurrentOpenAddressingHashTableImpl.h"
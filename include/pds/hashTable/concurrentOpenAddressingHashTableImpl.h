@@ -0,0 +1,468 @@
+#pragma once
+
+#include <mutex>
+
+namespace pds::hashTable
+{
+    /**
+     * @brief Construct a new Concurrent Open Addressing Hash Table< Key, Value>:: Concurrent Open Addressing Hash Table object
+     * with the shards and slots drawn from the given memory resource
+     *
+     * @tparam Key
+     * @tparam Value
+     * @param resource
+     */
+    template<typename Key, typename Value>
+    ConcurrentOpenAddressingHashTable<Key, Value>::ConcurrentOpenAddressingHashTable(std::pmr::memory_resource* resource)
+        : _slotsPerShard(0), _shardBits(0),
+          _shards(resource), _states(resource), _keys(resource), _values(resource) {}
+
+    /**
+     * @brief Initialise the table with at least the given capacity split across numShards
+     * shards, both rounded up to powers of two. Not thread-safe.
+     *
+     * @tparam Key
+     * @tparam Value
+     * @param capacity
+     * @param numShards
+     */
+    template<typename Key, typename Value>
+    void ConcurrentOpenAddressingHashTable<Key, Value>::init(size_t capacity, size_t numShards)
+    {
+        _shardBits = 0;
+        while ((size_t{1} << _shardBits) < numShards)
+        {
+            ++_shardBits;
+        }
+        const size_t shards = size_t{1} << _shardBits;
+
+        _slotsPerShard = 8;
+        while (_slotsPerShard * shards < capacity)
+        {
+            _slotsPerShard <<= 1;
+        }
+
+        // Shards and slot states hold atomics, which cannot be moved into place
+        auto* resource = _shards.get_allocator().resource();
+        std::pmr::vector<Shard> freshShards(shards, resource);
+        std::pmr::vector<std::atomic<uint8_t>> freshStates(shards * _slotsPerShard, resource);
+        _shards.swap(freshShards);
+        _states.swap(freshStates);
+        _keys.assign(shards * _slotsPerShard, Key{});
+        _values.assign(shards * _slotsPerShard, Value{});
+    }
+
+    /**
+     * @brief Insert a key-value pair, replacing the value if the key is present. Locks the key's shard.
+     *
+     * @tparam Key
+     * @tparam Value
+     * @param key
+     * @param value
+     * @return true if the pair is in the table
+     * @return false if the key's shard is full
+     */
+    template<typename Key, typename Value>
+    bool ConcurrentOpenAddressingHashTable<Key, Value>::insert(const Key& key, const Value& value)
+    {
+        if (_shards.empty())
+            return false;
+
+        const Location location = locate(key);
+        Shard& shard = _shards[location.shard];
+        std::lock_guard<core::SpinLock> guard(shard.lock);
+
+        if (auto index = find(location, key))
+        {
+            beginWrite(shard);
+            storeValue(*index, value);
+            endWrite(shard);
+            return true;
+        }
+
+        const size_t size = shard.size.load(std::memory_order_relaxed);
+        if (size >= _slotsPerShard)
+            return false;
+
+        beginWrite(shard);
+        if (shard.tombstones > 0 && (shard.tombstones * 8 >= _slotsPerShard || size + shard.tombstones == _slotsPerShard))
+        {
+            rehashShard(location.shard);
+        }
+
+        const size_t base = location.shard * _slotsPerShard;
+        size_t index = location.home;
+        while (_states[base + index].load(std::memory_order_relaxed) == FULL)
+        {
+            index = (index + 1) & (_slotsPerShard - 1);
+        }
+
+        if (_states[base + index].load(std::memory_order_relaxed) == TOMBSTONE)
+        {
+            --shard.tombstones;
+        }
+
+        storeKey(base + index, key);
+        storeValue(base + index, value);
+        _states[base + index].store(FULL, std::memory_order_relaxed);
+        shard.size.store(size + 1, std::memory_order_relaxed);
+        endWrite(shard);
+        return true;
+    }
+
+    /**
+     * @brief Queries the table for the value associated with a key. Lock-free for
+     * trivially copyable keys and values, retrying only if a writer modified the shard.
+     *
+     * @tparam Key
+     * @tparam Value
+     * @param key
+     * @return std::optional<Value>
+     */
+    template<typename Key, typename Value>
+    std::optional<Value> ConcurrentOpenAddressingHashTable<Key, Value>::query(const Key& key) const
+    {
+        if (_shards.empty())
+            return std::nullopt;
+
+        const Location location = locate(key);
+        if constexpr (OPTIMISTIC_READS)
+        {
+            return optimisticQuery(location, key);
+        }
+        else
+        {
+            return lockedQuery(location, key);
+        }
+    }
+
+    /**
+     * @brief Checks if the table contains a key
+     *
+     * @tparam Key
+     * @tparam Value
+     * @param key
+     * @return true
+     * @return false
+     */
+    template<typename Key, typename Value>
+    bool ConcurrentOpenAddressingHashTable<Key, Value>::contains(const Key& key) const
+    {
+        return query(key).has_value();
+    }
+
+    /**
+     * @brief Erases a key-value pair, leaving a tombstone. Locks the key's shard.
+     *
+     * @tparam Key
+     * @tparam Value
+     * @param key
+     * @return true if the key was present
+     * @return false
+     */
+    template<typename Key, typename Value>
+    bool ConcurrentOpenAddressingHashTable<Key, Value>::erase(const Key& key)
+    {
+        if (_shards.empty())
+            return false;
+
+        const Location location = locate(key);
+        Shard& shard = _shards[location.shard];
+        std::lock_guard<core::SpinLock> guard(shard.lock);
+
+        auto index = find(location, key);
+        if (!index.has_value())
+            return false;
+
+        beginWrite(shard);
+        _states[*index].store(TOMBSTONE, std::memory_order_relaxed);
+        storeKey(*index, Key{});
+        storeValue(*index, Value{});
+        shard.size.store(shard.size.load(std::memory_order_relaxed) - 1, std::memory_order_relaxed);
+        ++shard.tombstones;
+        endWrite(shard);
+        return true;
+    }
+
+    /**
+     * @brief Gets the load factor of the table as a percentage
+     *
+     * @tparam Key
+     * @tparam Value
+     * @return int32_t
+     */
+    template<typename Key, typename Value>
+    int32_t ConcurrentOpenAddressingHashTable<Key, Value>::getLoadFactor() const
+    {
+        return _states.empty() ? 0 : static_cast<int32_t>(static_cast<size_t>(getSize()) * 100 / _states.size());
+    }
+
+    /**
+     * @brief Gets the number of entries, summed over the shards without locking
+     *
+     * @tparam Key
+     * @tparam Value
+     * @return int32_t
+     */
+    template<typename Key, typename Value>
+    int32_t ConcurrentOpenAddressingHashTable<Key, Value>::getSize() const
+    {
+        size_t size = 0;
+        for (const auto& shard : _shards)
+        {
+            size += shard.size.load(std::memory_order_relaxed);
+        }
+        return static_cast<int32_t>(size);
+    }
+
+    /**
+     * @brief Checks if the table is empty
+     *
+     * @tparam Key
+     * @tparam Value
+     * @return true
+     * @return false
+     */
+    template<typename Key, typename Value>
+    bool ConcurrentOpenAddressingHashTable<Key, Value>::isEmpty() const
+    {
+        return getSize() == 0;
+    }
+
+    /**
+     * @brief Shard from the high bits of the hash, home slot from the low bits
+     *
+     * @tparam Key
+     * @tparam Value
+     * @param key
+     * @return Location
+     */
+    template<typename Key, typename Value>
+    typename ConcurrentOpenAddressingHashTable<Key, Value>::Location
+    ConcurrentOpenAddressingHashTable<Key, Value>::locate(const Key& key) const
+    {
+        const uint64_t h = core::mixedHash(key);
+        const size_t shard = _shardBits == 0 ? 0 : static_cast<size_t>(h >> (64 - _shardBits));
+        return {shard, static_cast<size_t>(h) & (_slotsPerShard - 1)};
+    }
+
+    /**
+     * @brief Linear probe within the key's shard. The caller holds the shard's lock or
+     * validates the result against the shard's sequence counter.
+     *
+     * @tparam Key
+     * @tparam Value
+     * @param location
+     * @param key
+     * @return std::optional<size_t> Index of the slot holding the key
+     */
+    template<typename Key, typename Value>
+    std::optional<size_t> ConcurrentOpenAddressingHashTable<Key, Value>::find(const Location& location, const Key& key) const
+    {
+        const size_t base = location.shard * _slotsPerShard;
+        size_t index = location.home;
+        for (size_t probes = 0; probes < _slotsPerShard; ++probes)
+        {
+            const uint8_t state = _states[base + index].load(std::memory_order_relaxed);
+            if (state == EMPTY)
+                break;
+
+            if (state == FULL && keyMatches(base + index, key))
+                return base + index;
+
+            index = (index + 1) & (_slotsPerShard - 1);
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Query under the shard's spinlock, for keys or values that cannot be copied
+     * while a writer might be modifying them
+     *
+     * @tparam Key
+     * @tparam Value
+     * @param location
+     * @param key
+     * @return std::optional<Value>
+     */
+    template<typename Key, typename Value>
+    std::optional<Value> ConcurrentOpenAddressingHashTable<Key, Value>::lockedQuery(const Location& location, const Key& key) const
+    {
+        const Shard& shard = _shards[location.shard];
+        std::lock_guard<core::SpinLock> guard(shard.lock);
+        if (auto index = find(location, key))
+            return valueAt(*index);
+
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Seqlock read: probe without locking, then retry if the shard's sequence counter
+     * shows a writer was active or finished in the meantime
+     *
+     * @tparam Key
+     * @tparam Value
+     * @param location
+     * @param key
+     * @return std::optional<Value>
+     */
+    template<typename Key, typename Value>
+    std::optional<Value> ConcurrentOpenAddressingHashTable<Key, Value>::optimisticQuery(const Location& location, const Key& key) const
+    {
+        const Shard& shard = _shards[location.shard];
+        while (true)
+        {
+            const uint64_t before = shard.sequence.load(std::memory_order_acquire);
+            if (before & 1)
+            {
+                core::cpuRelax();
+                continue;
+            }
+
+            std::optional<Value> result;
+            if (auto index = find(location, key))
+            {
+                result = valueAt(*index);
+            }
+
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (shard.sequence.load(std::memory_order_relaxed) == before)
+                return result;
+        }
+    }
+
+    /**
+     * @brief Whether the slot holds the key. Inside find, so it may run concurrently with a
+     * writer when reads are optimistic.
+     *
+     * @tparam Key
+     * @tparam Value
+     * @param index
+     * @param key
+     * @return true
+     * @return false
+     */
+    template<typename Key, typename Value>
+    bool ConcurrentOpenAddressingHashTable<Key, Value>::keyMatches(size_t index, const Key& key) const
+    {
+        if constexpr (OPTIMISTIC_READS)
+        {
+            return _keys.load(index) == key;
+        }
+        else
+        {
+            return _keys[index] == key;
+        }
+    }
+
+    template<typename Key, typename Value>
+    Value ConcurrentOpenAddressingHashTable<Key, Value>::valueAt(size_t index) const
+    {
+        if constexpr (OPTIMISTIC_READS)
+        {
+            return _values.load(index);
+        }
+        else
+        {
+            return _values[index];
+        }
+    }
+
+    template<typename Key, typename Value>
+    void ConcurrentOpenAddressingHashTable<Key, Value>::storeKey(size_t index, Key key)
+    {
+        if constexpr (OPTIMISTIC_READS)
+        {
+            _keys.store(index, key);
+        }
+        else
+        {
+            _keys[index] = std::move(key);
+        }
+    }
+
+    template<typename Key, typename Value>
+    void ConcurrentOpenAddressingHashTable<Key, Value>::storeValue(size_t index, Value value)
+    {
+        if constexpr (OPTIMISTIC_READS)
+        {
+            _values.store(index, value);
+        }
+        else
+        {
+            _values[index] = std::move(value);
+        }
+    }
+
+    /**
+     * @brief Makes the shard's sequence counter odd before its slots are modified
+     *
+     * @tparam Key
+     * @tparam Value
+     * @param shard
+     */
+    template<typename Key, typename Value>
+    void ConcurrentOpenAddressingHashTable<Key, Value>::beginWrite(Shard& shard)
+    {
+        shard.sequence.store(shard.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    /**
+     * @brief Makes the shard's sequence counter even again, publishing the modification
+     *
+     * @tparam Key
+     * @tparam Value
+     * @param shard
+     */
+    template<typename Key, typename Value>
+    void ConcurrentOpenAddressingHashTable<Key, Value>::endWrite(Shard& shard)
+    {
+        shard.sequence.store(shard.sequence.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Rebuilds a shard in place to drop its tombstones. Called inside a write section.
+     *
+     * @tparam Key
+     * @tparam Value
+     * @param shard
+     */
+    template<typename Key, typename Value>
+    void ConcurrentOpenAddressingHashTable<Key, Value>::rehashShard(size_t shard)
+    {
+        const size_t base = shard * _slotsPerShard;
+        std::vector<std::pair<Key, Value>> entries;
+        entries.reserve(_shards[shard].size.load(std::memory_order_relaxed));
+        for (size_t i = base; i < base + _slotsPerShard; ++i)
+        {
+            if (_states[i].load(std::memory_order_relaxed) == FULL)
+            {
+                if constexpr (OPTIMISTIC_READS)
+                {
+                    entries.emplace_back(_keys.load(i), _values.load(i));
+                }
+                else
+                {
+                    entries.emplace_back(std::move(_keys[i]), std::move(_values[i]));
+                }
+            }
+            _states[i].store(EMPTY, std::memory_order_relaxed);
+            storeKey(i, Key{});
+            storeValue(i, Value{});
+        }
+
+        for (auto& [key, value] : entries)
+        {
+            size_t index = locate(key).home;
+            while (_states[base + index].load(std::memory_order_relaxed) != EMPTY)
+            {
+                index = (index + 1) & (_slotsPerShard - 1);
+            }
+            storeKey(base + index, std::move(key));
+            storeValue(base + index, std::move(value));
+            _states[base + index].store(FULL, std::memory_order_relaxed);
+        }
+        _shards[shard].tombstones = 0;
+    }
+}
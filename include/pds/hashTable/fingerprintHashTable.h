@@ -0,0 +1,81 @@
+#pragma once
+
+#include <vector>
+#include <optional>
+#include <utility>
+#include <memory_resource>
+#include <type_traits>
+
+#include "pds/core/common.h"
+#include "pds/core/hash.h"
+#include "fingerprintHashTableVisualiser.h"
+
+namespace pds::hashTable
+{
+    /**
+     * @brief Open addressing hash table with a structure-of-arrays layout: a dense array of
+     * 8 or 16 bit fingerprints, one per slot, and separate key and value arrays. Probing
+     * compares fingerprints only and touches a key when its fingerprint matches, so a miss
+     * rarely dereferences a key. Keys are stored by value in their own array, so short
+     * std::string keys stay inline through the small string optimisation.
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Fingerprint uint8_t or uint16_t
+     */
+    template<typename Key, typename Value, typename Fingerprint = uint8_t>
+    class FingerprintHashTable
+    {
+        static_assert(std::is_same_v<Fingerprint, uint8_t> || std::is_same_v<Fingerprint, uint16_t>,
+                      "Fingerprints are 8 or 16 bits wide");
+
+        friend class FingerprintHashTableVisualiser<Key, Value, Fingerprint>;
+
+        public:
+        explicit FingerprintHashTable(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+        void init(size_t capacity);
+        bool insert(const Key& key, const Value& value);
+        template <typename K, typename... Args>
+        bool tryEmplace(K&& key, Args&&... args);
+
+        std::optional<Value> query(const Key& key) const;
+        template <typename K, typename = std::enable_if_t<core::isTransparentKey<Key, K>>>
+        std::optional<Value> query(const K& key) const;
+
+        bool contains(const Key& key) const;
+        template <typename K, typename = std::enable_if_t<core::isTransparentKey<Key, K>>>
+        bool contains(const K& key) const;
+
+        void erase(const Key& key);
+        void clear();
+
+        int32_t getLoadFactor() const;
+        int32_t getSize() const;
+        bool isEmpty() const;
+
+    private:
+        static constexpr Fingerprint EMPTY = 0;
+        static constexpr Fingerprint TOMBSTONE = 1;
+
+        template <typename K>
+        std::optional<size_t> lookup(const K& key) const;
+        template <typename K>
+        std::pair<size_t, bool> findSlot(const K& key) const;
+        void rehash();
+
+        template <typename K>
+        uint64_t hash(const K& key) const;
+        Fingerprint fingerprintOf(uint64_t hash) const;
+
+        size_t _capacity; // Power of two
+        size_t _mask;
+        size_t _size;
+        size_t _tombstones;
+        std::pmr::vector<Fingerprint> _fingerprints;
+        std::pmr::vector<Key> _keys;
+        std::pmr::vector<Value> _values;
+        FingerprintHashTableVisualiser<Key, Value, Fingerprint> _visualiser;
+    };
+}
+
+#include "fingerprintHashTableImpl.h"
@@ -0,0 +1,450 @@
+#pragma once
+
+namespace pds::hashTable
+{
+    /**
+     * @brief Construct a new Fingerprint Hash Table< Key, Value, Fingerprint>:: Fingerprint Hash Table object
+     * with all three arrays drawn from the given memory resource
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Fingerprint
+     * @param resource
+     */
+    template<typename Key, typename Value, typename Fingerprint>
+    FingerprintHashTable<Key, Value, Fingerprint>::FingerprintHashTable(std::pmr::memory_resource* resource)
+        : _capacity(0), _mask(0), _size(0), _tombstones(0),
+          _fingerprints(resource), _keys(resource), _values(resource) {}
+
+    /**
+     * @brief Initialise the hash table with at least the given capacity, rounded up to a power of two
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Fingerprint
+     * @param capacity
+     */
+    template<typename Key, typename Value, typename Fingerprint>
+    void FingerprintHashTable<Key, Value, Fingerprint>::init(size_t capacity)
+    {
+        _capacity = 1;
+        while (_capacity < capacity)
+        {
+            _capacity <<= 1;
+        }
+        _mask = _capacity - 1;
+        _size = 0;
+        _tombstones = 0;
+        _fingerprints.assign(_capacity, EMPTY);
+        _keys.assign(_capacity, Key{});
+        _values.assign(_capacity, Value{});
+
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("Initialized table with " + std::to_string(_capacity) + " slots");
+            _visualiser.log(*this, std::nullopt, VisualContext::INIT);
+        }
+    }
+
+    /**
+     * @brief Insert a key-value pair, replacing the value if the key is present
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Fingerprint
+     * @param key
+     * @param value
+     * @return true if the pair is in the table
+     * @return false if the table is full
+     */
+    template<typename Key, typename Value, typename Fingerprint>
+    bool FingerprintHashTable<Key, Value, Fingerprint>::insert(const Key& key, const Value& value)
+    {
+        if (auto index = lookup(key))
+        {
+            _values[*index] = value;
+            return true;
+        }
+        return tryEmplace(key, value);
+    }
+
+    /**
+     * @brief Inserts a key-value pair unless the key is already present, moving the key
+     * and constructing the value from args
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Fingerprint
+     * @tparam K
+     * @tparam Args
+     * @param key
+     * @param args
+     * @return true if the pair was inserted
+     * @return false if the key was present or the table is full
+     */
+    template<typename Key, typename Value, typename Fingerprint>
+    template<typename K, typename... Args>
+    bool FingerprintHashTable<Key, Value, Fingerprint>::tryEmplace(K&& key, Args&&... args)
+    {
+        if (_size == _capacity)
+            return false;
+
+        // Drop tombstones once they make up an eighth of the table, or when they have
+        // taken the last empty slot and misses would probe the whole table
+        if (_tombstones > 0 && (_tombstones * 8 >= _capacity || _size + _tombstones == _capacity))
+        {
+            rehash();
+        }
+
+        auto [index, found] = findSlot(key);
+        if (found)
+            return false;
+
+        if (_fingerprints[index] == TOMBSTONE)
+        {
+            --_tombstones;
+        }
+
+        _fingerprints[index] = fingerprintOf(hash(key));
+        _keys[index] = std::forward<K>(key);
+        _values[index] = Value(std::forward<Args>(args)...);
+        ++_size;
+
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("Inserted key: " + toDisplayString(_keys[index]));
+            _visualiser.log(*this, index, VisualContext::INSERT);
+        }
+        return true;
+    }
+
+    /**
+     * @brief Queries the hash table for a value associated with a key
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Fingerprint
+     * @param key
+     * @return std::optional<Value>
+     */
+    template<typename Key, typename Value, typename Fingerprint>
+    std::optional<Value> FingerprintHashTable<Key, Value, Fingerprint>::query(const Key& key) const
+    {
+        const auto index = lookup(key);
+        if (!index.has_value())
+            return std::nullopt;
+
+        return _values[*index];
+    }
+
+    /**
+     * @brief Queries the hash table with a key that compares equal to Key without being one
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Fingerprint
+     * @tparam K
+     * @param key
+     * @return std::optional<Value>
+     */
+    template<typename Key, typename Value, typename Fingerprint>
+    template<typename K, typename>
+    std::optional<Value> FingerprintHashTable<Key, Value, Fingerprint>::query(const K& key) const
+    {
+        const auto index = lookup(key);
+        if (!index.has_value())
+            return std::nullopt;
+
+        return _values[*index];
+    }
+
+    /**
+     * @brief Checks if the hash table contains a key, without copying its value
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Fingerprint
+     * @param key
+     * @return true
+     * @return false
+     */
+    template<typename Key, typename Value, typename Fingerprint>
+    bool FingerprintHashTable<Key, Value, Fingerprint>::contains(const Key& key) const
+    {
+        return lookup(key).has_value();
+    }
+
+    /**
+     * @brief Checks if the hash table contains a key given as a transparent key type
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Fingerprint
+     * @tparam K
+     * @param key
+     * @return true
+     * @return false
+     */
+    template<typename Key, typename Value, typename Fingerprint>
+    template<typename K, typename>
+    bool FingerprintHashTable<Key, Value, Fingerprint>::contains(const K& key) const
+    {
+        return lookup(key).has_value();
+    }
+
+    /**
+     * @brief Erases a key-value pair, leaving a tombstone so that later probes continue past it
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Fingerprint
+     * @param key
+     */
+    template<typename Key, typename Value, typename Fingerprint>
+    void FingerprintHashTable<Key, Value, Fingerprint>::erase(const Key& key)
+    {
+        const auto index = lookup(key);
+        if (!index.has_value())
+        {
+            if constexpr (VISUALISE)
+            {
+                _visualiser.logAction("Erase failed: key not found - " + toDisplayString(key));
+            }
+            return;
+        }
+
+        _fingerprints[*index] = TOMBSTONE;
+        _keys[*index] = Key{};
+        _values[*index] = Value{};
+        --_size;
+        ++_tombstones;
+
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("Erased key: " + toDisplayString(key));
+            _visualiser.log(*this, *index, VisualContext::ERASE);
+        }
+    }
+
+    /**
+     * @brief Clears the hash table
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Fingerprint
+     */
+    template<typename Key, typename Value, typename Fingerprint>
+    void FingerprintHashTable<Key, Value, Fingerprint>::clear()
+    {
+        _fingerprints.assign(_capacity, EMPTY);
+        _keys.assign(_capacity, Key{});
+        _values.assign(_capacity, Value{});
+        _size = 0;
+        _tombstones = 0;
+
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("Cleared table");
+        }
+    }
+
+    /**
+     * @brief Gets the load factor of the hash table as a percentage
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Fingerprint
+     * @return int32_t
+     */
+    template<typename Key, typename Value, typename Fingerprint>
+    int32_t FingerprintHashTable<Key, Value, Fingerprint>::getLoadFactor() const
+    {
+        return _capacity == 0 ? 0 : static_cast<int32_t>(_size * 100 / _capacity);
+    }
+
+    /**
+     * @brief Gets the current size of the hash table
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Fingerprint
+     * @return int32_t
+     */
+    template<typename Key, typename Value, typename Fingerprint>
+    int32_t FingerprintHashTable<Key, Value, Fingerprint>::getSize() const
+    {
+        return static_cast<int32_t>(_size);
+    }
+
+    /**
+     * @brief Checks if the hash table is empty
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Fingerprint
+     * @return true
+     * @return false
+     */
+    template<typename Key, typename Value, typename Fingerprint>
+    bool FingerprintHashTable<Key, Value, Fingerprint>::isEmpty() const
+    {
+        return _size == 0;
+    }
+
+    /**
+     * @brief Finds the slot holding a key. The loop only reads the fingerprint array until
+     * a fingerprint matches, and stops at the first empty slot.
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Fingerprint
+     * @tparam K
+     * @param key
+     * @return std::optional<size_t>
+     */
+    template<typename Key, typename Value, typename Fingerprint>
+    template<typename K>
+    std::optional<size_t> FingerprintHashTable<Key, Value, Fingerprint>::lookup(const K& key) const
+    {
+        if (_capacity == 0)
+            return std::nullopt;
+
+        const uint64_t h = hash(key);
+        const Fingerprint fingerprint = fingerprintOf(h);
+        size_t index = h & _mask;
+        for (size_t probes = 0; probes < _capacity; ++probes)
+        {
+            const Fingerprint slot = _fingerprints[index];
+            if (slot == EMPTY)
+                break;
+
+            if (slot == fingerprint && _keys[index] == key)
+            {
+                if constexpr (VISUALISE)
+                {
+                    _visualiser.logAction("Query hit for key: " + toDisplayString(key));
+                    _visualiser.log(*this, index, VisualContext::QUERY);
+                }
+                return index;
+            }
+            index = (index + 1) & _mask;
+        }
+
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("Query miss for key: " + toDisplayString(key));
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Finds the slot holding a key, or the first free slot (tombstone or empty)
+     * on its probe sequence if it is absent
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Fingerprint
+     * @tparam K
+     * @param key
+     * @return std::pair<size_t, bool> Slot index and whether the key was found there
+     */
+    template<typename Key, typename Value, typename Fingerprint>
+    template<typename K>
+    std::pair<size_t, bool> FingerprintHashTable<Key, Value, Fingerprint>::findSlot(const K& key) const
+    {
+        const uint64_t h = hash(key);
+        const Fingerprint fingerprint = fingerprintOf(h);
+        size_t index = h & _mask;
+        std::optional<size_t> firstFree;
+        for (size_t probes = 0; probes < _capacity; ++probes)
+        {
+            const Fingerprint slot = _fingerprints[index];
+            if (slot == EMPTY)
+                return {firstFree.value_or(index), false};
+
+            if (slot == TOMBSTONE)
+            {
+                if (!firstFree.has_value())
+                    firstFree = index;
+            }
+            else if (slot == fingerprint && _keys[index] == key)
+            {
+                return {index, true};
+            }
+            index = (index + 1) & _mask;
+        }
+        return {firstFree.value_or(index), false};
+    }
+
+    /**
+     * @brief Rebuilds the table in place to drop tombstones
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Fingerprint
+     */
+    template<typename Key, typename Value, typename Fingerprint>
+    void FingerprintHashTable<Key, Value, Fingerprint>::rehash()
+    {
+        auto* resource = _fingerprints.get_allocator().resource();
+        std::pmr::vector<Fingerprint> fingerprints(_capacity, EMPTY, resource);
+        std::pmr::vector<Key> keys(_capacity, Key{}, resource);
+        std::pmr::vector<Value> values(_capacity, Value{}, resource);
+
+        for (size_t i = 0; i < _capacity; ++i)
+        {
+            if (_fingerprints[i] == EMPTY || _fingerprints[i] == TOMBSTONE)
+                continue;
+
+            size_t index = hash(_keys[i]) & _mask;
+            while (fingerprints[index] != EMPTY)
+            {
+                index = (index + 1) & _mask;
+            }
+            fingerprints[index] = _fingerprints[i];
+            keys[index] = std::move(_keys[i]);
+            values[index] = std::move(_values[i]);
+        }
+
+        _fingerprints = std::move(fingerprints);
+        _keys = std::move(keys);
+        _values = std::move(values);
+        _tombstones = 0;
+    }
+
+    /**
+     * @brief Hash function for the key, mixed so that both the low bits (slot) and the
+     * high bits (fingerprint) are well distributed. Keys given in another type, such as
+     * character pointers, hash as the Key they convert to.
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Fingerprint
+     * @tparam K
+     * @param key
+     * @return uint64_t
+     */
+    template<typename Key, typename Value, typename Fingerprint>
+    template<typename K>
+    uint64_t FingerprintHashTable<Key, Value, Fingerprint>::hash(const K& key) const
+    {
+        return core::mix64(static_cast<uint64_t>(core::keyHash<Key>(key)));
+    }
+
+    /**
+     * @brief Fingerprint of a hash, taken from its high bits and kept clear of the
+     * EMPTY and TOMBSTONE markers
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Fingerprint
+     * @param hash
+     * @return Fingerprint
+     */
+    template<typename Key, typename Value, typename Fingerprint>
+    Fingerprint FingerprintHashTable<Key, Value, Fingerprint>::fingerprintOf(uint64_t hash) const
+    {
+        const Fingerprint fingerprint = static_cast<Fingerprint>(hash >> (64 - 8 * sizeof(Fingerprint)));
+        return fingerprint <= TOMBSTONE ? static_cast<Fingerprint>(fingerprint + 2) : fingerprint;
+    }
+}
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <iostream>
+#include <optional>
+#include <iomanip>
+
+#include "pds/core/common.h"
+
+namespace pds::hashTable
+{
+    template<typename Key, typename Value, typename Fingerprint>
+    class FingerprintHashTable; // Forward declaration
+
+    template<typename Key, typename Value, typename Fingerprint>
+    class FingerprintHashTableVisualiser {
+    public:
+
+        /**
+         * @brief Logs the fingerprint array and the occupied slots of the hash table
+         *
+         * @param table The hash table to log
+         * @param highlight Optional slot to highlight
+         * @param ctx Context of the operation (INIT, INSERT, QUERY, ERASE)
+         */
+        void log(const FingerprintHashTable<Key, Value, Fingerprint>& table,
+             std::optional<size_t> highlight = std::nullopt,
+             pds::VisualContext ctx = pds::VisualContext::UNKNOWN) const
+        {
+            constexpr size_t rowSize = 32;
+            std::cout << "\nFingerprint Array State:\n\n";
+
+            for (size_t i = 0; i < table._capacity; ++i) {
+                const Fingerprint fingerprint = table._fingerprints[i];
+
+                if (highlight.has_value() && highlight.value() == i)
+                {
+                    if (ctx == pds::VisualContext::INSERT) std::cout << "\033[44m"; // Blue background
+                    else if (ctx == pds::VisualContext::QUERY) std::cout << "\033[43m"; // Yellow background
+                    else std::cout << "\033[47m"; // Default white
+                }
+                else if (fingerprint == table.TOMBSTONE)
+                {
+                    std::cout << "\033[45m"; // Magenta background
+                }
+                else
+                {
+                    std::cout << (fingerprint != table.EMPTY ? "\033[42m" : "\033[41m"); // Green or Red background
+                }
+
+                std::cout << "  "; // 2 space block to appear square-like
+                std::cout << "\033[0m"; // Reset
+
+                if ((i + 1) % rowSize == 0)
+                {
+                    std::cout << "  <- [" << std::setw(3) << (i - rowSize + 1)
+                        << " - " << std::setw(3) << i << "]\n";
+                }
+            }
+
+            if (table._capacity % rowSize != 0)
+            {
+                std::cout << "  <- [" << table._capacity - (table._capacity % rowSize)
+                        << " - " << table._capacity - 1 << "]\n";
+            }
+
+            std::cout << "\nHash Table Contents:\n\n";
+            std::cout << std::left
+                      << std::setw(12) << "Slot" << " | "
+                      << std::setw(12) << "Fingerprint" << " | "
+                      << std::setw(20) << "Key" << " | "
+                      << std::setw(20) << "Value"
+                      << "\n";
+
+            std::cout << std::string(12, '-') << "-+-"
+                      << std::string(12, '-') << "-+-"
+                      << std::string(20, '-') << "-+-"
+                      << std::string(20, '-') << "\n";
+
+            for (size_t i = 0; i < table._capacity; ++i)
+            {
+                const Fingerprint fingerprint = table._fingerprints[i];
+                if (fingerprint != table.EMPTY && fingerprint != table.TOMBSTONE)
+                {
+                    std::cout << std::left
+                              << std::setw(12) << i << " | "
+                              << std::setw(12) << static_cast<uint32_t>(fingerprint) << " | "
+                              << std::setw(20) << toDisplayString(table._keys[i]) << " | "
+                              << std::setw(20) << toDisplayString(table._values[i])
+                              << "\n";
+                }
+            }
+            std::cout << std::right << "\n";
+        }
+
+        /**
+         * @brief Logs the string describing an action taken on the hash table
+         *
+         * @param action
+         */
+        void logAction(const std::string& action) const
+        {
+            std::cout << "[LOG] " << action << "\n";
+        }
+    };
+}
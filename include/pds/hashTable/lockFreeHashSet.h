@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+#include <memory_resource>
+#include <type_traits>
+
+#include "pds/core/common.h"
+#include "pds/core/concurrency.h"
+#include "pds/core/hash.h"
+
+namespace pds::hashTable
+{
+    /**
+     * @brief Lock-free linear probing hash set for trivially copyable 64-bit keys, such as
+     * integer IDs in a dedupe stage. Inserts claim an empty slot with a CAS on the key
+     * word and lookups are wait-free. Keys are never erased, so a filled slot never changes.
+     *
+     * When the table passes 3/4 load a table of twice the size is linked after it and every
+     * thread that inserts helps migrate chunks of slots, sealing each empty slot with a MOVED
+     * marker so later inserts and lookups continue into the new table. Retired tables stay
+     * allocated until the set is re-initialised or destroyed, since a reader may still be
+     * probing them; their total size is bounded by that of the live table.
+     *
+     * @tparam Key
+     */
+    template<typename Key = uint64_t>
+    class LockFreeHashSet
+    {
+        static_assert(std::is_trivially_copyable_v<Key> && sizeof(Key) == sizeof(uint64_t),
+                      "LockFreeHashSet keys must be trivially copyable 64-bit values");
+
+        public:
+        explicit LockFreeHashSet(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+        ~LockFreeHashSet();
+
+        LockFreeHashSet(const LockFreeHashSet&) = delete;
+        LockFreeHashSet& operator=(const LockFreeHashSet&) = delete;
+
+        void init(size_t capacity);
+
+        bool insert(const Key& key);
+        bool contains(const Key& key) const;
+
+        size_t getCapacity() const;
+        int32_t getSize() const;
+        bool isEmpty() const;
+
+    private:
+        // Slot words reserved as markers; keys with these bit patterns are tracked by flags instead
+        static constexpr uint64_t EMPTY = 0;
+        static constexpr uint64_t MOVED = ~uint64_t{0};
+        static constexpr size_t MIGRATION_CHUNK = 1024;
+
+        struct Table
+        {
+            Table(size_t capacity, std::pmr::memory_resource* resource);
+
+            size_t capacity; // Power of two
+            size_t numChunks;
+            std::pmr::vector<std::atomic<uint64_t>> slots;
+            std::atomic<Table*> next{nullptr};
+            alignas(core::CACHE_LINE_SIZE) std::atomic<size_t> used{0};
+            alignas(core::CACHE_LINE_SIZE) std::atomic<size_t> claimedChunks{0};
+            alignas(core::CACHE_LINE_SIZE) std::atomic<size_t> migratedChunks{0};
+        };
+
+        static uint64_t toWord(const Key& key);
+
+        bool insertWord(Table* table, uint64_t word);
+        Table* currentTable();
+        Table* startResize(Table* table);
+        void helpMigrate(Table* table);
+        void destroyTables();
+
+        std::pmr::memory_resource* _resource;
+        Table* _root;
+        std::atomic<Table*> _current;
+        alignas(core::CACHE_LINE_SIZE) std::atomic<size_t> _size;
+        std::atomic<bool> _containsEmptyWord;
+        std::atomic<bool> _containsMovedWord;
+    };
+}
+
+#include "lockFreeHashSetImpl.h"
@@ -0,0 +1,350 @@
+#pragma once
+
+#include <algorithm>
+#include <memory>
+
+namespace pds::hashTable
+{
+    template<typename Key>
+    LockFreeHashSet<Key>::Table::Table(size_t capacity, std::pmr::memory_resource* resource)
+        : capacity(capacity), numChunks((capacity + MIGRATION_CHUNK - 1) / MIGRATION_CHUNK), slots(capacity, resource) {}
+
+    /**
+     * @brief Construct a new Lock Free Hash Set< Key>:: Lock Free Hash Set object
+     * with its tables drawn from the given memory resource
+     *
+     * @tparam Key
+     * @param resource
+     */
+    template<typename Key>
+    LockFreeHashSet<Key>::LockFreeHashSet(std::pmr::memory_resource* resource)
+        : _resource(resource), _root(nullptr), _current(nullptr), _size(0),
+          _containsEmptyWord(false), _containsMovedWord(false) {}
+
+    /**
+     * @brief Destroy the Lock Free Hash Set< Key>:: Lock Free Hash Set object and every table it has grown through
+     *
+     * @tparam Key
+     */
+    template<typename Key>
+    LockFreeHashSet<Key>::~LockFreeHashSet()
+    {
+        destroyTables();
+    }
+
+    /**
+     * @brief Initialise an empty set with at least the given capacity, rounded up to a power of two.
+     * Not thread-safe.
+     *
+     * @tparam Key
+     * @param capacity
+     */
+    template<typename Key>
+    void LockFreeHashSet<Key>::init(size_t capacity)
+    {
+        destroyTables();
+
+        size_t tableCapacity = 8;
+        while (tableCapacity < capacity)
+        {
+            tableCapacity <<= 1;
+        }
+
+        std::pmr::polymorphic_allocator<Table> allocator(_resource);
+        _root = allocator.allocate(1);
+        allocator.construct(_root, tableCapacity, _resource);
+        _current.store(_root, std::memory_order_release);
+        _size.store(0, std::memory_order_relaxed);
+        _containsEmptyWord.store(false, std::memory_order_relaxed);
+        _containsMovedWord.store(false, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Inserts a key, helping any migration in progress first. Lock-free.
+     *
+     * @tparam Key
+     * @param key
+     * @return true if this call added the key
+     * @return false if the key was already present
+     */
+    template<typename Key>
+    bool LockFreeHashSet<Key>::insert(const Key& key)
+    {
+        const uint64_t word = toWord(key);
+        bool inserted;
+        if (word == EMPTY)
+        {
+            inserted = !_containsEmptyWord.exchange(true, std::memory_order_acq_rel);
+        }
+        else if (word == MOVED)
+        {
+            inserted = !_containsMovedWord.exchange(true, std::memory_order_acq_rel);
+        }
+        else
+        {
+            Table* table = currentTable();
+            if (table->next.load(std::memory_order_acquire) != nullptr)
+            {
+                helpMigrate(table);
+            }
+            inserted = insertWord(table, word);
+        }
+
+        if (inserted)
+        {
+            _size.fetch_add(1, std::memory_order_relaxed);
+        }
+        return inserted;
+    }
+
+    /**
+     * @brief Checks if the set contains a key. Wait-free: probes at most every table still linked.
+     *
+     * @tparam Key
+     * @param key
+     * @return true
+     * @return false
+     */
+    template<typename Key>
+    bool LockFreeHashSet<Key>::contains(const Key& key) const
+    {
+        const uint64_t word = toWord(key);
+        if (word == EMPTY)
+            return _containsEmptyWord.load(std::memory_order_acquire);
+
+        if (word == MOVED)
+            return _containsMovedWord.load(std::memory_order_acquire);
+
+        const uint64_t h = core::mix64(word);
+        for (Table* table = _current.load(std::memory_order_acquire); table != nullptr;)
+        {
+            const size_t mask = table->capacity - 1;
+            size_t index = h & mask;
+            size_t probes = 0;
+            for (; probes < table->capacity; ++probes)
+            {
+                const uint64_t slot = table->slots[index].load(std::memory_order_acquire);
+                if (slot == word)
+                    return true;
+
+                if (slot == EMPTY)
+                    return false;
+
+                if (slot == MOVED)
+                    break;
+
+                index = (index + 1) & mask;
+            }
+            table = table->next.load(std::memory_order_acquire);
+        }
+        return false;
+    }
+
+    /**
+     * @brief Gets the capacity of the newest table
+     *
+     * @tparam Key
+     * @return size_t
+     */
+    template<typename Key>
+    size_t LockFreeHashSet<Key>::getCapacity() const
+    {
+        Table* table = _current.load(std::memory_order_acquire);
+        if (table == nullptr)
+            return 0;
+
+        for (Table* next = table->next.load(std::memory_order_acquire); next != nullptr; next = next->next.load(std::memory_order_acquire))
+        {
+            table = next;
+        }
+        return table->capacity;
+    }
+
+    /**
+     * @brief Gets the number of keys inserted
+     *
+     * @tparam Key
+     * @return int32_t
+     */
+    template<typename Key>
+    int32_t LockFreeHashSet<Key>::getSize() const
+    {
+        return static_cast<int32_t>(_size.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Checks if the set is empty
+     *
+     * @tparam Key
+     * @return true
+     * @return false
+     */
+    template<typename Key>
+    bool LockFreeHashSet<Key>::isEmpty() const
+    {
+        return getSize() == 0;
+    }
+
+    template<typename Key>
+    uint64_t LockFreeHashSet<Key>::toWord(const Key& key)
+    {
+        uint64_t word;
+        std::memcpy(&word, &key, sizeof(word));
+        return word;
+    }
+
+    /**
+     * @brief Claims a slot for the word in the given table, following MOVED markers and full
+     * tables into their successors. Used both by inserts and by migration.
+     *
+     * @tparam Key
+     * @param table
+     * @param word
+     * @return true if the word was placed
+     * @return false if it was already present
+     */
+    template<typename Key>
+    bool LockFreeHashSet<Key>::insertWord(Table* table, uint64_t word)
+    {
+        const uint64_t h = core::mix64(word);
+        while (true)
+        {
+            const size_t mask = table->capacity - 1;
+            size_t index = h & mask;
+            size_t probes = 0;
+            while (probes < table->capacity)
+            {
+                uint64_t slot = table->slots[index].load(std::memory_order_acquire);
+                if (slot == word)
+                    return false;
+
+                if (slot == MOVED)
+                    break;
+
+                if (slot == EMPTY)
+                {
+                    if (table->slots[index].compare_exchange_strong(slot, word, std::memory_order_acq_rel, std::memory_order_acquire))
+                    {
+                        const size_t used = table->used.fetch_add(1, std::memory_order_relaxed) + 1;
+                        if (used * 4 > table->capacity * 3)
+                        {
+                            startResize(table);
+                        }
+                        return true;
+                    }
+
+                    // Lost the race for this slot; re-examine the word that won it
+                    continue;
+                }
+
+                index = (index + 1) & mask;
+                ++probes;
+            }
+
+            // Either the probe sequence reached a sealed slot or the whole table is full
+            Table* next = table->next.load(std::memory_order_acquire);
+            table = next != nullptr ? next : startResize(table);
+        }
+    }
+
+    /**
+     * @brief Returns the oldest table that is not yet fully migrated, advancing the shared
+     * pointer past any that are
+     *
+     * @tparam Key
+     * @return Table*
+     */
+    template<typename Key>
+    typename LockFreeHashSet<Key>::Table* LockFreeHashSet<Key>::currentTable()
+    {
+        Table* table = _current.load(std::memory_order_acquire);
+        while (table->migratedChunks.load(std::memory_order_acquire) == table->numChunks)
+        {
+            Table* next = table->next.load(std::memory_order_acquire);
+            if (_current.compare_exchange_strong(table, next, std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                table = next;
+            }
+        }
+        return table;
+    }
+
+    /**
+     * @brief Links a table of twice the capacity after the given one, unless another thread already has
+     *
+     * @tparam Key
+     * @param table
+     * @return Table* The successor
+     */
+    template<typename Key>
+    typename LockFreeHashSet<Key>::Table* LockFreeHashSet<Key>::startResize(Table* table)
+    {
+        Table* next = table->next.load(std::memory_order_acquire);
+        if (next != nullptr)
+            return next;
+
+        std::pmr::polymorphic_allocator<Table> allocator(_resource);
+        Table* grown = allocator.allocate(1);
+        allocator.construct(grown, table->capacity * 2, _resource);
+        if (table->next.compare_exchange_strong(next, grown, std::memory_order_acq_rel, std::memory_order_acquire))
+            return grown;
+
+        grown->~Table();
+        allocator.deallocate(grown, 1);
+        return next;
+    }
+
+    /**
+     * @brief Claims chunks of the table until none are left, copying keys into the successor and
+     * sealing empty slots. Keys stay in place, so lookups racing the migration still find them.
+     *
+     * @tparam Key
+     * @param table
+     */
+    template<typename Key>
+    void LockFreeHashSet<Key>::helpMigrate(Table* table)
+    {
+        Table* next = table->next.load(std::memory_order_acquire);
+        while (true)
+        {
+            const size_t chunk = table->claimedChunks.fetch_add(1, std::memory_order_relaxed);
+            if (chunk >= table->numChunks)
+                return;
+
+            const size_t end = std::min(table->capacity, (chunk + 1) * MIGRATION_CHUNK);
+            for (size_t i = chunk * MIGRATION_CHUNK; i < end; ++i)
+            {
+                uint64_t slot = table->slots[i].load(std::memory_order_acquire);
+                while (slot == EMPTY && !table->slots[i].compare_exchange_weak(slot, MOVED, std::memory_order_acq_rel, std::memory_order_acquire))
+                {
+                }
+
+                if (slot != EMPTY && slot != MOVED)
+                {
+                    insertWord(next, slot);
+                }
+            }
+
+            if (table->migratedChunks.fetch_add(1, std::memory_order_acq_rel) + 1 == table->numChunks)
+            {
+                Table* expected = table;
+                _current.compare_exchange_strong(expected, next, std::memory_order_acq_rel, std::memory_order_acquire);
+            }
+        }
+    }
+
+    template<typename Key>
+    void LockFreeHashSet<Key>::destroyTables()
+    {
+        std::pmr::polymorphic_allocator<Table> allocator(_resource);
+        for (Table* table = _root; table != nullptr;)
+        {
+            Table* next = table->next.load(std::memory_order_relaxed);
+            table->~Table();
+            allocator.deallocate(table, 1);
+            table = next;
+        }
+        _root = nullptr;
+        _current.store(nullptr, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+#include <optional>
+#include <utility>
+#include <memory_resource>
+#include <type_traits>
+
+#include "pds/core/common.h"
+#include "pds/core/hash.h"
+#include "openAddressingSlots.h"
+
+namespace pds::hashTable
+{
+    /**
+     * @brief Set counterpart of OpenAddressingHashTable: the same linear probing over a
+     * fixed capacity, with slots holding only keys, so membership checks touch no values and
+     * each slot costs sizeof(Key). Erasure shifts later keys back rather than leaving
+     * tombstones. Iteration walks the occupancy bits a word at a time.
+     *
+     * @tparam Key
+     */
+    template<typename Key>
+    class OpenAddressingHashSet : public OpenAddressingSlots<Key, Key>
+    {
+        using Base = OpenAddressingSlots<Key, Key>;
+
+        public:
+        explicit OpenAddressingHashSet(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+        void init(size_t capacity);
+        bool insert(const Key& key);
+
+        bool contains(const Key& key) const;
+        template <typename K, typename = std::enable_if_t<core::isTransparentKey<Key, K>>>
+        bool contains(const K& key) const;
+        template <typename K = Key, typename = std::enable_if_t<std::is_same_v<K, std::string>>>
+        bool contains(const char* data, size_t length) const;
+
+        const Key* find(const Key& key) const;
+        template <typename K, typename = std::enable_if_t<core::isTransparentKey<Key, K>>>
+        const Key* find(const K& key) const;
+
+        bool erase(const Key& key);
+        template <typename Pred>
+        size_t eraseIf(Pred&& pred);
+        void clear();
+
+    private:
+        using Base::lookup;
+        using Base::hash;
+        using Base::probe;
+        using Base::publishMetrics;
+        using Base::_capacity;
+        using Base::_size;
+        using Base::_table;
+        using Base::_bitArray;
+        using Base::_visualiser;
+        using Base::_metrics;
+    };
+}
+
+#include "openAddressingHashSetImpl.h"
@@ -0,0 +1,167 @@
+#pragma once
+
+namespace pds::hashTable
+{
+    /**
+     * @brief Construct a new Open Addressing Hash Set< Key>:: Open Addressing Hash Set object
+     * with the slots drawn from the given memory resource
+     * 
+     * @tparam Key 
+     * @param resource 
+     */
+    template<typename Key>
+    OpenAddressingHashSet<Key>::OpenAddressingHashSet(std::pmr::memory_resource* resource)
+        : Base("OpenAddressingHashSet", resource) {}
+
+    /**
+     * @brief Initialise the set with a given capacity
+     * 
+     * @tparam Key 
+     * @param capacity 
+     */
+    template<typename Key>
+    void OpenAddressingHashSet<Key>::init(size_t capacity)
+    {
+        Base::reset(capacity);
+    }
+
+    /**
+     * @brief Inserts a key unless it is already present
+     * 
+     * @tparam Key 
+     * @param key 
+     * @return true if the key was inserted
+     * @return false if the key was present or the set is full
+     */
+    template<typename Key>
+    bool OpenAddressingHashSet<Key>::insert(const Key& key)
+    {
+        if (_size == _capacity)
+            return false;
+
+        size_t index = hash(key);
+        size_t probes = 0;
+        while (_bitArray.test(index)) {
+            if (_table[index] == key) {
+                return false;
+            }
+            index = probe(index);
+            ++probes;
+        }
+
+        _table[index] = key;
+        _bitArray.set(index);
+        _size++;
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("Inserted key: " + toDisplayString(key));
+            _visualiser.log(*this, index, VisualContext::INSERT);
+        }
+        _metrics.recordProbeLength(probes);
+        _metrics.recordInsert();
+        publishMetrics();
+        return true;
+    }
+
+    template<typename Key>
+    bool OpenAddressingHashSet<Key>::contains(const Key& key) const
+    {
+        return lookup(key).has_value();
+    }
+
+    /**
+     * @brief Checks if the set contains a key given as a transparent key type, e.g. a
+     * std::string_view for a set of std::string
+     * 
+     * @tparam Key 
+     * @tparam K 
+     * @param key 
+     * @return true 
+     * @return false 
+     */
+    template<typename Key>
+    template<typename K, typename>
+    bool OpenAddressingHashSet<Key>::contains(const K& key) const
+    {
+        return lookup(key).has_value();
+    }
+
+    /**
+     * @brief Checks if a set of std::string contains the key held in a raw buffer
+     * 
+     * @tparam Key 
+     * @param data 
+     * @param length 
+     * @return true 
+     * @return false 
+     */
+    template<typename Key>
+    template<typename K, typename>
+    bool OpenAddressingHashSet<Key>::contains(const char* data, size_t length) const
+    {
+        return lookup(std::string_view(data, length)).has_value();
+    }
+
+    /**
+     * @brief Pointer to the stored key equal to the given one, valid until the next insert or erase
+     * 
+     * @tparam Key 
+     * @param key 
+     * @return const Key* nullptr if the key is absent
+     */
+    template<typename Key>
+    const Key* OpenAddressingHashSet<Key>::find(const Key& key) const
+    {
+        const auto index = lookup(key);
+        return index.has_value() ? &_table[*index] : nullptr;
+    }
+
+    template<typename Key>
+    template<typename K, typename>
+    const Key* OpenAddressingHashSet<Key>::find(const K& key) const
+    {
+        const auto index = lookup(key);
+        return index.has_value() ? &_table[*index] : nullptr;
+    }
+
+    /**
+     * @brief Erases a key from the set
+     * 
+     * @tparam Key 
+     * @param key 
+     * @return true if the key was present
+     * @return false 
+     */
+    template<typename Key>
+    bool OpenAddressingHashSet<Key>::erase(const Key& key)
+    {
+        return Base::eraseKey(key, [](size_t) {});
+    }
+
+    /**
+     * @brief Erases every key for which pred(key) is true, in one pass over the occupied
+     * slots, calling pred once per key
+     * 
+     * @tparam Key 
+     * @tparam Pred 
+     * @param pred 
+     * @return size_t Number of keys erased
+     */
+    template<typename Key>
+    template<typename Pred>
+    size_t OpenAddressingHashSet<Key>::eraseIf(Pred&& pred)
+    {
+        return Base::eraseMatching(pred, [](size_t) {});
+    }
+
+    /**
+     * @brief Clears the set
+     * 
+     * @tparam Key 
+     */
+    template<typename Key>
+    void OpenAddressingHashSet<Key>::clear()
+    {
+        Base::clearSlots();
+    }
+}
@@ -2,41 +2,78 @@
 
 #include <vector>
 #include <optional>
-#include <bitset>
 #include <utility>
+#include <memory_resource>
+#include <type_traits>
 
 #include "pds/core/common.h"
-#include "openAddressingHashTableVisualiser.h"
+#include "pds/core/checkpoint.h"
+#include "pds/core/hash.h"
+#include "openAddressingSlots.h"
 
 namespace pds::hashTable
 {
     template<typename Key, typename Value>
-    class OpenAddressingHashTable
+    class OpenAddressingHashTable : public OpenAddressingSlots<Key, std::pair<Key, Value>>
     {
-        friend class OpenAddressingHashTableVisualiser<Key, Value>;
+        using Base = OpenAddressingSlots<Key, std::pair<Key, Value>>;
 
         public:
-        OpenAddressingHashTable();
+        explicit OpenAddressingHashTable(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
         void init(size_t capacity);
-        void insert(const Key& key, const Value& value);
+        bool insert(const Key& key, const Value& value);
+        template <typename K, typename... Args>
+        bool tryEmplace(K&& key, Args&&... args);
+
         std::optional<Value> query(const Key& key) const;
+        template <typename K, typename = std::enable_if_t<core::isTransparentKey<Key, K>>>
+        std::optional<Value> query(const K& key) const;
+
         bool contains(const Key& key) const;
+        template <typename K, typename = std::enable_if_t<core::isTransparentKey<Key, K>>>
+        bool contains(const K& key) const;
+        template <typename K = Key, typename = std::enable_if_t<std::is_same_v<K, std::string>>>
+        bool contains(const char* data, size_t length) const;
+
+        const Value* find(const Key& key) const;
+        Value* find(const Key& key);
+        template <typename K, typename = std::enable_if_t<core::isTransparentKey<Key, K>>>
+        const Value* find(const K& key) const;
+        template <typename K, typename = std::enable_if_t<core::isTransparentKey<Key, K>>>
+        Value* find(const K& key);
+
         void erase(const Key& key);
+        template <typename Pred>
+        size_t eraseIf(Pred&& pred);
         void clear();
 
-        int32_t getLoadFactor() const;
-        int32_t getSize() const;
-        bool isEmpty() const;
+        bool checkpoint(std::ostream& out);
+        bool checkpointDelta(std::ostream& out);
+        bool restore(std::istream& in);
+        size_t getDirtyPages() const;
 
     private:
-        size_t hash(const Key& key) const;
-        size_t probe(size_t index) const;
-
-        size_t _capacity;
-        size_t _size;
-        std::vector<std::pair<Key, Value>>* _table;
-        std::bitset<BIT_ARRAY_SIZE>* _bitArray;
-        OpenAddressingHashTableVisualiser<Key, Value> _visualiser;
+        static constexpr uint64_t CHECKPOINT_TAG = 0x313054414f534450; // "PDSOAT01"
+        // Slots are saved as raw pages, which needs keys and values without pointers or owned memory
+        static constexpr bool CHECKPOINTABLE = std::is_trivially_copyable_v<Key> && std::is_trivially_copyable_v<Value>;
+
+        using Base::lookup;
+        using Base::hash;
+        using Base::probe;
+        using Base::publishMetrics;
+        using Base::_capacity;
+        using Base::_size;
+        using Base::_table;
+        using Base::_bitArray;
+        using Base::_visualiser;
+        using Base::_metrics;
+
+        void markDirty(size_t index);
+        bool writeCheckpoint(std::ostream& out, core::CheckpointKind kind);
+
+        core::DirtyPages _dirtySlots; // Pages of _table changed since the last checkpoint
+        core::DirtyPages _dirtyOccupancy; // Pages of _bitArray's words changed since the last checkpoint
+        uint64_t _checkpointSequence; // Sequence of the last checkpoint record written or restored, 0 before a base
     };
 }
 
@@ -4,17 +4,16 @@ namespace pds::hashTable
 {
     /**
      * @brief Construct a new Open Addressing Hash Table< Key, Value>:: Open Addressing Hash Table object
+     * with the slots drawn from the given memory resource
      * 
      * @tparam Key 
      * @tparam Value 
+     * @param resource 
      */
     template<typename Key, typename Value>
-    OpenAddressingHashTable<Key, Value>::OpenAddressingHashTable()
-        : _capacity(0), _size(0)
-    {
-        _table = new std::vector<std::pair<Key, Value>>(BIT_ARRAY_SIZE);
-        _bitArray = new std::bitset<BIT_ARRAY_SIZE>();
-    }
+    OpenAddressingHashTable<Key, Value>::OpenAddressingHashTable(std::pmr::memory_resource* resource)
+        : Base("OpenAddressingHashTable", resource),
+          _dirtySlots(0, resource), _dirtyOccupancy(0, resource), _checkpointSequence(0) {}
 
     /**
      * @brief Initialise the hash table with a given capacity
@@ -26,10 +25,10 @@ namespace pds::hashTable
     template<typename Key, typename Value>
     void OpenAddressingHashTable<Key, Value>::init(size_t capacity)
     {
-        _capacity = capacity;
-        _size = 0;
-        _visualiser.logAction("Initialized table");
-        _visualiser.log(*this, std::nullopt, VisualContext::INIT);
+        Base::reset(capacity);
+        _dirtySlots.resize(_capacity * sizeof(std::pair<Key, Value>));
+        _dirtyOccupancy.resize(_bitArray.numWords() * sizeof(uint64_t));
+        _checkpointSequence = 0;
     }
 
     /**
@@ -39,43 +38,120 @@ namespace pds::hashTable
      * @tparam Value 
      * @param key 
      * @param value 
+     * @return true if the pair was inserted
+     * @return false if the table is full, leaving it unchanged
      */
     template<typename Key, typename Value>
-    void OpenAddressingHashTable<Key, Value>::insert(const Key& key, const Value& value)
+    bool OpenAddressingHashTable<Key, Value>::insert(const Key& key, const Value& value)
     {
+        if (_size == _capacity)
+            return false;
+
         size_t index = hash(key);
-        while (_bitArray->test(index)) {
+        size_t probes = 0;
+        while (_bitArray.test(index)) {
             index = probe(index);
+            ++probes;
         }
-        (*_table)[index] = {key, value};
-        _bitArray->set(index);
+        _table[index] = {key, value};
+        _bitArray.set(index);
+        markDirty(index);
         _size++;
-        _visualiser.logAction("Inserted key: " + key);
-        _visualiser.log(*this, index, VisualContext::INSERT);
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("Inserted key: " + toDisplayString(key));
+            _visualiser.log(*this, index, VisualContext::INSERT);
+        }
+        _metrics.recordProbeLength(probes);
+        _metrics.recordInsert();
+        publishMetrics();
+        return true;
     }
 
     /**
-     * @brief Queries the hash table for a value associated with a key
+     * @brief Inserts a key-value pair unless the key is already present, moving the key and
+     * constructing the value in the slot from args instead of copying a {key, value} pair
      * 
      * @tparam Key 
      * @tparam Value 
+     * @tparam K 
+     * @tparam Args 
      * @param key 
-     * @return std::optional<Value> 
+     * @param args 
+     * @return true if the pair was inserted
+     * @return false if the key was present or the table is full
      */
     template<typename Key, typename Value>
-    std::optional<Value> OpenAddressingHashTable<Key, Value>::query(const Key& key) const
+    template<typename K, typename... Args>
+    bool OpenAddressingHashTable<Key, Value>::tryEmplace(K&& key, Args&&... args)
     {
+        if (_size == _capacity)
+            return false;
+
         size_t index = hash(key);
-        while (_bitArray->test(index)) {
-            if ((*_table)[index].first == key) {
-                _visualiser.logAction("Query hit for key: " + key);
-                _visualiser.log(*this, index, VisualContext::QUERY);
-                return (*_table)[index].second;
+        size_t probes = 0;
+        while (_bitArray.test(index)) {
+            if (_table[index].first == key) {
+                return false;
             }
             index = probe(index);
+            ++probes;
         }
-        _visualiser.logAction("Query miss for key: " + key);
-        return std::nullopt;
+
+        _table[index].first = std::forward<K>(key);
+        _table[index].second = Value(std::forward<Args>(args)...);
+        _bitArray.set(index);
+        markDirty(index);
+        _size++;
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("Emplaced key: " + toDisplayString(_table[index].first));
+            _visualiser.log(*this, index, VisualContext::INSERT);
+        }
+        _metrics.recordProbeLength(probes);
+        _metrics.recordInsert();
+        publishMetrics();
+        return true;
+    }
+
+    /**
+     * @brief Queries the hash table for a value associated with a key
+     * 
+     * @tparam Key 
+     * @tparam Value 
+     * @param key 
+     * @return std::optional<Value> 
+     */
+    template<typename Key, typename Value>
+    std::optional<Value> OpenAddressingHashTable<Key, Value>::query(const Key& key) const
+    {
+        const auto index = lookup(key);
+        if (!index.has_value())
+            return std::nullopt;
+
+        return _table[*index].second;
+    }
+
+    /**
+     * @brief Queries the hash table with a key that compares equal to Key without being one,
+     * e.g. a std::string_view into a network buffer for a table keyed by std::string.
+     * Nothing is allocated on the lookup path.
+     * 
+     * @tparam Key 
+     * @tparam Value 
+     * @tparam K 
+     * @param key 
+     * @return std::optional<Value> 
+     */
+    template<typename Key, typename Value>
+    template<typename K, typename>
+    std::optional<Value> OpenAddressingHashTable<Key, Value>::query(const K& key) const
+    {
+        const auto index = lookup(key);
+        if (!index.has_value())
+            return std::nullopt;
+
+        return _table[*index].second;
     }
 
     /**
@@ -90,7 +166,87 @@ namespace pds::hashTable
     template<typename Key, typename Value>
     bool OpenAddressingHashTable<Key, Value>::contains(const Key& key) const
     {
-        return query(key).has_value();
+        return lookup(key).has_value();
+    }
+
+    /**
+     * @brief Checks if the hash table contains a key given as a transparent key type
+     * 
+     * @tparam Key 
+     * @tparam Value 
+     * @tparam K 
+     * @param key 
+     * @return true 
+     * @return false 
+     */
+    template<typename Key, typename Value>
+    template<typename K, typename>
+    bool OpenAddressingHashTable<Key, Value>::contains(const K& key) const
+    {
+        return lookup(key).has_value();
+    }
+
+    /**
+     * @brief Checks if a table keyed by std::string contains the key held in a raw buffer
+     * 
+     * @tparam Key 
+     * @tparam Value 
+     * @param data 
+     * @param length 
+     * @return true 
+     * @return false 
+     */
+    template<typename Key, typename Value>
+    template<typename K, typename>
+    bool OpenAddressingHashTable<Key, Value>::contains(const char* data, size_t length) const
+    {
+        return lookup(std::string_view(data, length)).has_value();
+    }
+
+    /**
+     * @brief Pointer to the value stored for a key, which can be read or updated in place
+     * without copying it. Valid until the next insert or erase.
+     * 
+     * @tparam Key 
+     * @tparam Value 
+     * @param key 
+     * @return const Value* nullptr if the key is absent
+     */
+    template<typename Key, typename Value>
+    const Value* OpenAddressingHashTable<Key, Value>::find(const Key& key) const
+    {
+        const auto index = lookup(key);
+        return index.has_value() ? &_table[*index].second : nullptr;
+    }
+
+    template<typename Key, typename Value>
+    Value* OpenAddressingHashTable<Key, Value>::find(const Key& key)
+    {
+        return const_cast<Value*>(std::as_const(*this).find(key));
+    }
+
+    /**
+     * @brief Pointer to the value stored for a transparent key, e.g. a std::string_view
+     * 
+     * @tparam Key 
+     * @tparam Value 
+     * @tparam K 
+     * @param key 
+     * @return const Value* nullptr if the key is absent
+     */
+    template<typename Key, typename Value>
+    template<typename K, typename>
+    const Value* OpenAddressingHashTable<Key, Value>::find(const K& key) const
+    {
+        const auto index = lookup(key);
+        return index.has_value() ? &_table[*index].second : nullptr;
+    }
+
+    template<typename Key, typename Value>
+    template<typename K, typename>
+    Value* OpenAddressingHashTable<Key, Value>::find(const K& key)
+    {
+        return const_cast<Value*>(std::as_const(*this).find(key));
     }
 
     /**
@@ -103,21 +259,24 @@ namespace pds::hashTable
     template<typename Key, typename Value>
     void OpenAddressingHashTable<Key, Value>::erase(const Key& key)
     {
-        size_t index = hash(key);
-        while (_bitArray->test(index))
-        {
-            if ((*_table)[index].first == key)
-            {
-                _bitArray->reset(index);
-                (*_table)[index] = {};
-                _size--;
-                _visualiser.logAction("Erased key: " + key);
-                _visualiser.log(*this, index, VisualContext::ERASE);
-                return;
-            }
-            index = probe(index);
-        }
-        _visualiser.logAction("Erase failed: key not found - " + key);
+        Base::eraseKey(key, [this](size_t index) { markDirty(index); });
+    }
+
+    /**
+     * @brief Erases every pair for which pred(key, value) is true, in one pass over the
+     * occupied slots, calling pred once per pair
+     * 
+     * @tparam Key 
+     * @tparam Value 
+     * @tparam Pred 
+     * @param pred 
+     * @return size_t Number of pairs erased
+     */
+    template<typename Key, typename Value>
+    template<typename Pred>
+    size_t OpenAddressingHashTable<Key, Value>::eraseIf(Pred&& pred)
+    {
+        return Base::eraseMatching(pred, [this](size_t index) { markDirty(index); });
     }
 
     /**
@@ -129,79 +288,163 @@ namespace pds::hashTable
     template<typename Key, typename Value>
     void OpenAddressingHashTable<Key, Value>::clear()
     {
-        _bitArray->reset();
-        _table->clear();
-        _table->resize(BIT_ARRAY_SIZE);
-        _size = 0;
-        _visualiser.logAction("Cleared table");
+        Base::clearSlots();
+        _dirtySlots.markAll();
+        _dirtyOccupancy.markAll();
     }
 
     /**
-     * @brief Gets the load factor of the hash table as a percentage
+     * @brief Writes a base checkpoint, every page of slots and occupancy bits, to the stream
+     * and starts a new chain of deltas after it. Needs trivially copyable Key and Value.
      * 
      * @tparam Key 
      * @tparam Value 
-     * @return int32_t 
+     * @param out 
+     * @return true 
+     * @return false if the stream failed
      */
     template<typename Key, typename Value>
-    int32_t OpenAddressingHashTable<Key, Value>::getLoadFactor() const
+    bool OpenAddressingHashTable<Key, Value>::checkpoint(std::ostream& out)
     {
-        return static_cast<int32_t>(_size * 100 / _capacity);
+        if (!writeCheckpoint(out, core::CheckpointKind::BASE))
+            return false;
+
+        _checkpointSequence = 1;
+        return true;
     }
 
     /**
-     * @brief Gets the current size of the hash table
+     * @brief Writes only the 4KB pages of slots and occupancy bits changed since the last
+     * checkpoint, so its cost follows the write rate rather than the capacity
      * 
      * @tparam Key 
      * @tparam Value 
-     * @return int32_t 
+     * @param out 
+     * @return true 
+     * @return false if no base was written since init, or the stream failed
      */
     template<typename Key, typename Value>
-    int32_t OpenAddressingHashTable<Key, Value>::getSize() const
+    bool OpenAddressingHashTable<Key, Value>::checkpointDelta(std::ostream& out)
     {
-        return static_cast<int32_t>(_size);
+        if (_checkpointSequence == 0 || !writeCheckpoint(out, core::CheckpointKind::DELTA))
+            return false;
+
+        ++_checkpointSequence;
+        return true;
     }
 
     /**
-     * @brief Checks if the hash table is empty
+     * @brief Rebuilds the table from a stream of checkpoint records: a base, then the deltas
+     * written after it. Replay stops at the end of the stream or at the first torn, corrupt or
+     * out of sequence record, which is where a crash mid-write leaves the stream.
+     *
+     * A later base starts a new chain only once all of its pages are verified, so a base torn
+     * after an earlier chain keeps that chain. The table is untouched until replay ends.
      * 
      * @tparam Key 
      * @tparam Value 
-     * @return true 
-     * @return false 
+     * @param in 
+     * @return true if a base was restored
+     * @return false if the stream does not start with an intact base, leaving the table empty
      */
     template<typename Key, typename Value>
-    bool OpenAddressingHashTable<Key, Value>::isEmpty() const
+    bool OpenAddressingHashTable<Key, Value>::restore(std::istream& in)
     {
-        return _size == 0;
+        static_assert(CHECKPOINTABLE, "Checkpoints copy slots as raw bytes, so Key and Value must be trivially copyable");
+
+        std::pmr::memory_resource* resource = _table.get_allocator().resource();
+        core::CheckpointRecord record(resource);
+        // Slots and occupancy of the last verified chain, and of the base being read
+        std::pmr::vector<std::pair<Key, Value>> table(resource), stagedTable(resource);
+        core::BitArray occupancy(0, resource), stagedOccupancy(0, resource);
+        uint64_t size = 0;
+        uint64_t sequence = 0;
+        while (core::readCheckpointHeader(in, record) && record.tag == CHECKPOINT_TAG && record.numRegions == 2 &&
+               record.state[1] == sizeof(std::pair<Key, Value>))
+        {
+            if (record.kind == core::CheckpointKind::BASE)
+            {
+                const size_t capacity = static_cast<size_t>(record.state[0]);
+                if (record.sequence != 1 || capacity == 0 || record.regionSizes[0] / sizeof(std::pair<Key, Value>) != capacity ||
+                    record.regionSizes[0] % sizeof(std::pair<Key, Value>) != 0)
+                    break;
+
+                stagedTable.assign(capacity, {});
+                stagedOccupancy.resize(capacity);
+                if (!core::readCheckpointPages(in, record, {{stagedTable.data(), capacity * sizeof(std::pair<Key, Value>)},
+                                                            {stagedOccupancy.data(), stagedOccupancy.numWords() * sizeof(uint64_t)}}))
+                    break;
+
+                table.swap(stagedTable);
+                std::swap(occupancy, stagedOccupancy);
+            }
+            else if (sequence == 0 || record.sequence != sequence + 1 ||
+                     !core::readCheckpointPages(in, record, {{table.data(), table.size() * sizeof(std::pair<Key, Value>)},
+                                                             {occupancy.data(), occupancy.numWords() * sizeof(uint64_t)}}))
+            {
+                break;
+            }
+
+            size = record.state[2];
+            sequence = record.sequence;
+        }
+
+        if (sequence == 0)
+        {
+            clear();
+            _checkpointSequence = 0;
+            return false;
+        }
+
+        init(table.size());
+        _table.swap(table);
+        std::swap(_bitArray, occupancy);
+        _bitArray.recount();
+        _size = static_cast<size_t>(size);
+        _checkpointSequence = sequence;
+        _dirtySlots.clear();
+        _dirtyOccupancy.clear();
+        return true;
     }
 
     /**
-     * @brief Hash function for the key
+     * @brief Pages of slots and occupancy bits the next delta checkpoint would write
      * 
      * @tparam Key 
      * @tparam Value 
-     * @param key 
      * @return size_t 
      */
     template<typename Key, typename Value>
-    size_t OpenAddressingHashTable<Key, Value>::hash(const Key& key) const
+    size_t OpenAddressingHashTable<Key, Value>::getDirtyPages() const
     {
-        return std::hash<Key>{}(key) % _capacity;
+        return _dirtySlots.count() + _dirtyOccupancy.count();
     }
 
     /**
-     * @brief Linear probing function to find the next index
+     * @brief Records that a slot and its occupancy bit changed, for the next delta checkpoint
      * 
      * @tparam Key 
      * @tparam Value 
      * @param index 
-     * @return size_t 
      */
     template<typename Key, typename Value>
-    size_t OpenAddressingHashTable<Key, Value>::probe(size_t index) const
+    void OpenAddressingHashTable<Key, Value>::markDirty(size_t index)
     {
-        return (index + 1) % _capacity;
+        if constexpr (CHECKPOINTABLE)
+        {
+            _dirtySlots.mark(index * sizeof(std::pair<Key, Value>), sizeof(std::pair<Key, Value>));
+            _dirtyOccupancy.mark(index / 64 * sizeof(uint64_t));
+        }
     }
 
-}
+    template<typename Key, typename Value>
+    bool OpenAddressingHashTable<Key, Value>::writeCheckpoint(std::ostream& out, core::CheckpointKind kind)
+    {
+        static_assert(CHECKPOINTABLE, "Checkpoints copy slots as raw bytes, so Key and Value must be trivially copyable");
+
+        return core::writeCheckpoint(out, CHECKPOINT_TAG, kind, kind == core::CheckpointKind::BASE ? 1 : _checkpointSequence + 1,
+                                     {_capacity, sizeof(std::pair<Key, Value>), _size, 0},
+                                     {{_table.data(), _capacity * sizeof(std::pair<Key, Value>), &_dirtySlots},
+                                      {_bitArray.data(), _bitArray.numWords() * sizeof(uint64_t), &_dirtyOccupancy}});
+    }
+}
\ No newline at end of file
@@ -2,36 +2,62 @@
 
 #include <iostream>
 #include <optional>
-#include <bitset>
 #include <iomanip>
+#include <type_traits>
 
 #include "pds/core/common.h"
+#include "pds/core/snapshotWriter.h"
 
 namespace pds::hashTable
 {
-    template <typename Key, typename Value>
-    class OpenAddressingHashTable; // Forward declaration
+    template <typename Key, typename Slot>
+    class OpenAddressingSlots; // Forward declaration
 
-    template <typename Key, typename Value>
+    /**
+     * @brief Draws the slots of an OpenAddressingHashTable, whose slots are std::pair<Key, Value>,
+     * or of an OpenAddressingHashSet, whose slots are Key
+     *
+     * @tparam Key
+     * @tparam Slot
+     */
+    template <typename Key, typename Slot>
     class OpenAddressingHashTableVisualiser {
     public:
     
         /**
-         * @brief Logs the current state of the hash table
+         * @brief Sends sampled snapshots to the writer instead of drawing to std::cout, or draws again given nullptr
+         *
+         * @param writer
+         */
+        void setSnapshotWriter(core::SnapshotWriter* writer)
+        {
+            _writer = writer;
+        }
+
+        /**
+         * @brief Logs the current state of the hash table or set
          * 
-         * @param table The hash table to log
+         * @param table The hash table or set to log
          * @param highlight Optional index to highlight in the bit array
          * @param ctx Context of the operation (INIT, INSERT, QUERY, ERASE)
          */
-        void log(const OpenAddressingHashTable<Key, Value>& table,
+        void log(const OpenAddressingSlots<Key, Slot>& table,
              std::optional<size_t> highlight = std::nullopt,
              pds::VisualContext ctx = pds::VisualContext::UNKNOWN) const
         {
+            if (_writer != nullptr)
+            {
+                _writer->capture(table._name, ctx, highlight, _lastAction, table._bitArray.size(),
+                                 [&table](size_t i) { return table._bitArray.test(i); });
+                return;
+            }
+
             constexpr size_t rowSize = 32;
+            const size_t bitArraySize = table._bitArray.size();
             std::cout << "\nBit Array State:\n\n";
 
-            for (size_t i = 0; i < BIT_ARRAY_SIZE; ++i) {
-                const bool isSet = table._bitArray->test(i);
+            for (size_t i = 0; i < bitArraySize; ++i) {
+                const bool isSet = table._bitArray.test(i);
 
                 if (highlight.has_value() && highlight.value() == i)
                 {
@@ -54,36 +80,51 @@ namespace pds::hashTable
                 }
             }
 
-            if (BIT_ARRAY_SIZE % rowSize != 0)
+            if (bitArraySize % rowSize != 0)
             {
-                std::cout << "  <- [" << BIT_ARRAY_SIZE - (BIT_ARRAY_SIZE % rowSize)
-                        << " - " << BIT_ARRAY_SIZE - 1 << "]\n";
+                std::cout << "  <- [" << bitArraySize - (bitArraySize % rowSize)
+                        << " - " << bitArraySize - 1 << "]\n";
             }
 
             std::cout << "\n";
 
+            constexpr bool hasValues = !std::is_same_v<Slot, Key>;
             std::cout << "\nHash Table Contents:\n\n";
             std::cout << std::left
                       << std::setw(12) << "Hash Index" << " | "
-                      << std::setw(20) << "Key" << " | "
-                      << std::setw(20) << "Value"
-                      << "\n";
+                      << std::setw(20) << "Key";
+            if constexpr (hasValues)
+            {
+                std::cout << " | " << std::setw(20) << "Value";
+            }
+            std::cout << "\n";
 
             std::cout << std::string(12, '-') << "-+-"
-                      << std::string(20, '-') << "-+-"
-                      << std::string(20, '-') << "\n";
+                      << std::string(20, '-');
+            if constexpr (hasValues)
+            {
+                std::cout << "-+-" << std::string(20, '-');
+            }
+            std::cout << "\n";
 
             // Table rows
             for (size_t i = 0; i < table._capacity; ++i)
             {
-                const auto &entry = table._table->at(i);
-                if (entry.first != Key{})
+                const auto &entry = table._table.at(i);
+                if (table._bitArray.test(i))
                 {
                     std::cout << std::left
-                              << std::setw(12) << i << " | "
-                              << std::setw(20) << entry.first << " | "
-                              << std::setw(20) << entry.second
-                              << "\n";
+                              << std::setw(12) << i << " | ";
+                    if constexpr (hasValues)
+                    {
+                        std::cout << std::setw(20) << entry.first << " | "
+                                  << std::setw(20) << entry.second;
+                    }
+                    else
+                    {
+                        std::cout << std::setw(20) << entry;
+                    }
+                    std::cout << "\n";
                 }
             }
             std::cout << "\n";
@@ -97,7 +138,16 @@ namespace pds::hashTable
          */
         void logAction(const std::string& action) const
         {
+            if (_writer != nullptr)
+            {
+                _lastAction = action;
+                return;
+            }
             std::cout << "[LOG] " << action << "\n";
         }
+
+    private:
+        core::SnapshotWriter* _writer = nullptr;
+        mutable std::string _lastAction; // Attached to the next snapshot
     };
 }
\ No newline at end of file
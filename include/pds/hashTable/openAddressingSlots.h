@@ -0,0 +1,76 @@
+#pragma once
+
+#include <vector>
+#include <optional>
+#include <utility>
+#include <memory_resource>
+#include <type_traits>
+
+#include "pds/core/common.h"
+#include "pds/core/bitArray.h"
+#include "pds/core/hash.h"
+#include "pds/core/metrics.h"
+#include "openAddressingHashTableVisualiser.h"
+
+namespace pds::hashTable
+{
+    /**
+     * @brief Linear probing over a fixed capacity of slots, shared by OpenAddressingHashTable
+     * and OpenAddressingHashSet. A slot is either a Key or a std::pair<Key, Value>; the
+     * probing, lookup, backward-shift erasure, iteration, metrics and visualising are the same
+     * for both, and the two classes add their insert and erase interfaces on top.
+     *
+     * @tparam Key
+     * @tparam Slot Key, or std::pair<Key, Value>
+     */
+    template<typename Key, typename Slot>
+    class OpenAddressingSlots
+    {
+        friend class OpenAddressingHashTableVisualiser<Key, Slot>;
+
+        public:
+        template <typename Fn>
+        void forEach(Fn&& fn) const;
+
+        int32_t getLoadFactor() const;
+        int32_t getSize() const;
+        bool isEmpty() const;
+
+        core::Stats stats() const;
+        void setMetricsSink(core::MetricsSink* sink, uint64_t publishInterval = 1024);
+        void setSnapshotWriter(core::SnapshotWriter* writer);
+
+        protected:
+        OpenAddressingSlots(const char* name, std::pmr::memory_resource* resource);
+
+        void reset(size_t capacity);
+        void clearSlots();
+        template <typename K>
+        std::optional<size_t> lookup(const K& key) const;
+        template <typename K, typename OnMove>
+        bool eraseKey(const K& key, OnMove&& moved);
+        template <typename Pred, typename OnMove>
+        size_t eraseMatching(Pred&& pred, OnMove&& moved);
+        template <typename OnMove>
+        void eraseAt(size_t index, core::BitArray* marks, OnMove&& moved);
+        template <typename K>
+        size_t hash(const K& key) const;
+        size_t probe(size_t index) const;
+        void publishMetrics() const;
+
+        static const Key& keyOf(const Slot& slot);
+        // Calls fn(key) for a set's slot and fn(key, value) for a table's
+        template <typename Fn>
+        static decltype(auto) apply(Fn& fn, const Slot& slot);
+
+        const char* _name; // Structure name given to the metrics sink
+        size_t _capacity;
+        size_t _size;
+        std::pmr::vector<Slot> _table;
+        core::BitArray _bitArray; // Occupancy of each slot in _table
+        OpenAddressingHashTableVisualiser<Key, Slot> _visualiser;
+        mutable core::Metrics _metrics;
+    };
+}
+
+#include "openAddressingSlotsImpl.h"
@@ -0,0 +1,400 @@
+#pragma once
+
+namespace pds::hashTable
+{
+    /**
+     * @brief Construct a new Open Addressing Slots< Key, Slot>:: Open Addressing Slots object
+     * with the slots drawn from the given memory resource
+     *
+     * @tparam Key
+     * @tparam Slot
+     * @param name Structure name given to the metrics sink
+     * @param resource
+     */
+    template<typename Key, typename Slot>
+    OpenAddressingSlots<Key, Slot>::OpenAddressingSlots(const char* name, std::pmr::memory_resource* resource)
+        : _name(name), _capacity(0), _size(0),
+          _table(BIT_ARRAY_SIZE, resource),
+          _bitArray(BIT_ARRAY_SIZE, resource) {}
+
+    /**
+     * @brief Calls fn(key) for a set, or fn(key, value) for a table, for every slot in slot
+     * order. Walks the occupancy bits a word at a time, so empty runs of 64 slots are skipped
+     * without touching the slots.
+     *
+     * @tparam Key
+     * @tparam Slot
+     * @tparam Fn
+     * @param fn
+     */
+    template<typename Key, typename Slot>
+    template<typename Fn>
+    void OpenAddressingSlots<Key, Slot>::forEach(Fn&& fn) const
+    {
+        _bitArray.forEachSet([&](size_t index) {
+            apply(fn, _table[index]);
+        });
+    }
+
+    /**
+     * @brief Gets the load factor as a percentage
+     *
+     * @tparam Key
+     * @tparam Slot
+     * @return int32_t
+     */
+    template<typename Key, typename Slot>
+    int32_t OpenAddressingSlots<Key, Slot>::getLoadFactor() const
+    {
+        return static_cast<int32_t>(_size * 100 / _capacity);
+    }
+
+    /**
+     * @brief Gets the number of occupied slots
+     *
+     * @tparam Key
+     * @tparam Slot
+     * @return int32_t
+     */
+    template<typename Key, typename Slot>
+    int32_t OpenAddressingSlots<Key, Slot>::getSize() const
+    {
+        return static_cast<int32_t>(_size);
+    }
+
+    /**
+     * @brief Checks if no slot is occupied
+     *
+     * @tparam Key
+     * @tparam Slot
+     * @return true
+     * @return false
+     */
+    template<typename Key, typename Slot>
+    bool OpenAddressingSlots<Key, Slot>::isEmpty() const
+    {
+        return _size == 0;
+    }
+
+    /**
+     * @brief Snapshot of the operation counters, the probe length histogram and the fraction of slots occupied
+     *
+     * @tparam Key
+     * @tparam Slot
+     * @return core::Stats
+     */
+    template<typename Key, typename Slot>
+    core::Stats OpenAddressingSlots<Key, Slot>::stats() const
+    {
+        return _metrics.snapshot(_capacity == 0 ? 0.0f : static_cast<float>(_size) / static_cast<float>(_capacity));
+    }
+
+    /**
+     * @brief Attaches a sink that receives stats() every publishInterval operations, or detaches it given nullptr.
+     * Has no effect unless PDS_METRICS is 1.
+     *
+     * @tparam Key
+     * @tparam Slot
+     * @param sink
+     * @param publishInterval
+     */
+    template<typename Key, typename Slot>
+    void OpenAddressingSlots<Key, Slot>::setMetricsSink(core::MetricsSink* sink, uint64_t publishInterval)
+    {
+        _metrics.setSink(sink, publishInterval);
+    }
+
+    /**
+     * @brief Has the visualiser emit sampled, run-length encoded snapshots to the writer
+     * instead of drawing every operation to std::cout. Only has an effect while PDS_VISUALISE is 1.
+     *
+     * @tparam Key
+     * @tparam Slot
+     * @param writer
+     */
+    template<typename Key, typename Slot>
+    void OpenAddressingSlots<Key, Slot>::setSnapshotWriter(core::SnapshotWriter* writer)
+    {
+        _visualiser.setSnapshotWriter(writer);
+    }
+
+    /**
+     * @brief Empties the slots and sizes them for a given capacity
+     *
+     * @tparam Key
+     * @tparam Slot
+     * @param capacity
+     */
+    template<typename Key, typename Slot>
+    void OpenAddressingSlots<Key, Slot>::reset(size_t capacity)
+    {
+        _capacity = capacity;
+        _size = 0;
+        _table.assign(_capacity, Slot{});
+        _bitArray.resize(_capacity);
+        _metrics.reset();
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("Initialized table");
+            _visualiser.log(*this, std::nullopt, VisualContext::INIT);
+        }
+    }
+
+    /**
+     * @brief Empties every slot, keeping the capacity
+     *
+     * @tparam Key
+     * @tparam Slot
+     */
+    template<typename Key, typename Slot>
+    void OpenAddressingSlots<Key, Slot>::clearSlots()
+    {
+        _bitArray.reset();
+        _table.assign(_capacity, Slot{});
+        _size = 0;
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("Cleared table");
+        }
+    }
+
+    /**
+     * @brief Probes for a key of any type that hashes and compares like Key, giving up after
+     * one lap of a full table
+     *
+     * @tparam Key
+     * @tparam Slot
+     * @tparam K
+     * @param key
+     * @return std::optional<size_t> Index of the slot holding the key
+     */
+    template<typename Key, typename Slot>
+    template<typename K>
+    std::optional<size_t> OpenAddressingSlots<Key, Slot>::lookup(const K& key) const
+    {
+        size_t index = hash(key);
+        size_t probes = 0;
+        while (_bitArray.test(index) && probes < _capacity) {
+            if (keyOf(_table[index]) == key) {
+                if constexpr (VISUALISE)
+                {
+                    _visualiser.logAction("Query hit for key: " + toDisplayString(key));
+                    _visualiser.log(*this, index, VisualContext::QUERY);
+                }
+                _metrics.recordProbeLength(probes);
+                _metrics.recordQuery(true);
+                publishMetrics();
+                return index;
+            }
+            index = probe(index);
+            ++probes;
+        }
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("Query miss for key: " + toDisplayString(key));
+        }
+        _metrics.recordProbeLength(probes);
+        _metrics.recordQuery(false);
+        publishMetrics();
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Probes for a key and empties its slot
+     *
+     * @tparam Key
+     * @tparam Slot
+     * @tparam K
+     * @tparam OnMove
+     * @param key
+     * @param moved Called with the index of every slot the erasure writes
+     * @return true if the key was present
+     * @return false
+     */
+    template<typename Key, typename Slot>
+    template<typename K, typename OnMove>
+    bool OpenAddressingSlots<Key, Slot>::eraseKey(const K& key, OnMove&& moved)
+    {
+        size_t index = hash(key);
+        size_t probes = 0;
+        while (_bitArray.test(index) && probes < _capacity)
+        {
+            if (keyOf(_table[index]) == key)
+            {
+                eraseAt(index, nullptr, moved);
+                _metrics.recordProbeLength(probes);
+                _metrics.recordErase();
+                publishMetrics();
+                if constexpr (VISUALISE)
+                {
+                    _visualiser.logAction("Erased key: " + toDisplayString(key));
+                    _visualiser.log(*this, index, VisualContext::ERASE);
+                }
+                return true;
+            }
+            index = probe(index);
+            ++probes;
+        }
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("Erase failed: key not found - " + toDisplayString(key));
+        }
+        _metrics.recordProbeLength(probes);
+        _metrics.recordErase();
+        publishMetrics();
+        return false;
+    }
+
+    /**
+     * @brief Empties every slot for which pred is true, in one pass over the occupied slots,
+     * calling pred once per slot
+     *
+     * @tparam Key
+     * @tparam Slot
+     * @tparam Pred
+     * @tparam OnMove
+     * @param pred Called as pred(key) for a set and pred(key, value) for a table
+     * @param moved Called with the index of every slot the erasure writes
+     * @return size_t Number of slots emptied
+     */
+    template<typename Key, typename Slot>
+    template<typename Pred, typename OnMove>
+    size_t OpenAddressingSlots<Key, Slot>::eraseMatching(Pred&& pred, OnMove&& moved)
+    {
+        // Decide first, as erasing shifts later slots back over slots already passed
+        core::BitArray marks(_capacity, _bitArray.resource());
+        _bitArray.forEachSet([&](size_t index) {
+            if (apply(pred, _table[index]))
+            {
+                marks.set(index);
+            }
+        });
+
+        // A shift can wrap a marked slot back to the start, so keep going round until none is left
+        const size_t erased = marks.count();
+        for (size_t index = 0; marks.count() > 0; index = probe(index))
+        {
+            while (marks.test(index))
+            {
+                eraseAt(index, &marks, moved);
+                _metrics.recordErase();
+            }
+        }
+        publishMetrics();
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("Erased " + std::to_string(erased) + " matching keys");
+            _visualiser.log(*this, std::nullopt, VisualContext::ERASE);
+        }
+        return erased;
+    }
+
+    /**
+     * @brief Empties a slot by backward-shift deletion: later slots of the probe run that may
+     * sit earlier move back into the gap, so no run is broken and lookups need no tombstones
+     *
+     * @tparam Key
+     * @tparam Slot
+     * @tparam OnMove
+     * @param index
+     * @param marks Per-slot flags that move along with the slots, used by eraseMatching; the emptied slot's is cleared
+     * @param moved Called with the index of every slot written
+     */
+    template<typename Key, typename Slot>
+    template<typename OnMove>
+    void OpenAddressingSlots<Key, Slot>::eraseAt(size_t index, core::BitArray* marks, OnMove&& moved)
+    {
+        size_t hole = index;
+        for (size_t next = probe(hole); _bitArray.test(next) && next != index; next = probe(next))
+        {
+            // The slot at next may move back to the hole if the hole lies between its home and next
+            const size_t home = hash(keyOf(_table[next]));
+            if ((next + _capacity - home) % _capacity >= (next + _capacity - hole) % _capacity)
+            {
+                _table[hole] = std::move(_table[next]);
+                moved(hole);
+                if (marks != nullptr)
+                {
+                    marks->test(next) ? marks->set(hole) : marks->reset(hole);
+                }
+                hole = next;
+            }
+        }
+
+        _bitArray.reset(hole);
+        _table[hole] = Slot{};
+        moved(hole);
+        if (marks != nullptr)
+        {
+            marks->reset(hole);
+        }
+        _size--;
+    }
+
+    /**
+     * @brief Hash function for the key. Transparent keys, and keys such as character pointers
+     * that convert to Key, hash to the same value as the Key they compare equal to.
+     *
+     * @tparam Key
+     * @tparam Slot
+     * @tparam K
+     * @param key
+     * @return size_t
+     */
+    template<typename Key, typename Slot>
+    template<typename K>
+    size_t OpenAddressingSlots<Key, Slot>::hash(const K& key) const
+    {
+        return core::keyHash<Key>(key) % _capacity;
+    }
+
+    /**
+     * @brief Linear probing function to find the next index
+     *
+     * @tparam Key
+     * @tparam Slot
+     * @param index
+     * @return size_t
+     */
+    template<typename Key, typename Slot>
+    size_t OpenAddressingSlots<Key, Slot>::probe(size_t index) const
+    {
+        return (index + 1) % _capacity;
+    }
+
+    template<typename Key, typename Slot>
+    void OpenAddressingSlots<Key, Slot>::publishMetrics() const
+    {
+        if (_metrics.publishDue())
+        {
+            _metrics.publish(_name, stats());
+        }
+    }
+
+    template<typename Key, typename Slot>
+    const Key& OpenAddressingSlots<Key, Slot>::keyOf(const Slot& slot)
+    {
+        if constexpr (std::is_same_v<Slot, Key>)
+        {
+            return slot;
+        }
+        else
+        {
+            return slot.first;
+        }
+    }
+
+    template<typename Key, typename Slot>
+    template<typename Fn>
+    decltype(auto) OpenAddressingSlots<Key, Slot>::apply(Fn& fn, const Slot& slot)
+    {
+        if constexpr (std::is_same_v<Slot, Key>)
+        {
+            return fn(slot);
+        }
+        else
+        {
+            return fn(slot.first, slot.second);
+        }
+    }
+}
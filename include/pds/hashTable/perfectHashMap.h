@@ -0,0 +1,117 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <memory_resource>
+
+#include "pds/core/common.h"
+#include "pds/core/concurrency.h"
+#include "pds/core/hash.h"
+
+namespace pds::hashTable
+{
+    /**
+     * @brief Read-only map built once from a fixed key set, on a minimal perfect hash function
+     * in the style of PTHash. Keys are split into partitions by hash, built in parallel. Within a
+     * partition each key falls in a bucket, and every bucket has a pilot value chosen at build
+     * time so that its keys land in free slots. Pilots are stored dictionary-encoded, under 3 bits
+     * per key, and the n pairs sit in exactly n slots. A lookup computes its slot from the
+     * bucket's pilot and touches that one slot.
+     *
+     * The slot holds a Check next to the value. Check is Key by default, so absent keys are
+     * rejected exactly. An 8, 16 or 32-bit fingerprint can replace it when keys are large and
+     * a false positive rate of 2^-bits on absent keys is acceptable.
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Check Key, or uint8_t / uint16_t / uint32_t to store fingerprints instead of keys
+     */
+    template <typename Key, typename Value, typename Check = Key>
+    class PerfectHashMap
+    {
+        static_assert(std::is_same_v<Check, Key> || std::is_same_v<Check, uint8_t> ||
+                      std::is_same_v<Check, uint16_t> || std::is_same_v<Check, uint32_t>,
+                      "Check is the key itself or an 8, 16 or 32-bit fingerprint");
+
+        static constexpr bool STORES_KEYS = std::is_same_v<Check, Key>;
+
+        public:
+        explicit PerfectHashMap(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+        template <typename InputIt>
+        bool build(InputIt first, InputIt last, size_t numThreads = 0);
+
+        template <typename K>
+        const Value* find(const K& key) const;
+        std::optional<Value> query(const Key& key) const;
+        template <typename K, typename = std::enable_if_t<core::isTransparentKey<Key, K>>>
+        std::optional<Value> query(const K& key) const;
+        bool contains(const Key& key) const;
+        template <typename K, typename = std::enable_if_t<core::isTransparentKey<Key, K>>>
+        bool contains(const K& key) const;
+
+        int32_t getSize() const;
+        bool isEmpty() const;
+        double getBitsPerKey() const;
+
+        private:
+        static constexpr size_t PARTITION_SIZE = size_t{1} << 16; // Average keys per partition
+        static constexpr double BUCKET_DENSITY = 3.5; // Buckets per partition: density * n / log2(n)
+        static constexpr double LOAD = 0.99; // Keys per slot during the search; slots past n are remapped
+        static constexpr uint64_t MAX_PILOT = uint64_t{1} << 20; // A bucket needing more triggers a new seed
+        static constexpr size_t MAX_ATTEMPTS = 8; // Seeds tried before build gives up
+
+        struct Slot
+        {
+            Check check;
+            Value value;
+        };
+
+        struct Partition
+        {
+            uint64_t slotOffset; // First slot, and number of keys before the partition
+            uint64_t bucketOffset; // First bucket in the pilot array
+            uint64_t remapOffset; // First entry in the remap array
+            uint32_t size; // Keys, and slots, in the partition
+            uint32_t tableSize; // Positions searched over, size / LOAD
+            uint32_t numBuckets;
+            uint32_t denseBuckets; // Buckets taking 60% of the keys
+        };
+
+        template <typename K>
+        uint64_t hash(const K& key) const;
+        template <typename K>
+        Check checkOf(const K& key, uint64_t h) const;
+        size_t partitionOf(uint64_t h) const;
+        static uint32_t bucketOf(uint64_t h, const Partition& partition);
+        uint64_t pilotHash(uint64_t pilot) const;
+        uint64_t position(uint64_t h, const Partition& partition) const;
+
+        bool buildPartition(const Partition& partition, const uint64_t* hashes, uint64_t* pilots, uint32_t* remap,
+                            uint32_t* slotOf) const;
+        void encodePilots(const std::pmr::vector<uint64_t>& pilots);
+        void encodeRemap(const std::pmr::vector<uint32_t>& remap);
+        uint64_t pilotOf(uint64_t bucket) const;
+        static size_t bitsFor(uint64_t count);
+        static void pack(std::pmr::vector<uint64_t>& words, size_t index, size_t bits, uint64_t value);
+        static uint64_t unpack(const std::pmr::vector<uint64_t>& words, size_t index, size_t bits);
+
+        uint64_t _seed;
+        std::pmr::vector<Partition> _partitions;
+        std::pmr::vector<uint64_t> _pilotDictionary; // Distinct pilot values, _pilotBits each
+        std::pmr::vector<uint64_t> _pilotIndices; // Per bucket index into the dictionary, _indexBits each
+        size_t _pilotBits;
+        size_t _indexBits;
+        std::pmr::vector<uint64_t> _remap; // Slot within its partition for positions past the partition's size, _remapBits each
+        size_t _remapBits;
+        std::pmr::vector<Slot> _slots;
+    };
+}
+
+#include "perfectHashMapImpl.h"
@@ -0,0 +1,564 @@
+#pragma once
+
+#include <cmath>
+#include <unordered_map>
+
+namespace pds::hashTable
+{
+    /**
+     * @brief Construct a new Perfect Hash Map< Key, Value, Check>:: Perfect Hash Map object,
+     * empty until build, with its storage drawn from the given memory resource
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Check
+     * @param resource
+     */
+    template <typename Key, typename Value, typename Check>
+    PerfectHashMap<Key, Value, Check>::PerfectHashMap(std::pmr::memory_resource* resource)
+        : _seed(0), _partitions(resource), _pilotDictionary(resource), _pilotIndices(resource), _pilotBits(0),
+          _indexBits(0), _remap(resource), _remapBits(0), _slots(resource) {}
+
+    /**
+     * @brief Builds the map from a range of key-value pairs, replacing its contents. Partitions
+     * are searched for pilots in parallel. A partition whose search fails, which is rare, has
+     * the whole build retried with a new hash seed.
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Check
+     * @tparam InputIt Iterator over pairs, e.g. std::pair<Key, Value> or a std::map entry
+     * @param first
+     * @param last
+     * @param numThreads 0 for one per hardware thread
+     * @return true
+     * @return false if a key repeats, leaving the map empty
+     */
+    template <typename Key, typename Value, typename Check>
+    template <typename InputIt>
+    bool PerfectHashMap<Key, Value, Check>::build(InputIt first, InputIt last, size_t numThreads)
+    {
+        std::vector<std::pair<Key, Value>> items;
+        for (; first != last; ++first)
+        {
+            items.emplace_back(first->first, first->second);
+        }
+
+        const size_t n = items.size();
+        const size_t threads = std::min(core::resolveThreadCount(numThreads), std::max<size_t>(n / PARTITION_SIZE, 1));
+        auto* resource = _slots.get_allocator().resource();
+        std::pmr::vector<uint64_t> hashes(n, resource);
+        std::pmr::vector<uint32_t> order(n, resource); // Items by partition
+        std::pmr::vector<uint64_t> partitionHashes(n, resource);
+        std::pmr::vector<uint32_t> slotOf(n, resource);
+        std::pmr::vector<uint64_t> pilots(resource);
+        std::pmr::vector<uint32_t> remap(resource);
+
+        for (size_t attempt = 0; attempt < MAX_ATTEMPTS; ++attempt)
+        {
+            _seed = core::mix64(attempt + 1);
+            core::parallelFor(threads, [&](size_t t) {
+                for (size_t i = t * n / threads; i < (t + 1) * n / threads; ++i)
+                {
+                    hashes[i] = hash(items[i].first);
+                }
+            });
+
+            // Lay out the partitions: keys, buckets and remap entries each as a prefix sum
+            const size_t numPartitions = std::max<size_t>((n + PARTITION_SIZE - 1) / PARTITION_SIZE, 1);
+            _partitions.assign(numPartitions, Partition{});
+            for (uint64_t h : hashes)
+            {
+                ++_partitions[partitionOf(h)].size;
+            }
+
+            uint64_t slots = 0;
+            uint64_t buckets = 0;
+            uint64_t remaps = 0;
+            for (Partition& partition : _partitions)
+            {
+                const double size = static_cast<double>(partition.size);
+                partition.slotOffset = slots;
+                partition.bucketOffset = buckets;
+                partition.remapOffset = remaps;
+                partition.tableSize = std::max<uint32_t>(static_cast<uint32_t>(std::ceil(size / LOAD)), 1);
+                partition.numBuckets = std::max<uint32_t>(
+                    static_cast<uint32_t>(std::ceil(BUCKET_DENSITY * size / std::log2(std::max(size, 2.0)))), 1);
+                partition.denseBuckets = std::max<uint32_t>(static_cast<uint32_t>(0.3 * partition.numBuckets), 1);
+                slots += partition.size;
+                buckets += partition.numBuckets;
+                remaps += partition.tableSize - partition.size;
+            }
+
+            std::pmr::vector<uint64_t> cursor(numPartitions, resource);
+            for (size_t p = 0; p < numPartitions; ++p)
+            {
+                cursor[p] = _partitions[p].slotOffset;
+            }
+            for (size_t i = 0; i < n; ++i)
+            {
+                const uint64_t at = cursor[partitionOf(hashes[i])]++;
+                order[at] = static_cast<uint32_t>(i);
+                partitionHashes[at] = hashes[i];
+            }
+
+            pilots.assign(buckets, 0);
+            remap.assign(remaps, 0);
+            std::atomic<size_t> nextPartition{0};
+            std::atomic<bool> failed{false};
+            core::parallelFor(threads, [&](size_t) {
+                for (size_t p = nextPartition++; p < numPartitions && !failed.load(std::memory_order_relaxed); p = nextPartition++)
+                {
+                    const Partition& partition = _partitions[p];
+                    if (!buildPartition(partition, partitionHashes.data() + partition.slotOffset,
+                                        pilots.data() + partition.bucketOffset, remap.data() + partition.remapOffset,
+                                        slotOf.data() + partition.slotOffset))
+                    {
+                        failed.store(true, std::memory_order_relaxed);
+                    }
+                }
+            });
+            if (failed.load())
+                continue;
+
+            encodePilots(pilots);
+            encodeRemap(remap);
+            _slots.assign(n, Slot{});
+            for (size_t p = 0; p < numPartitions; ++p)
+            {
+                const Partition& partition = _partitions[p];
+                for (uint64_t j = partition.slotOffset; j < partition.slotOffset + partition.size; ++j)
+                {
+                    auto& [key, value] = items[order[j]];
+                    Slot& slot = _slots[partition.slotOffset + slotOf[j]];
+                    if constexpr (STORES_KEYS)
+                    {
+                        slot.check = std::move(key);
+                    }
+                    else
+                    {
+                        slot.check = checkOf(key, partitionHashes[j]);
+                    }
+                    slot.value = std::move(value);
+                }
+            }
+            return true;
+        }
+
+        _partitions.clear();
+        _pilotDictionary.clear();
+        _pilotIndices.clear();
+        _remap.clear();
+        _slots.clear();
+        return false;
+    }
+
+    /**
+     * @brief Pointer to the value of a key, computed from one pilot and read from one slot
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Check
+     * @tparam K Key, or a key that hashes like it such as a std::string_view
+     * @param key
+     * @return const Value* nullptr if the key is absent; with fingerprints, an absent key
+     * matches another key's slot with probability 2^-bits
+     */
+    template <typename Key, typename Value, typename Check>
+    template <typename K>
+    const Value* PerfectHashMap<Key, Value, Check>::find(const K& key) const
+    {
+        static_assert(std::is_same_v<K, Key> || core::isTransparentKey<Key, K>, "K must be Key or hash like it");
+        if (_slots.empty())
+            return nullptr;
+
+        const uint64_t h = hash(key);
+        const Partition& partition = _partitions[partitionOf(h)];
+        if (partition.size == 0)
+            return nullptr;
+
+        const Slot& slot = _slots[partition.slotOffset + position(h, partition)];
+        if constexpr (STORES_KEYS)
+        {
+            return slot.check == key ? &slot.value : nullptr;
+        }
+        else
+        {
+            return slot.check == checkOf(key, h) ? &slot.value : nullptr;
+        }
+    }
+
+    template <typename Key, typename Value, typename Check>
+    std::optional<Value> PerfectHashMap<Key, Value, Check>::query(const Key& key) const
+    {
+        const Value* value = find(key);
+        return value == nullptr ? std::nullopt : std::make_optional(*value);
+    }
+
+    template <typename Key, typename Value, typename Check>
+    template <typename K, typename>
+    std::optional<Value> PerfectHashMap<Key, Value, Check>::query(const K& key) const
+    {
+        const Value* value = find(key);
+        return value == nullptr ? std::nullopt : std::make_optional(*value);
+    }
+
+    template <typename Key, typename Value, typename Check>
+    bool PerfectHashMap<Key, Value, Check>::contains(const Key& key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    template <typename Key, typename Value, typename Check>
+    template <typename K, typename>
+    bool PerfectHashMap<Key, Value, Check>::contains(const K& key) const
+    {
+        return find(key) != nullptr;
+    }
+
+    template <typename Key, typename Value, typename Check>
+    int32_t PerfectHashMap<Key, Value, Check>::getSize() const
+    {
+        return static_cast<int32_t>(_slots.size());
+    }
+
+    template <typename Key, typename Value, typename Check>
+    bool PerfectHashMap<Key, Value, Check>::isEmpty() const
+    {
+        return _slots.empty();
+    }
+
+    /**
+     * @brief Bits per key of the perfect hash function itself: pilots, dictionary, remap
+     * entries and partition table, excluding the slots
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Check
+     * @return double
+     */
+    template <typename Key, typename Value, typename Check>
+    double PerfectHashMap<Key, Value, Check>::getBitsPerKey() const
+    {
+        if (_slots.empty())
+            return 0.0;
+
+        const size_t bytes = _pilotIndices.size() * sizeof(uint64_t) + _pilotDictionary.size() * sizeof(uint64_t) +
+                             _remap.size() * sizeof(uint64_t) + _partitions.size() * sizeof(Partition);
+        return static_cast<double>(bytes * 8) / static_cast<double>(_slots.size());
+    }
+
+    template <typename Key, typename Value, typename Check>
+    template <typename K>
+    uint64_t PerfectHashMap<Key, Value, Check>::hash(const K& key) const
+    {
+        return core::mix64(static_cast<uint64_t>(core::transparentHash(key)) ^ _seed);
+    }
+
+    /**
+     * @brief Fingerprint of a key, from a remix of its hash so it is independent of the slot
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Check
+     * @tparam K
+     * @param key
+     * @param h
+     * @return Check
+     */
+    template <typename Key, typename Value, typename Check>
+    template <typename K>
+    Check PerfectHashMap<Key, Value, Check>::checkOf(const K& key, uint64_t h) const
+    {
+        if constexpr (STORES_KEYS)
+        {
+            return Check(key);
+        }
+        else
+        {
+            return static_cast<Check>(core::mix64(h ^ core::HASH_SEED_MULTIPLIER) >> 32);
+        }
+    }
+
+    template <typename Key, typename Value, typename Check>
+    size_t PerfectHashMap<Key, Value, Check>::partitionOf(uint64_t h) const
+    {
+        return static_cast<size_t>(((h >> 32) * _partitions.size()) >> 32);
+    }
+
+    /**
+     * @brief Bucket of a hash within its partition. 60% of keys go to the first 30% of buckets,
+     * so the large buckets are placed first while the table is nearly empty.
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Check
+     * @param h
+     * @param partition
+     * @return uint32_t
+     */
+    template <typename Key, typename Value, typename Check>
+    uint32_t PerfectHashMap<Key, Value, Check>::bucketOf(uint64_t h, const Partition& partition)
+    {
+        const uint64_t g = core::mix64(h);
+        const uint64_t sparseBuckets = partition.numBuckets - partition.denseBuckets;
+        if (static_cast<uint32_t>(g) < static_cast<uint32_t>(0.6 * 4294967296.0) || sparseBuckets == 0)
+            return static_cast<uint32_t>(((g >> 32) * partition.denseBuckets) >> 32);
+
+        return partition.denseBuckets + static_cast<uint32_t>(((g >> 32) * sparseBuckets) >> 32);
+    }
+
+    template <typename Key, typename Value, typename Check>
+    uint64_t PerfectHashMap<Key, Value, Check>::pilotHash(uint64_t pilot) const
+    {
+        return core::mix64(pilot ^ _seed);
+    }
+
+    /**
+     * @brief Slot of a hash within its partition: its bucket's pilot picks a position in the
+     * search table, and positions past the partition's size are remapped to the free slots below
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Check
+     * @param h
+     * @param partition
+     * @return uint64_t
+     */
+    template <typename Key, typename Value, typename Check>
+    uint64_t PerfectHashMap<Key, Value, Check>::position(uint64_t h, const Partition& partition) const
+    {
+        const uint64_t pilot = pilotOf(partition.bucketOffset + bucketOf(h, partition));
+        const uint64_t p = (h ^ pilotHash(pilot)) % partition.tableSize;
+        return p < partition.size ? p : unpack(_remap, partition.remapOffset + p - partition.size, _remapBits);
+    }
+
+    /**
+     * @brief Searches pilots for one partition, largest buckets first: each bucket takes the
+     * first pilot that sends all of its keys to distinct free positions
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Check
+     * @param partition
+     * @param hashes The partition's key hashes
+     * @param pilots The partition's pilots, written
+     * @param remap The partition's remap entries, written
+     * @param slotOf Slot of each key within the partition, written
+     * @return true
+     * @return false if two keys share a hash or a bucket exhausted MAX_PILOT
+     */
+    template <typename Key, typename Value, typename Check>
+    bool PerfectHashMap<Key, Value, Check>::buildPartition(const Partition& partition, const uint64_t* hashes, uint64_t* pilots,
+                                                            uint32_t* remap, uint32_t* slotOf) const
+    {
+        const uint32_t size = partition.size;
+        if (size == 0)
+            return true;
+
+        // Keys grouped by bucket, through a counting sort
+        std::vector<uint32_t> start(partition.numBuckets + 1, 0);
+        std::vector<uint32_t> bucketOfKey(size);
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            bucketOfKey[i] = bucketOf(hashes[i], partition);
+            ++start[bucketOfKey[i] + 1];
+        }
+        uint32_t largest = 0;
+        for (uint32_t b = 0; b < partition.numBuckets; ++b)
+        {
+            largest = std::max(largest, start[b + 1]);
+            start[b + 1] += start[b];
+        }
+        std::vector<uint32_t> keys(size);
+        std::vector<uint32_t> fill(start.begin(), start.end() - 1);
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            keys[fill[bucketOfKey[i]]++] = i;
+        }
+
+        // Buckets by decreasing size, again by counting sort
+        std::vector<std::vector<uint32_t>> bySize(largest + 1);
+        for (uint32_t b = 0; b < partition.numBuckets; ++b)
+        {
+            bySize[start[b + 1] - start[b]].push_back(b);
+        }
+
+        std::vector<uint64_t> taken((partition.tableSize + 63) / 64, 0);
+        std::vector<uint64_t> positions(largest);
+        for (uint32_t bucketSize = largest; bucketSize > 0; --bucketSize)
+        {
+            for (uint32_t b : bySize[bucketSize])
+            {
+                const uint32_t* members = keys.data() + start[b];
+                for (uint32_t i = 0; i < bucketSize; ++i)
+                {
+                    for (uint32_t j = 0; j < i; ++j)
+                    {
+                        if (hashes[members[i]] == hashes[members[j]])
+                            return false;
+                    }
+                }
+
+                uint64_t pilot = 0;
+                for (; pilot < MAX_PILOT; ++pilot)
+                {
+                    const uint64_t pilotBits = pilotHash(pilot);
+                    bool placed = true;
+                    for (uint32_t i = 0; i < bucketSize && placed; ++i)
+                    {
+                        const uint64_t p = (hashes[members[i]] ^ pilotBits) % partition.tableSize;
+                        placed = ((taken[p / 64] >> (p % 64)) & 1) == 0 &&
+                                 std::find(positions.begin(), positions.begin() + i, p) == positions.begin() + i;
+                        positions[i] = p;
+                    }
+                    if (placed)
+                        break;
+                }
+                if (pilot == MAX_PILOT)
+                    return false;
+
+                pilots[b] = pilot;
+                for (uint32_t i = 0; i < bucketSize; ++i)
+                {
+                    taken[positions[i] / 64] |= uint64_t{1} << (positions[i] % 64);
+                    slotOf[members[i]] = static_cast<uint32_t>(positions[i]);
+                }
+            }
+        }
+
+        // Positions past size move to the free slots below it, in order
+        uint32_t free = 0;
+        for (uint32_t p = size; p < partition.tableSize; ++p)
+        {
+            if (((taken[p / 64] >> (p % 64)) & 1) == 0)
+                continue;
+
+            while ((taken[free / 64] >> (free % 64)) & 1)
+            {
+                ++free;
+            }
+            remap[p - size] = free++;
+        }
+        for (uint32_t i = 0; i < size; ++i)
+        {
+            if (slotOf[i] >= size)
+            {
+                slotOf[i] = remap[slotOf[i] - size];
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @brief Stores the pilots as indices into a dictionary of their distinct values. Both are
+     * packed at the fewest bits that can hold them: most pilots are small and repeat, so the
+     * indices take a few bits per bucket and the dictionary a few bits per distinct pilot.
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Check
+     * @param pilots
+     */
+    template <typename Key, typename Value, typename Check>
+    void PerfectHashMap<Key, Value, Check>::encodePilots(const std::pmr::vector<uint64_t>& pilots)
+    {
+        std::unordered_map<uint64_t, uint64_t> indexOf;
+        std::vector<uint64_t> distinct;
+        for (uint64_t pilot : pilots)
+        {
+            if (indexOf.emplace(pilot, distinct.size()).second)
+            {
+                distinct.push_back(pilot);
+            }
+        }
+
+        _pilotBits = bitsFor(*std::max_element(distinct.begin(), distinct.end()) + 1);
+        _indexBits = bitsFor(distinct.size());
+        // One word of slack so a read never straddles past the end
+        _pilotDictionary.assign((distinct.size() * _pilotBits + 63) / 64 + 1, 0);
+        for (size_t i = 0; i < distinct.size(); ++i)
+        {
+            pack(_pilotDictionary, i, _pilotBits, distinct[i]);
+        }
+        _pilotIndices.assign((pilots.size() * _indexBits + 63) / 64 + 1, 0);
+        for (size_t b = 0; b < pilots.size(); ++b)
+        {
+            pack(_pilotIndices, b, _indexBits, indexOf[pilots[b]]);
+        }
+    }
+
+    /**
+     * @brief Packs the remap entries at the fewest bits that address a slot of the largest partition
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Check
+     * @param remap
+     */
+    template <typename Key, typename Value, typename Check>
+    void PerfectHashMap<Key, Value, Check>::encodeRemap(const std::pmr::vector<uint32_t>& remap)
+    {
+        uint32_t largest = 0;
+        for (const Partition& partition : _partitions)
+        {
+            largest = std::max(largest, partition.size);
+        }
+
+        _remapBits = bitsFor(largest);
+        _remap.assign((remap.size() * _remapBits + 63) / 64 + 1, 0);
+        for (size_t i = 0; i < remap.size(); ++i)
+        {
+            pack(_remap, i, _remapBits, remap[i]);
+        }
+    }
+
+    template <typename Key, typename Value, typename Check>
+    uint64_t PerfectHashMap<Key, Value, Check>::pilotOf(uint64_t bucket) const
+    {
+        return unpack(_pilotDictionary, unpack(_pilotIndices, bucket, _indexBits), _pilotBits);
+    }
+
+    /**
+     * @brief Fewest bits that can address count values, 0 for a single value
+     *
+     * @tparam Key
+     * @tparam Value
+     * @tparam Check
+     * @param count
+     * @return size_t
+     */
+    template <typename Key, typename Value, typename Check>
+    size_t PerfectHashMap<Key, Value, Check>::bitsFor(uint64_t count)
+    {
+        size_t bits = 0;
+        while ((uint64_t{1} << bits) < count)
+        {
+            ++bits;
+        }
+        return bits;
+    }
+
+    template <typename Key, typename Value, typename Check>
+    void PerfectHashMap<Key, Value, Check>::pack(std::pmr::vector<uint64_t>& words, size_t index, size_t bits, uint64_t value)
+    {
+        const size_t bit = index * bits;
+        words[bit / 64] |= value << (bit % 64);
+        if (bit % 64 + bits > 64)
+        {
+            words[bit / 64 + 1] |= value >> (64 - bit % 64);
+        }
+    }
+
+    template <typename Key, typename Value, typename Check>
+    uint64_t PerfectHashMap<Key, Value, Check>::unpack(const std::pmr::vector<uint64_t>& words, size_t index, size_t bits)
+    {
+        const size_t bit = index * bits;
+        uint64_t value = words[bit / 64] >> (bit % 64);
+        if (bit % 64 + bits > 64)
+        {
+            value |= words[bit / 64 + 1] << (64 - bit % 64);
+        }
+        return value & ((uint64_t{1} << bits) - 1);
+    }
+}
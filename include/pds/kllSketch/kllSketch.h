@@ -0,0 +1,77 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <utility>
+#include <memory_resource>
+
+#include "pds/core/common.h"
+
+namespace pds::quantile
+{
+    /**
+     * @brief KLL quantile sketch: answers approximate ranks and quantiles of a stream, e.g. the
+     * p99 of request latencies, in a few KB however long the stream is. Items enter a stack of
+     * compactors. Level h holds items of weight 2^h. When the sketch is full, the lowest level
+     * over its capacity is sorted and every other item, from a random offset, is promoted one
+     * level up with twice the weight. Capacities shrink geometrically by 2/3 below the top
+     * level, so about 3 * k items are retained, and the rank error falls roughly as 1 / k.
+     *
+     * @tparam T Ordered by operator<
+     */
+    template <typename T>
+    class KllSketch
+    {
+        public:
+        explicit KllSketch(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+        void init(uint16_t k = DEFAULT_K);
+
+        void insert(const T& item);
+        template <typename InputIt>
+        void insertRange(InputIt first, InputIt last);
+        void merge(const KllSketch& other);
+
+        std::optional<T> quantile(double q) const;
+        double rank(const T& item) const;
+        double getNormalizedRankError() const;
+
+        std::optional<T> getMin() const;
+        std::optional<T> getMax() const;
+        uint64_t getCount() const;
+        size_t getRetained() const;
+        size_t getNumLevels() const;
+        bool isEmpty() const;
+
+        static constexpr uint16_t DEFAULT_K = 200;
+
+        private:
+        static constexpr size_t MIN_WIDTH = 8; // Smallest capacity of any level
+        static constexpr double CAPACITY_DECAY = 2.0 / 3.0; // Ratio between the capacities of neighbouring levels
+
+        size_t levelCapacity(size_t level) const;
+        void updateCapacity();
+        void compress();
+        void compact(size_t level);
+        bool coinFlip();
+        void buildSortedView() const;
+
+        uint16_t _k;
+        uint64_t _n; // Items inserted
+        size_t _retained; // Items held across all levels
+        size_t _capacity; // Total capacity of the levels; reaching it triggers a compaction
+        std::optional<T> _min;
+        std::optional<T> _max;
+        uint64_t _rng; // xorshift state for the compaction offsets
+        std::pmr::vector<std::pmr::vector<T>> _levels; // Level h holds items of weight 2^h
+
+        mutable std::pmr::vector<std::pair<T, uint64_t>> _sortedView; // Items with their cumulative weight
+        mutable bool _viewValid;
+    };
+}
+
+#include "kllSketchImpl.h"
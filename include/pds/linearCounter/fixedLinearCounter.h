@@ -0,0 +1,46 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <optional>
+
+#include "pds/core/common.h"
+
+namespace pds::cardinality
+{
+    /**
+     * @brief Linear counter whose bitmap size is fixed at compile time, kept inline with no
+     * allocation so that many can be held by value in a flat array. A power-of-two Bits
+     * reduces the hash with a mask. Indices match those of a LinearCounter of the same size.
+     *
+     * A counter is its bitmap, Bits rounded up to 64-bit words, so counters of many shards or
+     * time buckets can be stored flat and combined word by word with merge().
+     *
+     * @tparam T
+     * @tparam Bits Bitmap size, m
+     */
+    template <typename T, size_t Bits>
+    class FixedLinearCounter
+    {
+        static_assert(Bits > 0, "FixedLinearCounter needs at least one bit");
+
+        public:
+        void insert(const T& item);
+        std::optional<float> estimate() const;
+        void merge(const FixedLinearCounter& other);
+        void clear();
+
+        int32_t getSize() const;
+        bool isEmpty() const;
+
+        private:
+        static constexpr size_t NUM_WORDS = (Bits + 63) / 64;
+        static constexpr bool POWER_OF_TWO = (Bits & (Bits - 1)) == 0;
+
+        std::array<uint64_t, NUM_WORDS> _words{};
+    };
+}
+
+#include "fixedLinearCounterImpl.h"
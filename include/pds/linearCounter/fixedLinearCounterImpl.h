@@ -0,0 +1,104 @@
+#pragma once
+
+namespace pds::cardinality
+{
+    /**
+     * @brief Insert an item by setting the bit its hash selects
+     *
+     * @tparam T
+     * @tparam Bits
+     * @param item
+     */
+    template <typename T, size_t Bits>
+    void FixedLinearCounter<T, Bits>::insert(const T& item)
+    {
+        const size_t hash = std::hash<T>{}(item);
+        size_t idx;
+        if constexpr (POWER_OF_TWO)
+        {
+            idx = hash & (Bits - 1);
+        }
+        else
+        {
+            idx = hash % Bits;
+        }
+        _words[idx / 64] |= uint64_t{1} << (idx % 64);
+    }
+
+    /**
+     * @brief Estimates the number of distinct items inserted, -m * ln(V / m) with V the zero bits
+     *
+     * @tparam T
+     * @tparam Bits
+     * @return std::optional<float> No estimate once every bit is set
+     */
+    template <typename T, size_t Bits>
+    std::optional<float> FixedLinearCounter<T, Bits>::estimate() const
+    {
+        const size_t V = Bits - static_cast<size_t>(getSize()); // number of zero bits
+        if (V == 0)
+            return std::nullopt;
+
+        return std::make_optional(-static_cast<float>(Bits) * std::log(static_cast<float>(V) / Bits));
+    }
+
+    /**
+     * @brief Merges another counter, which then estimates the distinct items of both streams
+     *
+     * @tparam T
+     * @tparam Bits
+     * @param other
+     */
+    template <typename T, size_t Bits>
+    void FixedLinearCounter<T, Bits>::merge(const FixedLinearCounter& other)
+    {
+        for (size_t i = 0; i < NUM_WORDS; ++i)
+        {
+            _words[i] |= other._words[i];
+        }
+    }
+
+    /**
+     * @brief Clears every bit
+     *
+     * @tparam T
+     * @tparam Bits
+     */
+    template <typename T, size_t Bits>
+    void FixedLinearCounter<T, Bits>::clear()
+    {
+        _words.fill(0);
+    }
+
+    /**
+     * @brief Number of set bits, counted on demand so the counter holds nothing but its bits
+     *
+     * @tparam T
+     * @tparam Bits
+     * @return int32_t
+     */
+    template <typename T, size_t Bits>
+    int32_t FixedLinearCounter<T, Bits>::getSize() const
+    {
+        int32_t count = 0;
+        for (uint64_t word : _words)
+        {
+            count += __builtin_popcountll(word);
+        }
+        return count;
+    }
+
+    /**
+     * @brief Checks if no item was inserted
+     *
+     * @tparam T
+     * @tparam Bits
+     * @return true
+     * @return false
+     */
+    template <typename T, size_t Bits>
+    bool FixedLinearCounter<T, Bits>::isEmpty() const
+    {
+        return getSize() == 0;
+    }
+}
@@ -1,12 +1,17 @@
 #pragma once
 
 #include <vector>
-#include <bitset>
+#include <algorithm>
 #include <cmath>
+#include <iterator>
 #include <optional>
 #include <string>
+#include <memory_resource>
 
 #include "pds/core/common.h"
+#include "pds/core/bitArray.h"
+#include "pds/core/concurrency.h"
+#include "pds/core/metrics.h"
 #include "linearCounterVisualiser.h"
 
 namespace pds::cardinality
@@ -17,22 +22,31 @@ namespace pds::cardinality
         friend class LinearCounterVisualiser<T>;
 
         public:
-        LinearCounter();
-        ~LinearCounter();
+        explicit LinearCounter(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
 
         void init(size_t bitmapSize = BIT_ARRAY_SIZE);
 
         void insert(const T& item);
+        template <typename InputIt>
+        void insertRange(InputIt first, InputIt last, size_t numThreads = 0);
+        bool merge(const LinearCounter& other);
         std::optional<float> estimate() const;
 
         int32_t getSize() const;
         bool isEmpty() const;
 
+        core::Stats stats() const;
+        void setMetricsSink(core::MetricsSink* sink, uint64_t publishInterval = 1024);
+        void setSnapshotWriter(core::SnapshotWriter* writer);
+
         private:
         size_t _m; // Bitmap size
         size_t _count;
-        std::bitset<BIT_ARRAY_SIZE>* _bitArray;
+        core::BitArray _bitArray;
         std::hash<T> _hasher;
+        mutable core::Metrics _metrics;
+
+        void publishMetrics() const;
 
         LinearCounterVisualiser<T> _visualiser;
     };
@@ -3,23 +3,21 @@
 namespace pds::cardinality
 {
     template <typename T>
-    LinearCounter<T>::LinearCounter()
-        : _m(BIT_ARRAY_SIZE), _count(0), _bitArray(new std::bitset<BIT_ARRAY_SIZE>()) {}
-
-    template <typename T>
-    LinearCounter<T>::~LinearCounter()
-    {
-        delete _bitArray;
-    }
+    LinearCounter<T>::LinearCounter(std::pmr::memory_resource* resource)
+        : _m(BIT_ARRAY_SIZE), _count(0), _bitArray(BIT_ARRAY_SIZE, resource) {}
 
     template <typename T>
     void LinearCounter<T>::init(size_t bitmapSize)
     {
         _m = bitmapSize;
         _count = 0;
-        _bitArray->reset();
-        _visualiser.logAction("[Init] Linear Counter initialized with bitmap size: " + std::to_string(_m));
-        _visualiser.logState(*this, std::nullopt, VisualContext::INIT);
+        _bitArray.resize(_m);
+        _metrics.reset();
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("[Init] Linear Counter initialized with bitmap size: " + std::to_string(_m));
+            _visualiser.logState(*this, std::nullopt, VisualContext::INIT);
+        }
     }
 
     template <typename T>
@@ -27,29 +25,141 @@ namespace pds::cardinality
     {
         size_t hash = _hasher(item);
         size_t idx = hash % _m;
-        if (!_bitArray->test(idx))
+        if (!_bitArray.test(idx))
         {
             ++_count;
-            _bitArray->set(idx);
+            _bitArray.set(idx);
+        }
+
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("[Insert] Item: " + toDisplayString(item) + " -> Index: " + std::to_string(idx));
+            _visualiser.logState(*this, idx, VisualContext::INSERT);
+        }
+
+        _metrics.recordInsert();
+        publishMetrics();
+    }
+
+    /**
+     * @brief Bulk insert of a range of items. Each thread sets bits in a bitmap of its own,
+     * the bitmaps are OR-ed together a slice of words per thread, and the count of set
+     * bits is recomputed by popcount, so nothing is shared while hashing.
+     *
+     * @tparam T
+     * @tparam InputIt
+     * @param first
+     * @param last
+     * @param numThreads 0 for one per hardware thread
+     */
+    template <typename T>
+    template <typename InputIt>
+    void LinearCounter<T>::insertRange(InputIt first, InputIt last, size_t numThreads)
+    {
+        if constexpr (!std::is_base_of_v<std::random_access_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>)
+        {
+            // Single pass iterators are buffered so that the items can be split between threads
+            const std::vector<T> items(first, last);
+            insertRange(items.begin(), items.end(), numThreads);
         }
+        else
+        {
+            const size_t numItems = static_cast<size_t>(std::distance(first, last));
+            const size_t threads = std::max<size_t>(1, std::min(core::resolveThreadCount(numThreads), numItems));
+            const size_t slice = (numItems + threads - 1) / threads;
+
+            std::vector<core::BitArray> local;
+            local.reserve(threads);
+            for (size_t t = 0; t < threads; ++t)
+            {
+                local.emplace_back(_m, _bitArray.resource());
+            }
+
+            core::parallelFor(threads, [&](size_t t) {
+                const size_t begin = std::min(numItems, t * slice);
+                const size_t end = std::min(numItems, begin + slice);
+                for (size_t i = begin; i < end; ++i)
+                {
+                    local[t].set(_hasher(first[i]) % _m);
+                }
+            });
+
+            const size_t numWords = _bitArray.numWords();
+            const size_t wordsPerThread = (numWords + threads - 1) / threads;
+            uint64_t* words = _bitArray.data();
+            core::parallelFor(threads, [&](size_t t) {
+                const size_t begin = std::min(numWords, t * wordsPerThread);
+                const size_t end = std::min(numWords, begin + wordsPerThread);
+                for (const auto& bitmap : local)
+                {
+                    const uint64_t* localWords = bitmap.data();
+                    for (size_t w = begin; w < end; ++w)
+                    {
+                        words[w] |= localWords[w];
+                    }
+                }
+            });
 
-        _visualiser.logAction("[Insert] Item: " + item + " -> Index: " + std::to_string(idx));
-        _visualiser.logState(*this, idx, VisualContext::INSERT);
+            _count = _bitArray.recount();
+
+            if constexpr (VISUALISE)
+            {
+                _visualiser.logAction("[Bulk Insert] " + std::to_string(numItems) + " items on " + std::to_string(threads) + " threads");
+                _visualiser.logState(*this, std::nullopt, VisualContext::INSERT);
+            }
+
+            _metrics.recordInsert(numItems);
+            publishMetrics();
+        }
+    }
+
+    /**
+     * @brief Merges a counter of the same bitmap size into this one, which then
+     * estimates the number of distinct items in the union of both streams
+     *
+     * @tparam T
+     * @param other
+     * @return true
+     * @return false if the bitmap sizes differ
+     */
+    template <typename T>
+    bool LinearCounter<T>::merge(const LinearCounter& other)
+    {
+        if (other._m != _m)
+            return false;
+
+        _bitArray |= other._bitArray;
+        _count = _bitArray.count();
+
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("[Merge] Bitmaps combined, " + std::to_string(_count) + " bits set");
+            _visualiser.logState(*this, std::nullopt, VisualContext::INSERT);
+        }
+        return true;
     }
 
     template <typename T>
     std::optional<float> LinearCounter<T>::estimate() const
     {
-        size_t V = _m - _bitArray->count(); // number of zero bits
+        size_t V = _m - _bitArray.count(); // number of zero bits, maintained by the bit array
+        _metrics.recordQuery();
+        publishMetrics();
         if (V == 0)
         {
-            _visualiser.logAction("[Estimate] All bits are set. Cannot estimate.");
+            if constexpr (VISUALISE)
+            {
+                _visualiser.logAction("[Estimate] All bits are set. Cannot estimate.");
+            }
             return std::nullopt;
         }
 
         float n = -static_cast<float>(_m) * std::log(static_cast<float>(V) / _m);
-        _visualiser.logAction("[Estimate] Unique items estimated: " + std::to_string(n));
-        _visualiser.logState(*this, std::nullopt, VisualContext::QUERY);
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("[Estimate] Unique items estimated: " + std::to_string(n));
+            _visualiser.logState(*this, std::nullopt, VisualContext::QUERY);
+        }
         return std::make_optional(n);
     }
 
@@ -64,4 +174,52 @@ namespace pds::cardinality
     {
         return _count == 0;
     }
-}
\ No newline at end of file
+
+    /**
+     * @brief Snapshot of the operation counters, estimate() calls counting as queries, and the fraction of bits set
+     *
+     * @tparam T
+     * @return core::Stats
+     */
+    template <typename T>
+    core::Stats LinearCounter<T>::stats() const
+    {
+        return _metrics.snapshot(_m == 0 ? 0.0f : static_cast<float>(_bitArray.count()) / static_cast<float>(_m));
+    }
+
+    /**
+     * @brief Attaches a sink that receives stats() every publishInterval operations, or detaches it given nullptr.
+     * Has no effect unless PDS_METRICS is 1.
+     *
+     * @tparam T
+     * @param sink
+     * @param publishInterval
+     */
+    template <typename T>
+    void LinearCounter<T>::setMetricsSink(core::MetricsSink* sink, uint64_t publishInterval)
+    {
+        _metrics.setSink(sink, publishInterval);
+    }
+
+    /**
+     * @brief Has the visualiser emit sampled, run-length encoded snapshots to the writer
+     * instead of drawing every operation to std::cout. Only has an effect while PDS_VISUALISE is 1.
+     *
+     * @tparam T
+     * @param writer
+     */
+    template <typename T>
+    void LinearCounter<T>::setSnapshotWriter(core::SnapshotWriter* writer)
+    {
+        _visualiser.setSnapshotWriter(writer);
+    }
+
+    template <typename T>
+    void LinearCounter<T>::publishMetrics() const
+    {
+        if (_metrics.publishDue())
+        {
+            _metrics.publish("LinearCounter", stats());
+        }
+    }
+}
@@ -4,6 +4,7 @@
 #include <iomanip>
 #include <optional>
 #include "pds/core/common.h"
+#include "pds/core/snapshotWriter.h"
 
 namespace pds::cardinality
 {
@@ -14,8 +15,23 @@ namespace pds::cardinality
     class LinearCounterVisualiser
     {
     public:
+        /**
+         * @brief Sends sampled snapshots to the writer instead of drawing to std::cout, or draws again given nullptr
+         *
+         * @param writer
+         */
+        void setSnapshotWriter(core::SnapshotWriter* writer)
+        {
+            _writer = writer;
+        }
+
         void logAction(const std::string& action) const
         {
+            if (_writer != nullptr)
+            {
+                _lastAction = action;
+                return;
+            }
             std::cout << action << "\n";
         }
 
@@ -23,6 +39,13 @@ namespace pds::cardinality
                       std::optional<size_t> highlight = std::nullopt,
                       pds::VisualContext ctx = pds::VisualContext::UNKNOWN) const
         {
+            if (_writer != nullptr)
+            {
+                _writer->capture("LinearCounter", ctx, highlight, _lastAction, counter._m,
+                                 [&counter](size_t i) { return counter._bitArray.test(i); });
+                return;
+            }
+
             std::cout << "\n[Bit Array State] Context: ";
             switch (ctx)
             {
@@ -36,7 +59,7 @@ namespace pds::cardinality
             constexpr size_t rowSize = 32;
             for (size_t i = 0; i < counter._m; ++i)
             {
-                bool isSet = counter._bitArray->test(i);
+                bool isSet = counter._bitArray.test(i);
                 if (highlight.has_value() && highlight.value() == i)
                 {
                     std::cout << "\033[44m"; // Blue background
@@ -63,5 +86,9 @@ namespace pds::cardinality
 
             std::cout << "\n";
         }
+
+    private:
+        core::SnapshotWriter* _writer = nullptr;
+        mutable std::string _lastAction; // Attached to the next snapshot
     };
 }
\ No newline at end of file
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <utility>
+#include <memory_resource>
+
+#include "pds/core/common.h"
+#include "pds/core/hash.h"
+#include "pds/hashTable/fingerprintHashTable.h"
+#include "minHash.h"
+
+namespace pds::similarity
+{
+    /**
+     * @brief Locality sensitive hashing index over MinHash signatures. Each signature is cut into
+     * numBands bands of rowsPerBand minimums, and an item is filed under the hash of each band.
+     * Two items become candidates when any band matches. That happens with probability
+     * 1 - (1 - J^r)^b, a steep S-curve in the Jaccard similarity J around (1 / b)^(1 / r). So a
+     * query looks at b posting lists rather than every item.
+     *
+     * Bands map to posting lists through a FingerprintHashTable from band hash to list index,
+     * which is rebuilt at twice the size when it passes 3/4 full.
+     *
+     * @tparam Id Identifier of an indexed item, ordered by operator<
+     */
+    template <typename Id = uint64_t>
+    class LshIndex
+    {
+        public:
+        explicit LshIndex(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+        void init(size_t numBands = 16, size_t rowsPerBand = 8, size_t expectedItems = 1024);
+
+        bool insert(const Id& id, const Signature& signature);
+        std::pmr::vector<Id> query(const Signature& signature) const;
+        std::pmr::vector<std::pair<Id, Id>> candidatePairs() const;
+
+        double getThreshold() const;
+        size_t getSize() const;
+        size_t getNumBuckets() const;
+        bool isEmpty() const;
+
+        private:
+        uint64_t bandKey(const Signature& signature, size_t band) const;
+        void grow();
+
+        size_t _bands;
+        size_t _rows;
+        size_t _size; // Items indexed
+        size_t _capacity; // Slots in _buckets
+        hashTable::FingerprintHashTable<uint64_t, uint32_t> _buckets; // Band hash -> index into _postings
+        std::pmr::vector<uint64_t> _bucketKeys; // Band hash of each posting list, to rebuild _buckets
+        std::pmr::vector<std::pmr::vector<Id>> _postings;
+    };
+}
+
+#include "lshIndexImpl.h"
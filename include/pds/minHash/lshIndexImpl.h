@@ -0,0 +1,200 @@
+#pragma once
+
+namespace pds::similarity
+{
+    /**
+     * @brief Construct a new Lsh Index< Id>:: Lsh Index object
+     * with its buckets and posting lists drawn from the given memory resource
+     *
+     * @tparam Id
+     * @param resource
+     */
+    template <typename Id>
+    LshIndex<Id>::LshIndex(std::pmr::memory_resource* resource)
+        : _bands(0), _rows(0), _size(0), _capacity(0), _buckets(resource), _bucketKeys(resource), _postings(resource)
+    {
+        init();
+    }
+
+    /**
+     * @brief Initialise an empty index. Signatures need at least numBands * rowsPerBand
+     * minimums; more bands raise recall, more rows raise precision.
+     *
+     * @tparam Id
+     * @param numBands
+     * @param rowsPerBand
+     * @param expectedItems Sizes the bucket table, which grows past it as needed
+     */
+    template <typename Id>
+    void LshIndex<Id>::init(size_t numBands, size_t rowsPerBand, size_t expectedItems)
+    {
+        _bands = std::max<size_t>(numBands, 1);
+        _rows = std::max<size_t>(rowsPerBand, 1);
+        _size = 0;
+        _capacity = std::max<size_t>(expectedItems * _bands * 2, 16);
+        _buckets.init(_capacity);
+        _bucketKeys.clear();
+        _postings.clear();
+    }
+
+    /**
+     * @brief Indexes an item under each band of its signature
+     *
+     * @tparam Id
+     * @param id
+     * @param signature
+     * @return true
+     * @return false if the signature is shorter than numBands * rowsPerBand
+     */
+    template <typename Id>
+    bool LshIndex<Id>::insert(const Id& id, const Signature& signature)
+    {
+        if (signature.size() < _bands * _rows)
+            return false;
+
+        for (size_t band = 0; band < _bands; ++band)
+        {
+            const uint64_t key = bandKey(signature, band);
+            if (auto posting = _buckets.query(key))
+            {
+                _postings[*posting].push_back(id);
+                continue;
+            }
+
+            if ((_postings.size() + 1) * 4 > _capacity * 3)
+            {
+                grow();
+            }
+            _buckets.insert(key, static_cast<uint32_t>(_postings.size()));
+            _bucketKeys.push_back(key);
+            _postings.emplace_back().push_back(id);
+        }
+
+        ++_size;
+        return true;
+    }
+
+    /**
+     * @brief Items sharing at least one band with the signature, each listed once
+     *
+     * @tparam Id
+     * @param signature
+     * @return std::pmr::vector<Id>
+     */
+    template <typename Id>
+    std::pmr::vector<Id> LshIndex<Id>::query(const Signature& signature) const
+    {
+        std::pmr::vector<Id> candidates(_postings.get_allocator().resource());
+        if (signature.size() < _bands * _rows)
+            return candidates;
+
+        for (size_t band = 0; band < _bands; ++band)
+        {
+            if (auto posting = _buckets.query(bandKey(signature, band)))
+            {
+                const auto& ids = _postings[*posting];
+                candidates.insert(candidates.end(), ids.begin(), ids.end());
+            }
+        }
+
+        std::sort(candidates.begin(), candidates.end());
+        candidates.erase(std::unique(candidates.begin(), candidates.end()), candidates.end());
+        return candidates;
+    }
+
+    /**
+     * @brief Every pair of items sharing at least one band, each listed once with the smaller id
+     * first. The cost is in the size of the posting lists, not the square of the number of items.
+     *
+     * @tparam Id
+     * @return std::pmr::vector<std::pair<Id, Id>>
+     */
+    template <typename Id>
+    std::pmr::vector<std::pair<Id, Id>> LshIndex<Id>::candidatePairs() const
+    {
+        std::pmr::vector<std::pair<Id, Id>> pairs(_postings.get_allocator().resource());
+        for (const auto& ids : _postings)
+        {
+            for (size_t i = 0; i < ids.size(); ++i)
+            {
+                for (size_t j = i + 1; j < ids.size(); ++j)
+                {
+                    if (ids[i] < ids[j])
+                        pairs.emplace_back(ids[i], ids[j]);
+                    else if (ids[j] < ids[i])
+                        pairs.emplace_back(ids[j], ids[i]);
+                }
+            }
+        }
+
+        std::sort(pairs.begin(), pairs.end());
+        pairs.erase(std::unique(pairs.begin(), pairs.end()), pairs.end());
+        return pairs;
+    }
+
+    /**
+     * @brief Jaccard similarity at which two items are candidates with probability about one half
+     *
+     * @tparam Id
+     * @return double
+     */
+    template <typename Id>
+    double LshIndex<Id>::getThreshold() const
+    {
+        return std::pow(1.0 / static_cast<double>(_bands), 1.0 / static_cast<double>(_rows));
+    }
+
+    template <typename Id>
+    size_t LshIndex<Id>::getSize() const
+    {
+        return _size;
+    }
+
+    template <typename Id>
+    size_t LshIndex<Id>::getNumBuckets() const
+    {
+        return _postings.size();
+    }
+
+    template <typename Id>
+    bool LshIndex<Id>::isEmpty() const
+    {
+        return _size == 0;
+    }
+
+    /**
+     * @brief Hash of one band's minimums, seeded by the band so equal rows in different bands
+     * land in different buckets
+     *
+     * @tparam Id
+     * @param signature
+     * @param band
+     * @return uint64_t
+     */
+    template <typename Id>
+    uint64_t LshIndex<Id>::bandKey(const Signature& signature, size_t band) const
+    {
+        uint64_t h = core::mix64(band + 1);
+        for (size_t r = 0; r < _rows; ++r)
+        {
+            h = core::mix64(h ^ signature[band * _rows + r]);
+        }
+        return h;
+    }
+
+    /**
+     * @brief Rebuilds the bucket table at twice the size from the band hash of every posting list
+     *
+     * @tparam Id
+     */
+    template <typename Id>
+    void LshIndex<Id>::grow()
+    {
+        _capacity *= 2;
+        _buckets.init(_capacity);
+        for (size_t i = 0; i < _bucketKeys.size(); ++i)
+        {
+            _buckets.insert(_bucketKeys[i], static_cast<uint32_t>(i));
+        }
+    }
+}
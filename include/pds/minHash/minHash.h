@@ -0,0 +1,80 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <iterator>
+#include <memory_resource>
+#include <type_traits>
+
+#include "pds/core/common.h"
+#include "pds/core/hash.h"
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define PDS_MINHASH_X86 1
+#include <immintrin.h>
+#else
+#define PDS_MINHASH_X86 0
+#endif
+
+namespace pds::similarity
+{
+    /**
+     * @brief One 32-bit minimum per hash function, or per bin with one-permutation hashing
+     */
+    using Signature = std::pmr::vector<uint32_t>;
+
+    /**
+     * @brief Signature reduced to the low bits bits of each minimum, packed into words
+     */
+    struct PackedSignature
+    {
+        uint8_t bits = 0;
+        size_t size = 0; // Number of minimums
+        std::pmr::vector<uint64_t> words;
+    };
+
+    enum class MinHashScheme : uint8_t
+    {
+        K_PERMUTATIONS, // k hash functions per element: the classic estimator, k multiplies per element
+        ONE_PERMUTATION // One hash per element split over k bins, empty bins densified: one multiply per element
+    };
+
+    /**
+     * @brief MinHash signatures of sets, e.g. of the shingles of a document, whose fraction of
+     * equal positions estimates the Jaccard similarity of the sets. With k permutations each
+     * element is hashed once, then remixed by k seeded 32-bit multiply-xorshift functions laid
+     * out so that eight seeds are processed per AVX2 instruction, chosen at runtime.
+     *
+     * @tparam T Element type, e.g. std::string shingles
+     */
+    template <typename T>
+    class MinHash
+    {
+        public:
+        explicit MinHash(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+        void init(size_t numHashes = 128, MinHashScheme scheme = MinHashScheme::K_PERMUTATIONS, uint64_t seed = 0);
+
+        template <typename InputIt>
+        Signature signature(InputIt first, InputIt last) const;
+        PackedSignature compress(const Signature& signature, uint8_t bits) const;
+
+        static double similarity(const Signature& a, const Signature& b);
+        static double similarity(const PackedSignature& a, const PackedSignature& b);
+
+        size_t getNumHashes() const;
+        MinHashScheme getScheme() const;
+
+        static constexpr uint32_t EMPTY = ~uint32_t{0}; // Minimum of an empty set
+
+        private:
+        size_t _k;
+        MinHashScheme _scheme;
+        std::pmr::vector<uint32_t> _multipliers; // Odd, one per hash function
+        std::pmr::vector<uint32_t> _offsets;
+    };
+}
+
+#include "minHashImpl.h"
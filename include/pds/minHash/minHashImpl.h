@@ -0,0 +1,289 @@
+#pragma once
+
+namespace pds::similarity
+{
+    namespace detail
+    {
+        /**
+         * @brief Murmur3 finaliser, a bijection on 32-bit values built from multiplies and xorshifts
+         */
+        inline uint32_t fmix32(uint32_t h)
+        {
+            h ^= h >> 16;
+            h *= 0x85ebca6bu;
+            h ^= h >> 13;
+            h *= 0xc2b2ae35u;
+            h ^= h >> 16;
+            return h;
+        }
+
+        /**
+         * @brief signature[j] = min over elements x of fmix32(x * multipliers[j] + offsets[j]).
+         * Written seed-major so each signature entry stays in a register across the elements.
+         */
+        inline void minHashScalar(const uint32_t* elements, size_t numElements, const uint32_t* multipliers,
+                                  const uint32_t* offsets, uint32_t* signature, size_t begin, size_t end)
+        {
+            for (size_t j = begin; j < end; ++j)
+            {
+                uint32_t minimum = ~uint32_t{0};
+                for (size_t i = 0; i < numElements; ++i)
+                {
+                    minimum = std::min(minimum, fmix32(elements[i] * multipliers[j] + offsets[j]));
+                }
+                signature[j] = minimum;
+            }
+        }
+
+#if PDS_MINHASH_X86
+        /**
+         * @brief Eight hash functions per 256-bit vector, as minHashScalar
+         */
+        __attribute__((target("avx2"))) inline void minHashAvx2(const uint32_t* elements, size_t numElements,
+                                                                 const uint32_t* multipliers, const uint32_t* offsets,
+                                                                 uint32_t* signature, size_t numHashes)
+        {
+            const __m256i c1 = _mm256_set1_epi32(static_cast<int>(0x85ebca6bu));
+            const __m256i c2 = _mm256_set1_epi32(static_cast<int>(0xc2b2ae35u));
+
+            size_t j = 0;
+            for (; j + 8 <= numHashes; j += 8)
+            {
+                const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(multipliers + j));
+                const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(offsets + j));
+                __m256i minimum = _mm256_set1_epi32(-1);
+                for (size_t i = 0; i < numElements; ++i)
+                {
+                    __m256i h = _mm256_add_epi32(_mm256_mullo_epi32(_mm256_set1_epi32(static_cast<int>(elements[i])), a), b);
+                    h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 16));
+                    h = _mm256_mullo_epi32(h, c1);
+                    h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 13));
+                    h = _mm256_mullo_epi32(h, c2);
+                    h = _mm256_xor_si256(h, _mm256_srli_epi32(h, 16));
+                    minimum = _mm256_min_epu32(minimum, h);
+                }
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(signature + j), minimum);
+            }
+            minHashScalar(elements, numElements, multipliers, offsets, signature, j, numHashes);
+        }
+#endif
+
+        inline void minHash(const uint32_t* elements, size_t numElements, const uint32_t* multipliers,
+                            const uint32_t* offsets, uint32_t* signature, size_t numHashes)
+        {
+#if PDS_MINHASH_X86
+            static const bool avx2 = [] {
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("avx2") != 0;
+            }();
+
+            if (avx2)
+            {
+                minHashAvx2(elements, numElements, multipliers, offsets, signature, numHashes);
+                return;
+            }
+#endif
+            minHashScalar(elements, numElements, multipliers, offsets, signature, 0, numHashes);
+        }
+    }
+
+    /**
+     * @brief Construct a new Min Hash< T>:: Min Hash object
+     * with its seeds and signatures drawn from the given memory resource
+     *
+     * @tparam T
+     * @param resource
+     */
+    template <typename T>
+    MinHash<T>::MinHash(std::pmr::memory_resource* resource)
+        : _k(0), _scheme(MinHashScheme::K_PERMUTATIONS), _multipliers(resource), _offsets(resource)
+    {
+        init();
+    }
+
+    /**
+     * @brief Sets the signature length and scheme. Signatures can only be compared when made
+     * with the same parameters and seed. The standard error of a similarity is about
+     * sqrt(J (1 - J) / numHashes).
+     *
+     * @tparam T
+     * @param numHashes
+     * @param scheme
+     * @param seed
+     */
+    template <typename T>
+    void MinHash<T>::init(size_t numHashes, MinHashScheme scheme, uint64_t seed)
+    {
+        _k = std::max<size_t>(numHashes, 1);
+        _scheme = scheme;
+        _multipliers.resize(_k);
+        _offsets.resize(_k);
+        for (size_t j = 0; j < _k; ++j)
+        {
+            const uint64_t bits = core::mix64(seed + (j + 1) * core::HASH_SEED_MULTIPLIER);
+            _multipliers[j] = static_cast<uint32_t>(bits) | 1;
+            _offsets[j] = static_cast<uint32_t>(bits >> 32);
+        }
+    }
+
+    /**
+     * @brief Signature of the set of elements in [first, last); repeated elements count once.
+     * Keeps its working buffer local, so threads may share one MinHash.
+     *
+     * @tparam T
+     * @tparam InputIt
+     * @param first
+     * @param last
+     * @return Signature Drawn from this MinHash's memory resource
+     */
+    template <typename T>
+    template <typename InputIt>
+    Signature MinHash<T>::signature(InputIt first, InputIt last) const
+    {
+        Signature result(_k, EMPTY, _multipliers.get_allocator().resource());
+
+        if (_scheme == MinHashScheme::K_PERMUTATIONS)
+        {
+            std::pmr::vector<uint32_t> elementHashes(result.get_allocator().resource());
+            if constexpr (std::is_base_of_v<std::forward_iterator_tag, typename std::iterator_traits<InputIt>::iterator_category>)
+            {
+                elementHashes.reserve(static_cast<size_t>(std::distance(first, last)));
+            }
+            for (; first != last; ++first)
+            {
+                const uint64_t h = core::mixedHash(*first);
+                elementHashes.push_back(static_cast<uint32_t>(h ^ (h >> 32)));
+            }
+            if (!elementHashes.empty())
+            {
+                detail::minHash(elementHashes.data(), elementHashes.size(), _multipliers.data(), _offsets.data(),
+                                result.data(), _k);
+            }
+            return result;
+        }
+
+        // One permutation: the high half of the hash picks the bin, the low half competes in it
+        bool any = false;
+        for (; first != last; ++first)
+        {
+            const uint64_t h = core::mixedHash(*first);
+            const size_t bin = static_cast<size_t>(((h >> 32) * _k) >> 32);
+            result[bin] = std::min(result[bin], static_cast<uint32_t>(h));
+            any = true;
+        }
+        if (!any)
+            return result;
+
+        // Densify: an empty bin borrows the next non-empty bin's value, remixed by the distance,
+        // so that two sets agree on it exactly when they agree on the bin it borrowed from
+        for (size_t i = 0; i < _k; ++i)
+        {
+            if (result[i] != EMPTY)
+                continue;
+
+            size_t distance = 1;
+            while (result[(i + distance) % _k] == EMPTY)
+            {
+                ++distance;
+            }
+            result[i] = detail::fmix32(result[(i + distance) % _k] + static_cast<uint32_t>(distance * core::HASH_SEED_MULTIPLIER));
+        }
+        return result;
+    }
+
+    /**
+     * @brief b-bit MinHash: keeps only the low bits of each minimum. One bit per minimum is 32
+     * times smaller, at the cost of needing more minimums for the same accuracy at low similarity.
+     *
+     * @tparam T
+     * @param signature
+     * @param bits Rounded down to 1, 2, 4, 8, 16 or 32, so no minimum straddles two words
+     * @return PackedSignature
+     */
+    template <typename T>
+    PackedSignature MinHash<T>::compress(const Signature& signature, uint8_t bits) const
+    {
+        uint8_t width = 1;
+        while (width * 2 <= std::min<uint8_t>(bits, 32))
+        {
+            width *= 2;
+        }
+
+        PackedSignature packed{width, signature.size(), std::pmr::vector<uint64_t>(_multipliers.get_allocator().resource())};
+        packed.words.assign((signature.size() * width + 63) / 64, 0);
+        const uint64_t mask = width == 64 ? ~uint64_t{0} : (uint64_t{1} << width) - 1;
+        for (size_t i = 0; i < signature.size(); ++i)
+        {
+            const size_t bit = i * width;
+            packed.words[bit / 64] |= (signature[i] & mask) << (bit % 64);
+        }
+        return packed;
+    }
+
+    /**
+     * @brief Estimated Jaccard similarity: the fraction of positions where the signatures agree
+     *
+     * @tparam T
+     * @param a
+     * @param b
+     * @return double 0 if the signatures differ in length
+     */
+    template <typename T>
+    double MinHash<T>::similarity(const Signature& a, const Signature& b)
+    {
+        if (a.size() != b.size() || a.empty())
+            return 0.0;
+
+        size_t matches = 0;
+        for (size_t i = 0; i < a.size(); ++i)
+        {
+            matches += a[i] == b[i];
+        }
+        return static_cast<double>(matches) / static_cast<double>(a.size());
+    }
+
+    /**
+     * @brief Estimated Jaccard similarity from b-bit signatures. Unrelated minimums still agree on
+     * b bits with probability 2^-b, which is corrected for. Mismatching lanes are counted a word
+     * at a time by folding each lane's xor into its lowest bit.
+     *
+     * @tparam T
+     * @param a
+     * @param b
+     * @return double 0 if the signatures differ in length or width
+     */
+    template <typename T>
+    double MinHash<T>::similarity(const PackedSignature& a, const PackedSignature& b)
+    {
+        if (a.bits != b.bits || a.size != b.size || a.size == 0 || a.words.size() != b.words.size())
+            return 0.0;
+
+        const uint64_t laneLowBits = ~uint64_t{0} / ((uint64_t{1} << a.bits) - 1);
+        size_t mismatches = 0;
+        for (size_t w = 0; w < a.words.size(); ++w)
+        {
+            uint64_t differing = a.words[w] ^ b.words[w];
+            for (size_t shift = 1; shift < a.bits; shift <<= 1)
+            {
+                differing |= differing >> shift;
+            }
+            mismatches += static_cast<size_t>(__builtin_popcountll(differing & laneLowBits));
+        }
+
+        const double agreement = 1.0 - static_cast<double>(mismatches) / static_cast<double>(a.size);
+        const double chance = std::ldexp(1.0, -static_cast<int>(a.bits));
+        return std::clamp((agreement - chance) / (1.0 - chance), 0.0, 1.0);
+    }
+
+    template <typename T>
+    size_t MinHash<T>::getNumHashes() const
+    {
+        return _k;
+    }
+
+    template <typename T>
+    MinHashScheme MinHash<T>::getScheme() const
+    {
+        return _scheme;
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+#include <optional>
+#include <cmath>
+#include <limits>
+#include <memory_resource>
+
+#include "pds/core/common.h"
+#include "pds/core/hash.h"
+#include "slidingWindowBloomFilterVisualiser.h"
+
+namespace pds::bloomFilter
+{
+    /**
+     * @brief Bloom filter answering "seen within the last window" using rotating generations.
+     * The window is split into slices, each generation holds the items of one slice, and a
+     * spare generation is cleared a few words per operation so that expiry never needs to
+     * know the keys and its cost is amortised over inserts.
+     *
+     * An item is reported for at least `window` after its insertion and never after
+     * `window + window / (generations - 1)`.
+     *
+     * @tparam T
+     */
+    template <typename T>
+    class SlidingWindowBloomFilter
+    {
+        friend class SlidingWindowBloomFilterVisualiser<T>;
+
+        public:
+        using Clock = std::chrono::steady_clock;
+        using TimePoint = Clock::time_point;
+        using Duration = Clock::duration;
+
+        explicit SlidingWindowBloomFilter(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+        void init(size_t numHashFunctions, Duration window, size_t generations = 4,
+                  size_t bitsPerGeneration = BIT_ARRAY_SIZE);
+
+        void insert(const T& item, TimePoint now);
+        std::optional<float> query(const T& item, TimePoint now) const;
+
+        int32_t getLoadFactor() const;
+        int32_t getSize() const;
+        bool isEmpty() const;
+
+        private:
+        struct Generation
+        {
+            int64_t slice; // Index of the time slice this generation holds
+            int32_t count; // Number of set bits
+        };
+
+        static constexpr size_t CLEAR_WORDS_PER_OP = 8; // Words of the spare cleared per insert
+        static constexpr int64_t EXPIRED_SLICE = std::numeric_limits<int64_t>::min() / 2;
+
+        int64_t sliceOf(TimePoint now) const;
+        bool isLive(const Generation& generation, int64_t currentSlice) const;
+        bool testBit(size_t generation, size_t idx) const;
+        void advance(int64_t slice);
+        void clearSpare(size_t words);
+        size_t spareIndex() const;
+
+        float computeFalsePositiveProbability(int64_t currentSlice) const
+        {
+            if (_k == 0)
+                return 0.0f;
+
+            // The item is reported if any live generation reports it
+            float notFalsePositive = 1.0f;
+            for (const auto& generation : _generations)
+            {
+                if (!isLive(generation, currentSlice) || generation.count == 0)
+                    continue;
+
+                float fillRatio = static_cast<float>(generation.count) / static_cast<float>(_m);
+                notFalsePositive *= 1.0f - std::pow(fillRatio, static_cast<float>(_k));
+            }
+
+            return 1.0f - notFalsePositive;
+        }
+
+        size_t _k; // Number of hash functions
+        size_t _m; // Bits per generation
+        size_t _liveGenerations; // Generations covering the window
+        Duration _slice; // Time covered by one generation
+        size_t _head; // Index of the generation receiving inserts
+        size_t _wordsPerGeneration;
+        size_t _clearCursor; // Next word of the spare generation to clear
+        std::pmr::vector<Generation> _generations; // Ring of live generations plus one spare
+        std::pmr::vector<uint64_t> _words; // Bit arrays of all generations, back to back
+
+        SlidingWindowBloomFilterVisualiser<T> _visualiser;
+    };
+}
+
+#include "slidingWindowBloomFilterImpl.h"
@@ -0,0 +1,285 @@
+#pragma once
+
+#include <algorithm>
+
+namespace pds::bloomFilter
+{
+    /**
+     * @brief Construct a new Sliding Window Bloom Filter< T>:: Sliding Window Bloom Filter object
+     * with all of its storage drawn from the given memory resource
+     *
+     * @tparam T
+     * @param resource
+     */
+    template <typename T>
+    SlidingWindowBloomFilter<T>::SlidingWindowBloomFilter(std::pmr::memory_resource* resource)
+        : _k(0), _m(BIT_ARRAY_SIZE), _liveGenerations(0), _slice(Duration::zero()),
+          _head(0), _wordsPerGeneration(0), _clearCursor(0), _generations(resource), _words(resource) {}
+
+    /**
+     * @brief Initialise the filter with k hash functions and a window split across
+     * the given number of generations (at least 2)
+     *
+     * @tparam T
+     * @param numHashFunctions
+     * @param window
+     * @param generations
+     * @param bitsPerGeneration
+     */
+    template <typename T>
+    void SlidingWindowBloomFilter<T>::init(size_t numHashFunctions, Duration window,
+                                           size_t generations, size_t bitsPerGeneration)
+    {
+        _k = numHashFunctions;
+        _m = std::max<size_t>(bitsPerGeneration, 1);
+        _liveGenerations = std::max<size_t>(generations, 2);
+        _slice = std::max<Duration>(window / static_cast<int64_t>(_liveGenerations - 1), Duration(1));
+        _head = 0;
+
+        _wordsPerGeneration = (_m + 63) / 64;
+
+        // Every generation starts out expired, the first insert sets the current slice
+        _generations.assign(_liveGenerations + 1, Generation{EXPIRED_SLICE, 0});
+        _words.assign(_generations.size() * _wordsPerGeneration, 0);
+        _clearCursor = _wordsPerGeneration;
+
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("[Init] Sliding Window Bloom Filter initialized with " + std::to_string(_k) +
+                                  " hash functions and " + std::to_string(_liveGenerations) + " generations");
+            _visualiser.logState(*this, 0, VisualContext::INIT);
+        }
+    }
+
+    /**
+     * @brief Record that an item was seen at time now
+     *
+     * @tparam T
+     * @param item
+     * @param now
+     */
+    template <typename T>
+    void SlidingWindowBloomFilter<T>::insert(const T& item, TimePoint now)
+    {
+        if (_generations.empty())
+            return;
+
+        advance(sliceOf(now));
+        clearSpare(CLEAR_WORDS_PER_OP);
+
+        Generation& head = _generations[_head];
+        uint64_t* words = _words.data() + _head * _wordsPerGeneration;
+        for (size_t i = 0; i < _k; ++i)
+        {
+            const size_t idx = core::seededHash(item, i) % _m;
+            uint64_t& word = words[idx / 64];
+            const uint64_t mask = uint64_t{1} << (idx % 64);
+            if ((word & mask) == 0)
+            {
+                word |= mask;
+                ++head.count;
+            }
+        }
+    }
+
+    /**
+     * @brief Query if an item was possibly seen within the window ending at now
+     *
+     * @tparam T
+     * @param item
+     * @param now
+     * @return std::optional<float> False positive probability if possibly seen
+     */
+    template <typename T>
+    std::optional<float> SlidingWindowBloomFilter<T>::query(const T& item, TimePoint now) const
+    {
+        if (_generations.empty())
+            return std::nullopt;
+
+        const int64_t currentSlice = std::max(sliceOf(now), _generations[_head].slice);
+        for (size_t g = 0; g < _generations.size(); ++g)
+        {
+            const Generation& generation = _generations[g];
+            if (!isLive(generation, currentSlice))
+                continue;
+
+            bool allSet = true;
+            for (size_t i = 0; i < _k && allSet; ++i)
+            {
+                allSet = testBit(g, core::seededHash(item, i) % _m);
+            }
+
+            if (allSet)
+            {
+                if constexpr (VISUALISE)
+                {
+                    _visualiser.logAction("\033[34m[Query Hit]\033[0m " + toDisplayString(item) +
+                                          " in slice " + std::to_string(generation.slice));
+                }
+                return std::make_optional<float>(computeFalsePositiveProbability(currentSlice));
+            }
+        }
+
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("\033[31m[Query Miss]\033[0m " + toDisplayString(item));
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * @brief Gets the load factor of the generation receiving inserts as a percentage
+     *
+     * @tparam T
+     * @return int32_t
+     */
+    template <typename T>
+    int32_t SlidingWindowBloomFilter<T>::getLoadFactor() const
+    {
+        if (_generations.empty())
+            return 0;
+
+        return static_cast<int32_t>((static_cast<size_t>(_generations[_head].count) * 100) / _m);
+    }
+
+    /**
+     * @brief Total number of set bits across the live generations, as of the last insert
+     *
+     * @tparam T
+     * @return int32_t
+     */
+    template <typename T>
+    int32_t SlidingWindowBloomFilter<T>::getSize() const
+    {
+        if (_generations.empty())
+            return 0;
+
+        int32_t total = 0;
+        for (const auto& generation : _generations)
+        {
+            if (isLive(generation, _generations[_head].slice))
+                total += generation.count;
+        }
+        return total;
+    }
+
+    /**
+     * @brief Checks if no live generation has any bit set
+     *
+     * @tparam T
+     * @return true
+     * @return false
+     */
+    template <typename T>
+    bool SlidingWindowBloomFilter<T>::isEmpty() const
+    {
+        return getSize() == 0;
+    }
+
+    /**
+     * @brief Index of the time slice a time point falls into
+     *
+     * @tparam T
+     * @param now
+     * @return int64_t
+     */
+    template <typename T>
+    int64_t SlidingWindowBloomFilter<T>::sliceOf(TimePoint now) const
+    {
+        return static_cast<int64_t>(now.time_since_epoch() / _slice);
+    }
+
+    /**
+     * @brief Checks if a generation still falls inside the window ending at currentSlice
+     *
+     * @tparam T
+     * @param generation
+     * @param currentSlice
+     * @return true
+     * @return false
+     */
+    template <typename T>
+    bool SlidingWindowBloomFilter<T>::isLive(const Generation& generation, int64_t currentSlice) const
+    {
+        return generation.slice <= currentSlice &&
+               currentSlice - generation.slice < static_cast<int64_t>(_liveGenerations);
+    }
+
+    /**
+     * @brief Checks a bit of the given generation
+     *
+     * @tparam T
+     * @param generation
+     * @param idx
+     * @return true
+     * @return false
+     */
+    template <typename T>
+    bool SlidingWindowBloomFilter<T>::testBit(size_t generation, size_t idx) const
+    {
+        return (_words[generation * _wordsPerGeneration + idx / 64] >> (idx % 64)) & 1;
+    }
+
+    /**
+     * @brief Rotates generations forward until the head holds the given slice. The
+     * oldest live generation expires and becomes the spare to be cleared.
+     *
+     * @tparam T
+     * @param slice
+     */
+    template <typename T>
+    void SlidingWindowBloomFilter<T>::advance(int64_t slice)
+    {
+        const int64_t headSlice = _generations[_head].slice;
+        if (slice <= headSlice)
+            return;
+
+        // After a gap longer than the window everything has expired, so the
+        // rotation only needs to run enough times to recycle every generation
+        const int64_t steps = std::min<int64_t>(slice - headSlice, static_cast<int64_t>(_generations.size()));
+        for (int64_t step = steps - 1; step >= 0; --step)
+        {
+            clearSpare(_wordsPerGeneration);
+            _head = spareIndex();
+            _generations[_head].slice = slice - step;
+            _clearCursor = 0;
+        }
+
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("[Rotate] Head generation now holds slice " + std::to_string(slice));
+            _visualiser.logState(*this, _head, VisualContext::INSERT);
+        }
+    }
+
+    /**
+     * @brief Clears up to the given number of words of the spare generation
+     *
+     * @tparam T
+     * @param words
+     */
+    template <typename T>
+    void SlidingWindowBloomFilter<T>::clearSpare(size_t words)
+    {
+        Generation& spare = _generations[spareIndex()];
+        uint64_t* spareWords = _words.data() + spareIndex() * _wordsPerGeneration;
+        const size_t end = std::min(_wordsPerGeneration, _clearCursor + words);
+        for (; _clearCursor < end; ++_clearCursor)
+        {
+            spare.count -= static_cast<int32_t>(__builtin_popcountll(spareWords[_clearCursor]));
+            spareWords[_clearCursor] = 0;
+        }
+    }
+
+    /**
+     * @brief The spare generation sits right after the head in the ring
+     *
+     * @tparam T
+     * @return size_t
+     */
+    template <typename T>
+    size_t SlidingWindowBloomFilter<T>::spareIndex() const
+    {
+        return (_head + 1) % _generations.size();
+    }
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <iostream>
+#include <iomanip>
+#include <optional>
+#include <string>
+
+#include "pds/core/common.h"
+
+namespace pds::bloomFilter
+{
+    template <typename T>
+    class SlidingWindowBloomFilter; // Forward declaration
+
+    template <typename T>
+    class SlidingWindowBloomFilterVisualiser
+    {
+        public:
+        /**
+         * @brief Logs every generation of the filter, one bit array per generation
+         *
+         * @param filter The filter to log
+         * @param highlight Optional generation to highlight
+         * @param ctx Context of the operation (INIT, INSERT, QUERY)
+         */
+        void logState(const SlidingWindowBloomFilter<T>& filter,
+                      std::optional<size_t> highlight = std::nullopt,
+                      pds::VisualContext ctx = pds::VisualContext::UNKNOWN) const
+        {
+            constexpr size_t rowSize = 32;
+            std::cout << "\n[Sliding Window Bloom Filter State] Context: " << toString(ctx) << "\n";
+
+            const int64_t currentSlice = filter._generations[filter._head].slice;
+            for (size_t g = 0; g < filter._generations.size(); ++g)
+            {
+                const auto& generation = filter._generations[g];
+                const bool isHighlighted = highlight.has_value() && highlight.value() == g;
+
+                std::cout << "\nGeneration " << g;
+                if (g == filter.spareIndex())
+                {
+                    std::cout << " (spare, clearing)";
+                }
+                else if (generation.slice == filter.EXPIRED_SLICE || !filter.isLive(generation, currentSlice))
+                {
+                    std::cout << " (expired)";
+                }
+                else
+                {
+                    std::cout << " slice " << generation.slice;
+                }
+                std::cout << " set bits: " << generation.count << "\n\n";
+
+                for (size_t i = 0; i < filter._m; ++i)
+                {
+                    const bool isSet = filter.testBit(g, i);
+                    if (isSet && isHighlighted)
+                    {
+                        std::cout << "\033[44m"; // Blue background
+                    }
+                    else
+                    {
+                        std::cout << (isSet ? "\033[42m" : "\033[41m"); // Green or Red
+                    }
+
+                    std::cout << "  \033[0m";
+
+                    if ((i + 1) % rowSize == 0)
+                    {
+                        std::cout << "  <- [" << std::setw(3) << (i - rowSize + 1)
+                                  << " - " << std::setw(3) << i << "]\n";
+                    }
+                }
+
+                if (filter._m % rowSize != 0)
+                {
+                    std::cout << "  <- [" << filter._m - (filter._m % rowSize)
+                              << " - " << filter._m - 1 << "]\n";
+                }
+            }
+
+            std::cout << "\n";
+        }
+
+        /**
+         * @brief Logs the string describing an action taken on the filter
+         *
+         * @param action
+         */
+        void logAction(const std::string& action) const
+        {
+            std::cout << "[LOG] " << action << "\n";
+        }
+    };
+}
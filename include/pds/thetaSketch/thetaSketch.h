@@ -0,0 +1,70 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory_resource>
+
+#include "pds/core/common.h"
+#include "pds/core/hash.h"
+
+namespace pds::cardinality
+{
+    /**
+     * @brief Theta sketch (K minimum values): keeps the smallest distinct 64-bit hashes seen,
+     * up to about nominalEntries of them, below a threshold theta. The number retained divided
+     * by theta, as a fraction of the hash space, estimates the number of distinct items. Unlike
+     * a LinearCounter, two sketches can be intersected and subtracted as well as merged, since
+     * both hold every distinct hash below the smaller theta.
+     *
+     * Retained hashes sit in an open addressing table probed on their low bits. Once theta has
+     * settled most items are rejected by a single compare against it, before the table is touched.
+     *
+     * @tparam T
+     */
+    template <typename T>
+    class ThetaSketch
+    {
+        public:
+        explicit ThetaSketch(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+        void init(size_t nominalEntries = 4096);
+
+        void insert(const T& item);
+        void merge(const ThetaSketch& other);
+        void intersect(const ThetaSketch& other);
+        void subtract(const ThetaSketch& other);
+
+        double estimate() const;
+        double lowerBound(uint8_t numStdDevs = 2) const;
+        double upperBound(uint8_t numStdDevs = 2) const;
+        double getTheta() const;
+
+        size_t getRetained() const;
+        size_t getNominalEntries() const;
+        bool isEmpty() const;
+        bool isEstimationMode() const;
+
+        private:
+        static constexpr uint64_t EMPTY = 0; // Marks a free slot; a hash of 0 is stored as 1
+        static constexpr uint64_t THETA_MAX = std::numeric_limits<uint64_t>::max();
+
+        uint64_t hash(const T& item) const;
+        bool insertHash(uint64_t h);
+        bool containsHash(uint64_t h) const;
+        void rebuild();
+        template <typename Predicate>
+        void retainIf(Predicate keep);
+
+        size_t _k; // Nominal entries
+        uint64_t _theta; // Hashes at or above theta are rejected
+        size_t _count; // Retained hashes
+        size_t _rebuildThreshold; // Retained count at which the table is cut back to the k smallest
+        std::pmr::vector<uint64_t> _table;
+        std::pmr::vector<uint64_t> _scratch; // Reused by rebuild and the set operations
+    };
+}
+
+#include "thetaSketchImpl.h"
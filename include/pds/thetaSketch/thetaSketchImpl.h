@@ -0,0 +1,334 @@
+#pragma once
+
+namespace pds::cardinality
+{
+    /**
+     * @brief Construct a new Theta Sketch< T>:: Theta Sketch object
+     * with its table drawn from the given memory resource
+     *
+     * @tparam T
+     * @param resource
+     */
+    template <typename T>
+    ThetaSketch<T>::ThetaSketch(std::pmr::memory_resource* resource)
+        : _k(0), _theta(THETA_MAX), _count(0), _rebuildThreshold(0), _table(resource), _scratch(resource)
+    {
+        init();
+    }
+
+    /**
+     * @brief Initialise an empty sketch keeping about nominalEntries hashes once in estimation
+     * mode. The relative standard error of the estimate is about 1 / sqrt(nominalEntries).
+     *
+     * @tparam T
+     * @param nominalEntries
+     */
+    template <typename T>
+    void ThetaSketch<T>::init(size_t nominalEntries)
+    {
+        _k = std::max<size_t>(nominalEntries, 1);
+        _theta = THETA_MAX;
+        _count = 0;
+
+        // At most 3/4 full, and at least half as much room again as k so rebuilds are amortised
+        size_t capacity = 4;
+        while (capacity < 2 * _k)
+        {
+            capacity <<= 1;
+        }
+        _rebuildThreshold = capacity / 4 * 3;
+        _table.assign(capacity, EMPTY);
+    }
+
+    /**
+     * @brief Insert an item. Items hashing at or above theta are rejected without touching the table.
+     *
+     * @tparam T
+     * @param item
+     */
+    template <typename T>
+    void ThetaSketch<T>::insert(const T& item)
+    {
+        const uint64_t h = hash(item);
+        if (h >= _theta)
+            return;
+
+        insertHash(h);
+    }
+
+    /**
+     * @brief Union: afterwards the sketch estimates the distinct items of both streams.
+     * Theta becomes the smaller of the two.
+     *
+     * @tparam T
+     * @param other
+     */
+    template <typename T>
+    void ThetaSketch<T>::merge(const ThetaSketch& other)
+    {
+        if (&other == this)
+            return;
+
+        if (other._theta < _theta)
+        {
+            _theta = other._theta;
+            retainIf([](uint64_t) { return true; });
+        }
+
+        for (uint64_t h : other._table)
+        {
+            if (h != EMPTY && h < _theta)
+            {
+                insertHash(h);
+            }
+        }
+    }
+
+    /**
+     * @brief Intersection: afterwards the sketch estimates the distinct items seen by both
+     * streams. Theta becomes the smaller of the two.
+     *
+     * @tparam T
+     * @param other
+     */
+    template <typename T>
+    void ThetaSketch<T>::intersect(const ThetaSketch& other)
+    {
+        if (&other == this)
+            return;
+
+        _theta = std::min(_theta, other._theta);
+        retainIf([&other](uint64_t h) { return other.containsHash(h); });
+    }
+
+    /**
+     * @brief A-not-B: afterwards the sketch estimates the distinct items of this stream that the
+     * other stream did not see. Theta becomes the smaller of the two.
+     *
+     * @tparam T
+     * @param other
+     */
+    template <typename T>
+    void ThetaSketch<T>::subtract(const ThetaSketch& other)
+    {
+        if (&other == this)
+        {
+            std::fill(_table.begin(), _table.end(), EMPTY);
+            _count = 0;
+            return;
+        }
+
+        _theta = std::min(_theta, other._theta);
+        retainIf([&other](uint64_t h) { return !other.containsHash(h); });
+    }
+
+    /**
+     * @brief Estimated number of distinct items, exact until the sketch first fills
+     *
+     * @tparam T
+     * @return double
+     */
+    template <typename T>
+    double ThetaSketch<T>::estimate() const
+    {
+        return static_cast<double>(_count) / getTheta();
+    }
+
+    /**
+     * @brief Lower bound on the number of distinct items at numStdDevs standard deviations
+     * (2 for about 95% confidence). The retained count is binomial in the true count with
+     * probability theta, so the estimate has variance about retained * (1 - theta) / theta^2.
+     *
+     * @tparam T
+     * @param numStdDevs
+     * @return double
+     */
+    template <typename T>
+    double ThetaSketch<T>::lowerBound(uint8_t numStdDevs) const
+    {
+        if (!isEstimationMode())
+            return static_cast<double>(_count);
+
+        const double theta = getTheta();
+        const double stdDev = std::sqrt(static_cast<double>(_count) * (1.0 - theta)) / theta;
+        return std::max(static_cast<double>(_count), estimate() - numStdDevs * stdDev);
+    }
+
+    /**
+     * @brief Upper bound on the number of distinct items at numStdDevs standard deviations
+     *
+     * @tparam T
+     * @param numStdDevs
+     * @return double
+     */
+    template <typename T>
+    double ThetaSketch<T>::upperBound(uint8_t numStdDevs) const
+    {
+        if (!isEstimationMode())
+            return static_cast<double>(_count);
+
+        const double theta = getTheta();
+        // With nothing retained the estimate is 0, but up to about 1 / theta items may have been missed
+        const double stdDev = std::sqrt(std::max<double>(static_cast<double>(_count), 1.0) * (1.0 - theta)) / theta;
+        return estimate() + numStdDevs * stdDev;
+    }
+
+    /**
+     * @brief Theta as a fraction of the hash space, 1 until the sketch first fills
+     *
+     * @tparam T
+     * @return double
+     */
+    template <typename T>
+    double ThetaSketch<T>::getTheta() const
+    {
+        if (!isEstimationMode())
+            return 1.0;
+
+        return std::ldexp(static_cast<double>(_theta), -64);
+    }
+
+    template <typename T>
+    size_t ThetaSketch<T>::getRetained() const
+    {
+        return _count;
+    }
+
+    template <typename T>
+    size_t ThetaSketch<T>::getNominalEntries() const
+    {
+        return _k;
+    }
+
+    template <typename T>
+    bool ThetaSketch<T>::isEmpty() const
+    {
+        return _count == 0 && !isEstimationMode();
+    }
+
+    /**
+     * @brief Whether theta has dropped below 1, so the sketch estimates rather than counts
+     *
+     * @tparam T
+     * @return true
+     * @return false
+     */
+    template <typename T>
+    bool ThetaSketch<T>::isEstimationMode() const
+    {
+        return _theta != THETA_MAX;
+    }
+
+    template <typename T>
+    uint64_t ThetaSketch<T>::hash(const T& item) const
+    {
+        const uint64_t h = core::mixedHash(item);
+        return h == EMPTY ? 1 : h;
+    }
+
+    /**
+     * @brief Adds a hash below theta if it is not already retained, cutting the sketch back to
+     * the k smallest hashes when the table reaches its threshold
+     *
+     * @tparam T
+     * @param h
+     * @return true if the hash was new
+     * @return false if it was already retained
+     */
+    template <typename T>
+    bool ThetaSketch<T>::insertHash(uint64_t h)
+    {
+        // Retained hashes are small, so their high bits carry little; probe on the low bits
+        const size_t mask = _table.size() - 1;
+        size_t idx = static_cast<size_t>(h) & mask;
+        while (_table[idx] != EMPTY)
+        {
+            if (_table[idx] == h)
+                return false;
+            idx = (idx + 1) & mask;
+        }
+
+        _table[idx] = h;
+        if (++_count >= _rebuildThreshold)
+        {
+            rebuild();
+        }
+        return true;
+    }
+
+    template <typename T>
+    bool ThetaSketch<T>::containsHash(uint64_t h) const
+    {
+        if (h >= _theta)
+            return false;
+
+        const size_t mask = _table.size() - 1;
+        size_t idx = static_cast<size_t>(h) & mask;
+        while (_table[idx] != EMPTY)
+        {
+            if (_table[idx] == h)
+                return true;
+            idx = (idx + 1) & mask;
+        }
+        return false;
+    }
+
+    /**
+     * @brief Keeps the k smallest hashes and lowers theta to the next one, so the retained
+     * hashes are again exactly the distinct hashes seen below theta
+     *
+     * @tparam T
+     */
+    template <typename T>
+    void ThetaSketch<T>::rebuild()
+    {
+        _scratch.clear();
+        for (uint64_t h : _table)
+        {
+            if (h != EMPTY)
+            {
+                _scratch.push_back(h);
+            }
+        }
+
+        std::nth_element(_scratch.begin(), _scratch.begin() + _k, _scratch.end());
+        _theta = _scratch[_k];
+        _scratch.resize(_k);
+
+        std::fill(_table.begin(), _table.end(), EMPTY);
+        _count = 0;
+        for (uint64_t h : _scratch)
+        {
+            insertHash(h);
+        }
+    }
+
+    /**
+     * @brief Keeps only the retained hashes below theta for which keep returns true, and
+     * rehashes them so no probe chain is left broken
+     *
+     * @tparam T
+     * @tparam Predicate
+     * @param keep
+     */
+    template <typename T>
+    template <typename Predicate>
+    void ThetaSketch<T>::retainIf(Predicate keep)
+    {
+        _scratch.clear();
+        for (uint64_t h : _table)
+        {
+            if (h != EMPTY && h < _theta && keep(h))
+            {
+                _scratch.push_back(h);
+            }
+        }
+
+        std::fill(_table.begin(), _table.end(), EMPTY);
+        _count = 0;
+        for (uint64_t h : _scratch)
+        {
+            insertHash(h);
+        }
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+#include <tuple>
+#include <optional>
+#include <unordered_map>
+#include <memory_resource>
+
+#include "pds/core/common.h"
+#include "pds/core/hash.h"
+#include "topKVisualiser.h"
+
+namespace pds::frequency
+{
+    /**
+     * @brief Top-K heavy hitters using Filtered Space-Saving: a compact counter sketch
+     * filters out the long tail, and a stream-summary of K monitored items is kept
+     * sorted by count so that every update is O(1) amortized.
+     *
+     * @tparam T
+     */
+    template <typename T>
+    class TopK
+    {
+        friend class TopKVisualiser<T>;
+
+        public:
+        explicit TopK(std::pmr::memory_resource* resource = std::pmr::get_default_resource());
+
+        void init(size_t k, size_t sketchWidth = 0);
+
+        void insert(const T& item);
+        std::optional<uint64_t> query(const T& item) const;
+        std::vector<std::tuple<T, uint64_t, uint64_t>> topK() const;
+
+        uint64_t getStreamLength() const;
+        int32_t getSize() const;
+        bool isEmpty() const;
+
+        private:
+        struct Entry
+        {
+            T item;
+            uint64_t count; // Over-estimate of the true frequency
+            uint64_t error; // Maximum over-estimation in count
+        };
+
+        void increment(size_t pos);
+        size_t sketchIndex(const T& item) const;
+
+        size_t _k; // Number of monitored items
+        uint64_t _streamLength; // Total number of inserts seen
+        std::pmr::vector<Entry> _entries; // Stream-summary, sorted by count in descending order
+        std::pmr::unordered_map<T, size_t> _index; // Item -> position in _entries
+        std::pmr::unordered_map<uint64_t, size_t> _runStart; // Count -> first position holding that count
+        std::pmr::vector<uint64_t> _sketch; // Counters for unmonitored items
+
+        TopKVisualiser<T> _visualiser;
+    };
+}
+
+#include "topKImpl.h"
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <utility>
+
+namespace pds::frequency
+{
+    /**
+     * @brief Construct a new Top K< T>:: Top K object
+     * with all of its storage drawn from the given memory resource
+     *
+     * @tparam T
+     * @param resource
+     */
+    template <typename T>
+    TopK<T>::TopK(std::pmr::memory_resource* resource)
+        : _k(0), _streamLength(0), _entries(resource), _index(resource),
+          _runStart(resource), _sketch(resource) {}
+
+    /**
+     * @brief Initialise the tracker to monitor k items, with a filtering sketch of
+     * sketchWidth counters (defaults to 6 * k)
+     *
+     * @tparam T
+     * @param k
+     * @param sketchWidth
+     */
+    template <typename T>
+    void TopK<T>::init(size_t k, size_t sketchWidth)
+    {
+        _k = k;
+        _streamLength = 0;
+        _entries.clear();
+        _entries.reserve(k);
+        _index.clear();
+        _index.reserve(k);
+        _runStart.clear();
+        _sketch.assign(sketchWidth == 0 ? 6 * k : sketchWidth, 0);
+
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("[Init] Top-K initialized with k = " + std::to_string(_k) +
+                                  " and sketch width " + std::to_string(_sketch.size()));
+            _visualiser.logState(*this, std::nullopt, VisualContext::INIT);
+        }
+    }
+
+    /**
+     * @brief Count one occurrence of an item. Monitored items are incremented in place,
+     * others accumulate in the sketch until they reach the minimum monitored count and
+     * take over its slot. Not logged, as this is the hot path of the stream.
+     *
+     * @tparam T
+     * @param item
+     */
+    template <typename T>
+    void TopK<T>::insert(const T& item)
+    {
+        if (_k == 0)
+            return;
+
+        ++_streamLength;
+
+        auto it = _index.find(item);
+        if (it != _index.end())
+        {
+            increment(it->second);
+            return;
+        }
+
+        if (_entries.size() < _k)
+        {
+            // Counts are at least 1, so a new item always goes to the back
+            _entries.push_back({item, 1, 0});
+            const size_t pos = _entries.size() - 1;
+            _index.emplace(item, pos);
+            _runStart.emplace(1, pos);
+            return;
+        }
+
+        const size_t cell = sketchIndex(item);
+        const uint64_t minCount = _entries.back().count;
+        const uint64_t alpha = _sketch[cell];
+        if (alpha + 1 < minCount)
+        {
+            ++_sketch[cell];
+            return;
+        }
+
+        // Evict the minimum, remembering its count in the sketch. The sketch never
+        // exceeds the minimum count, so the new count is either min or min + 1.
+        const size_t pos = _entries.size() - 1;
+        Entry& victim = _entries[pos];
+        _sketch[sketchIndex(victim.item)] = victim.count;
+        _index.erase(victim.item);
+
+        victim.item = item;
+        victim.error = alpha;
+        _index.emplace(item, pos);
+
+        if (alpha + 1 > minCount)
+        {
+            increment(pos);
+        }
+    }
+
+    /**
+     * @brief Estimated count of an item if it is currently monitored
+     *
+     * @tparam T
+     * @param item
+     * @return std::optional<uint64_t>
+     */
+    template <typename T>
+    std::optional<uint64_t> TopK<T>::query(const T& item) const
+    {
+        auto it = _index.find(item);
+        if (it == _index.end())
+        {
+            if constexpr (VISUALISE)
+            {
+                _visualiser.logAction("\033[31m[Query Miss]\033[0m " + toDisplayString(item));
+            }
+            return std::nullopt;
+        }
+
+        const Entry& entry = _entries[it->second];
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("\033[34m[Query Hit]\033[0m " + toDisplayString(item) +
+                                  " count: " + std::to_string(entry.count) +
+                                  " error: " + std::to_string(entry.error));
+        }
+        return std::make_optional<uint64_t>(entry.count);
+    }
+
+    /**
+     * @brief Monitored items as (item, count, error) tuples, most frequent first.
+     * The true frequency of each item lies in [count - error, count].
+     *
+     * @tparam T
+     * @return std::vector<std::tuple<T, uint64_t, uint64_t>>
+     */
+    template <typename T>
+    std::vector<std::tuple<T, uint64_t, uint64_t>> TopK<T>::topK() const
+    {
+        std::vector<std::tuple<T, uint64_t, uint64_t>> result;
+        result.reserve(_entries.size());
+        for (const auto& entry : _entries)
+        {
+            result.emplace_back(entry.item, entry.count, entry.error);
+        }
+
+        if constexpr (VISUALISE)
+        {
+            _visualiser.logAction("[TopK] Reporting " + std::to_string(result.size()) + " items");
+            _visualiser.logState(*this, std::nullopt, VisualContext::QUERY);
+        }
+        return result;
+    }
+
+    /**
+     * @brief Total number of inserts seen since init
+     *
+     * @tparam T
+     * @return uint64_t
+     */
+    template <typename T>
+    uint64_t TopK<T>::getStreamLength() const
+    {
+        return _streamLength;
+    }
+
+    /**
+     * @brief Number of items currently monitored
+     *
+     * @tparam T
+     * @return int32_t
+     */
+    template <typename T>
+    int32_t TopK<T>::getSize() const
+    {
+        return static_cast<int32_t>(_entries.size());
+    }
+
+    /**
+     * @brief Checks if no item has been inserted
+     *
+     * @tparam T
+     * @return true
+     * @return false
+     */
+    template <typename T>
+    bool TopK<T>::isEmpty() const
+    {
+        return _entries.empty();
+    }
+
+    /**
+     * @brief Adds one to the count at pos, keeping _entries sorted by swapping it
+     * with the first entry of the same count
+     *
+     * @tparam T
+     * @param pos
+     */
+    template <typename T>
+    void TopK<T>::increment(size_t pos)
+    {
+        const uint64_t count = _entries[pos].count;
+        auto run = _runStart.find(count);
+        const size_t start = run->second;
+
+        if (start != pos)
+        {
+            std::swap(_entries[start], _entries[pos]);
+            _index.find(_entries[pos].item)->second = pos;
+            _index.find(_entries[start].item)->second = start;
+        }
+
+        ++_entries[start].count;
+
+        if (start + 1 < _entries.size() && _entries[start + 1].count == count)
+        {
+            run->second = start + 1;
+        }
+        else
+        {
+            _runStart.erase(run);
+        }
+
+        // Entries before start all have a larger count, so an existing run for
+        // count + 1 ends right before start and keeps its first position
+        _runStart.emplace(count + 1, start);
+    }
+
+    /**
+     * @brief Sketch cell an item is counted in while it is not monitored
+     *
+     * @tparam T
+     * @param item
+     * @return size_t
+     */
+    template <typename T>
+    size_t TopK<T>::sketchIndex(const T& item) const
+    {
+        return core::mixedHash(item) % _sketch.size();
+    }
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <iostream>
+#include <iomanip>
+#include <optional>
+#include <string>
+
+#include "pds/core/common.h"
+
+namespace pds::frequency
+{
+    template <typename T>
+    class TopK; // Forward declaration
+
+    template <typename T>
+    class TopKVisualiser
+    {
+        public:
+        /**
+         * @brief Logs the monitored items and the filtering sketch
+         *
+         * @param topK The tracker to log
+         * @param highlight Optional sketch cell to highlight
+         * @param ctx Context of the operation (INIT, INSERT, QUERY)
+         */
+        void logState(const TopK<T>& topK,
+                      std::optional<size_t> highlight = std::nullopt,
+                      pds::VisualContext ctx = pds::VisualContext::UNKNOWN) const
+        {
+            std::cout << "\n[Top-K State] Context: " << toString(ctx)
+                      << " Stream length: " << topK._streamLength << "\n\n";
+
+            std::cout << std::left
+                      << std::setw(6) << "Rank" << " | "
+                      << std::setw(20) << "Item" << " | "
+                      << std::setw(12) << "Count" << " | "
+                      << std::setw(12) << "Error"
+                      << "\n";
+
+            std::cout << std::string(6, '-') << "-+-"
+                      << std::string(20, '-') << "-+-"
+                      << std::string(12, '-') << "-+-"
+                      << std::string(12, '-') << "\n";
+
+            for (size_t i = 0; i < topK._entries.size(); ++i)
+            {
+                const auto& entry = topK._entries[i];
+                std::cout << std::left
+                          << std::setw(6) << i + 1 << " | "
+                          << std::setw(20) << toDisplayString(entry.item) << " | "
+                          << std::setw(12) << entry.count << " | "
+                          << std::setw(12) << entry.error
+                          << "\n";
+            }
+            std::cout << std::right << "\nSketch:\n\n";
+
+            constexpr size_t rowSize = 32;
+            for (size_t i = 0; i < topK._sketch.size(); ++i)
+            {
+                if (highlight.has_value() && highlight.value() == i)
+                {
+                    std::cout << "\033[44m"; // Blue background
+                }
+                else
+                {
+                    std::cout << (topK._sketch[i] > 0 ? "\033[42m" : "\033[41m"); // Green or Red
+                }
+
+                std::cout << "  \033[0m";
+
+                if ((i + 1) % rowSize == 0)
+                {
+                    std::cout << "  <- [" << std::setw(3) << (i - rowSize + 1)
+                              << " - " << std::setw(3) << i << "]\n";
+                }
+            }
+
+            if (topK._sketch.size() % rowSize != 0)
+            {
+                std::cout << "  <- [" << topK._sketch.size() - (topK._sketch.size() % rowSize)
+                          << " - " << topK._sketch.size() - 1 << "]\n";
+            }
+
+            std::cout << "\n";
+        }
+
+        /**
+         * @brief Logs the string describing an action taken on the tracker
+         *
+         * @param action
+         */
+        void logAction(const std::string& action) const
+        {
+            std::cout << "[LOG] " << action << "\n";
+        }
+    };
+}
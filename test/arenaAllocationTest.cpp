@@ -0,0 +1,57 @@
+#include "pds/bloomFilter/simpleBloomFilter.h"
+#include "pds/countingBloomFilter/countingBloomFilter.h"
+#include "pds/hashTable/openAddressingHashTable.h"
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <memory_resource>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace pds::bloomFilter;
+using namespace pds::hashTable;
+
+int main()
+{
+    // Every allocation of the structures below comes out of this buffer. The arena has
+    // no upstream, so running out of space throws instead of silently using malloc.
+    alignas(std::max_align_t) static std::array<std::byte, 256 * 1024> buffer;
+    std::pmr::monotonic_buffer_resource arena(buffer.data(), buffer.size(), std::pmr::null_memory_resource());
+
+    std::cout << "\n=== PER-TENANT FILTERS IN AN ARENA ===\n";
+    constexpr size_t tenants = 4;
+    std::vector<SimpleBloomFilter<std::string>> filters;
+    filters.reserve(tenants);
+    for (size_t tenant = 0; tenant < tenants; ++tenant)
+    {
+        filters.emplace_back(&arena);
+        filters.back().init(3);
+        filters.back().insert("tenant" + std::to_string(tenant));
+    }
+
+    std::cout << "\n=== MOVING A FILTER KEEPS ITS ARENA STORAGE ===\n";
+    SimpleBloomFilter<std::string> moved = std::move(filters.front());
+    std::cout << "Moved filter size: " << moved.getSize() << "\n";
+    moved.query("tenant0");
+
+    std::cout << "\n=== COPYING A FILTER ALLOCATES INDEPENDENT STORAGE ===\n";
+    SimpleBloomFilter<std::string> copy = filters[1];
+    copy.insert("only-in-copy");
+    std::cout << "Original size: " << filters[1].getSize() << ", copy size: " << copy.getSize() << "\n";
+
+    std::cout << "\n=== COUNTING BLOOM FILTER AND HASH TABLE IN THE SAME ARENA ===\n";
+    CountingBloomFilter<std::string> counting(&arena);
+    counting.init(2);
+    counting.insert("apple");
+    counting.erase("apple");
+
+    OpenAddressingHashTable<std::string, std::string> table(&arena);
+    table.init(64);
+    table.insert("apple", "fruit");
+    OpenAddressingHashTable<std::string, std::string> tableCopy = table;
+    std::cout << "Copied table contains apple? " << tableCopy.contains("apple") << "\n";
+
+    std::cout << "\n=== FINISHED TESTING ===\n";
+    return 0;
+}
@@ -0,0 +1,113 @@
+#define PDS_VISUALISE 0
+
+#include "pds/bloomFilter/simpleBloomFilter.h"
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <list>
+#include <string>
+#include <vector>
+
+using namespace pds::bloomFilter;
+using pds::core::KeyFileFormat;
+
+int main()
+{
+    constexpr size_t numKeys = 400000;
+    constexpr size_t numHashFunctions = 7;
+    constexpr size_t numBits = size_t{1} << 22;
+
+    std::vector<std::string> keys;
+    keys.reserve(numKeys);
+    for (size_t i = 0; i < numKeys; ++i)
+    {
+        keys.push_back("user-" + std::to_string(i * 2654435761u));
+    }
+
+    std::cout << "\n=== SEQUENTIAL INSERT (REFERENCE) ===\n";
+    SimpleBloomFilter<std::string> reference;
+    reference.init(numHashFunctions, numBits);
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& key : keys)
+    {
+        reference.insert(key);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Set bits: " << reference.getSize() << " in " << elapsed.count() << "s\n";
+
+    std::cout << "\n=== BULK BUILD FROM AN ITERATOR RANGE ===\n";
+    for (size_t numThreads : {1, 2, 4, 8})
+    {
+        SimpleBloomFilter<std::string> filter;
+        filter.init(numHashFunctions, numBits);
+        start = std::chrono::steady_clock::now();
+        filter.insertRange(keys.begin(), keys.end(), numThreads);
+        elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << numThreads << " thread(s): " << elapsed.count() << "s, set bits match reference? "
+                  << (filter.getSize() == reference.getSize()) << "\n";
+    }
+
+    std::cout << "\n=== BULK BUILD FROM A SINGLE PASS RANGE ===\n";
+    std::list<std::string> linked(keys.begin(), keys.begin() + 1000);
+    SimpleBloomFilter<std::string> fromList;
+    fromList.init(numHashFunctions, numBits);
+    fromList.insertRange(linked.begin(), linked.end());
+    std::cout << "Contains " << keys[999] << "? " << fromList.query(keys[999]).has_value() << "\n";
+
+    std::cout << "\n=== BULK BUILD FROM CHARACTER POINTERS ===\n";
+    // Hashed as the characters they point to, as inserting std::string keys one at a time would
+    const std::vector<const char*> literals = {"apple", "banana", "cherry"};
+    SimpleBloomFilter<std::string> fromLiterals;
+    fromLiterals.init(numHashFunctions, numBits);
+    fromLiterals.insertRange(literals.begin(), literals.end());
+    std::cout << "Contains apple? " << fromLiterals.query(std::string("apple")).has_value()
+              << ", banana? " << fromLiterals.query(std::string("banana")).has_value() << "\n";
+
+    std::cout << "\n=== BULK BUILD FROM KEY DUMPS ===\n";
+    const std::string linesPath = "bulkBuildTest.lines";
+    const std::string prefixedPath = "bulkBuildTest.prefixed";
+    {
+        std::ofstream lines(linesPath, std::ios::binary);
+        std::ofstream prefixed(prefixedPath, std::ios::binary);
+        for (const auto& key : keys)
+        {
+            lines << key << '\n';
+            const uint32_t length = static_cast<uint32_t>(key.size());
+            const char prefix[4] = {static_cast<char>(length), static_cast<char>(length >> 8),
+                                    static_cast<char>(length >> 16), static_cast<char>(length >> 24)};
+            prefixed.write(prefix, 4);
+            prefixed << key;
+        }
+    }
+
+    SimpleBloomFilter<std::string> fromLines;
+    fromLines.init(numHashFunctions, numBits);
+    const bool linesRead = fromLines.insertFromFile(linesPath, KeyFileFormat::NEWLINE);
+    std::cout << "Newline dump read? " << linesRead << ", set bits match reference? "
+              << (fromLines.getSize() == reference.getSize()) << "\n";
+
+    SimpleBloomFilter<std::string> fromPrefixed;
+    fromPrefixed.init(numHashFunctions, numBits);
+    const bool prefixedRead = fromPrefixed.insertFromFile(prefixedPath, KeyFileFormat::LENGTH_PREFIXED);
+    std::cout << "Length-prefixed dump read? " << prefixedRead << ", set bits match reference? "
+              << (fromPrefixed.getSize() == reference.getSize()) << "\n";
+
+    size_t missing = 0;
+    for (const auto& key : keys)
+    {
+        missing += !fromPrefixed.query(key).has_value();
+    }
+    std::cout << "Inserted keys missing from the built filter: " << missing << "\n";
+
+    SimpleBloomFilter<std::string> fromMissingFile;
+    fromMissingFile.init(numHashFunctions, numBits);
+    std::cout << "Missing dump read? " << fromMissingFile.insertFromFile("no-such-file") << "\n";
+
+    std::remove(linesPath.c_str());
+    std::remove(prefixedPath.c_str());
+
+    std::cout << "\n=== FINISHED TESTING ===\n";
+    return 0;
+}
@@ -0,0 +1,78 @@
+#define PDS_VISUALISE 0
+
+#include "pds/bloomFilter/simpleBloomFilter.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+using namespace pds::bloomFilter;
+
+int main()
+{
+    // Sized for 100000 keys at 1% false positives, currently holding 10000
+    SimpleBloomFilter<std::string> filter;
+    filter.init(7, 958506);
+    for (int i = 0; i < 10000; ++i)
+    {
+        filter.insert("key" + std::to_string(i));
+    }
+
+    const size_t rawBytes = (958506 + 7) / 8;
+    std::cout << "\n=== ENCODING " << filter.getSize() << " SET BITS OF 958506 ===\n";
+    std::cout << "Raw bit array: " << rawBytes << " bytes\n";
+
+    const auto rice = filter.encode(WireEncoding::GOLOMB_RICE);
+    const auto runs = filter.encode(WireEncoding::RUN_LENGTH);
+    std::cout << "Golomb-Rice: " << rice.size() << " bytes (" << static_cast<double>(rawBytes) / rice.size() << "x smaller)\n";
+    std::cout << "Run-length:  " << runs.size() << " bytes (" << static_cast<double>(rawBytes) / runs.size() << "x smaller)\n";
+
+    std::cout << "\n=== DECODING ON THE EDGE NODE ===\n";
+    for (const auto* encoded : {&rice, &runs})
+    {
+        SimpleBloomFilter<std::string> replica;
+        const bool decoded = replica.decode(encoded->data(), encoded->size());
+        size_t disagreements = 0;
+        for (int i = 0; i < 20000; ++i)
+        {
+            const std::string key = "key" + std::to_string(i);
+            disagreements += replica.query(key).has_value() != filter.query(key).has_value();
+        }
+        std::cout << "Decoded: " << decoded << ", set bits: " << replica.getSize() << ", disagreements: " << disagreements << "\n";
+    }
+
+    std::cout << "\n=== QUERYING THE COMPRESSED FORM DIRECTLY ===\n";
+    size_t hits = 0;
+    size_t falsePositives = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < 200; ++i)
+    {
+        hits += SimpleBloomFilter<std::string>::queryEncoded(rice.data(), rice.size(), std::string_view("key" + std::to_string(i))).has_value();
+        falsePositives += SimpleBloomFilter<std::string>::queryEncoded(rice.data(), rice.size(), std::string("other" + std::to_string(i))).has_value();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Inserted keys found: " << hits << " of 200, absent keys reported: " << falsePositives << " of 200, "
+              << elapsed.count() * 1e6 / 400 << "us per query\n";
+
+    auto fromRuns = SimpleBloomFilter<std::string>::queryEncoded(runs.data(), runs.size(), std::string("key42"));
+    std::cout << "key42 in run-length form: " << fromRuns.has_value() << ", false positive probability: " << fromRuns.value_or(0) << "\n";
+
+    std::cout << "\n=== REJECTING A TRUNCATED ENCODING ===\n";
+    SimpleBloomFilter<std::string> replica;
+    std::cout << "Decoded: " << replica.decode(rice.data(), rice.size() / 2) << "\n";
+
+    std::cout << "\n=== REJECTING CORRUPT HASH COUNTS ===\n";
+    for (uint8_t fill : {uint8_t{0x00}, uint8_t{0xFF}})
+    {
+        // The hash count is the 32 bits after the encoding byte
+        auto corrupt = rice;
+        std::fill(corrupt.begin() + 1, corrupt.begin() + 5, fill);
+        const bool decoded = replica.decode(corrupt.data(), corrupt.size());
+        const bool answered = SimpleBloomFilter<std::string>::queryEncoded(corrupt.data(), corrupt.size(), std::string("other1")).has_value();
+        std::cout << "Hash count " << (fill == 0 ? "0" : "0xFFFFFFFF") << ": decoded " << decoded << ", absent key reported " << answered << "\n";
+    }
+
+    std::cout << "\n=== FINISHED TESTING ===\n";
+    return 0;
+}
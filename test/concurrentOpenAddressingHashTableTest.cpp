@@ -0,0 +1,146 @@
+#include "pds/hashTable/concurrentOpenAddressingHashTable.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace pds::hashTable;
+
+int main()
+{
+    constexpr uint64_t keysPerThread = 20000;
+    constexpr size_t writers = 4;
+    constexpr size_t readers = 4;
+
+    ConcurrentOpenAddressingHashTable<uint64_t, uint64_t> table;
+    table.init(writers * keysPerThread * 2, 32);
+
+    std::cout << "\n=== CONCURRENT INSERTS WITH OPTIMISTIC READERS ===\n";
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> inconsistentReads{0};
+    std::vector<std::thread> threads;
+
+    for (size_t w = 0; w < writers; ++w)
+    {
+        threads.emplace_back([&, w] {
+            for (uint64_t i = 0; i < keysPerThread; ++i)
+            {
+                const uint64_t key = w * keysPerThread + i;
+                table.insert(key, key * 2);
+            }
+        });
+    }
+
+    for (size_t r = 0; r < readers; ++r)
+    {
+        threads.emplace_back([&, r] {
+            uint64_t key = r;
+            while (!done.load(std::memory_order_relaxed))
+            {
+                // A reader may miss a key that is still being inserted, but must never
+                // see a value that was not written for it
+                auto value = table.query(key);
+                if (value.has_value() && *value != key * 2)
+                {
+                    inconsistentReads.fetch_add(1, std::memory_order_relaxed);
+                }
+                key = (key + 7919) % (writers * keysPerThread);
+            }
+        });
+    }
+
+    for (size_t w = 0; w < writers; ++w)
+    {
+        threads[w].join();
+    }
+    done = true;
+    for (size_t r = writers; r < threads.size(); ++r)
+    {
+        threads[r].join();
+    }
+
+    std::cout << "Size: " << table.getSize() << " (expected " << writers * keysPerThread << ")\n";
+    std::cout << "Inconsistent reads: " << inconsistentReads.load() << "\n";
+
+    std::cout << "\n=== CONCURRENT ERASES ===\n";
+    threads.clear();
+    for (size_t w = 0; w < writers; ++w)
+    {
+        threads.emplace_back([&, w] {
+            for (uint64_t i = 0; i < keysPerThread; i += 2)
+            {
+                table.erase(w * keysPerThread + i);
+            }
+        });
+    }
+    for (auto& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::cout << "Size after erasing half: " << table.getSize() << "\n";
+    std::cout << "Contains 0? " << table.contains(0) << ", contains 1? " << table.contains(1) << "\n";
+
+    std::cout << "\n=== NON TRIVIALLY COPYABLE KEYS ARE READ UNDER THE SHARD LOCK ===\n";
+    ConcurrentOpenAddressingHashTable<std::string, std::string> cache;
+    cache.init(128, 4);
+    cache.insert("apple", "fruit");
+    cache.insert("apple", "still a fruit");
+    std::cout << "apple -> " << cache.query("apple").value_or("missing") << "\n";
+    std::cout << "Erased carrot? " << cache.erase("carrot") << "\n";
+
+    std::cout << "\n=== THROUGHPUT VS THREADS (90% QUERIES, 10% INSERTS) ===\n";
+    constexpr uint64_t keySpace = 1 << 16;
+    constexpr uint64_t opsPerThread = 400000;
+    const size_t maxThreads = std::max(2u, std::thread::hardware_concurrency()) * 2;
+    for (size_t numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+    {
+        ConcurrentOpenAddressingHashTable<uint64_t, uint64_t> shared;
+        shared.init(keySpace * 2);
+        for (uint64_t key = 0; key < keySpace; key += 2)
+        {
+            shared.insert(key, key);
+        }
+
+        std::atomic<uint64_t> hits{0};
+        std::vector<std::thread> workers;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t t = 0; t < numThreads; ++t)
+        {
+            workers.emplace_back([&, t] {
+                std::mt19937_64 rng(t);
+                uint64_t localHits = 0;
+                for (uint64_t op = 0; op < opsPerThread; ++op)
+                {
+                    const uint64_t r = rng();
+                    const uint64_t key = r % keySpace;
+                    if ((r >> 32) % 10 == 0)
+                    {
+                        shared.insert(key, key);
+                    }
+                    else
+                    {
+                        localHits += shared.contains(key);
+                    }
+                }
+                hits.fetch_add(localHits, std::memory_order_relaxed);
+            });
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+        std::cout << numThreads << " thread(s): "
+                  << static_cast<uint64_t>(numThreads * opsPerThread / elapsed.count()) << " ops/s"
+                  << " (" << hits.load() << " hits)\n";
+    }
+
+    std::cout << "\n=== FINISHED TESTING ===\n";
+    return 0;
+}
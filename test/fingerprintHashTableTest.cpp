@@ -0,0 +1,42 @@
+#include "pds/hashTable/fingerprintHashTable.h"
+#include <iostream>
+#include <string>
+
+using namespace pds::hashTable;
+
+int main() {
+    // 16-bit fingerprints: a miss compares against a key once every 65536 occupied slots
+    FingerprintHashTable<std::string, std::string, uint16_t> table;
+    table.init(64);
+
+    table.insert("apple", "fruit");
+    table.insert("carrot", "vegetable");
+    table.insert("banana", "fruit");
+    table.insert("a-key-too-long-for-the-small-string-buffer", "heap allocated key");
+
+    auto result = table.query("apple");
+    if (result) std::cout << "Query result: " << *result << "\n";
+
+    table.insert("apple", "still a fruit"); // Replaces the value
+    std::cout << "Query result after update: " << *table.query(std::string("apple")) << "\n";
+
+    table.erase("carrot");
+    std::cout << "Contains carrot? " << table.contains("carrot") << "\n";
+    std::cout << "Contains banana? " << table.contains(std::string_view("banana")) << "\n";
+
+    // 8-bit fingerprints and integer keys
+    FingerprintHashTable<uint64_t, uint64_t> ids;
+    ids.init(16);
+    for (uint64_t id = 0; id < 12; ++id)
+    {
+        ids.insert(id * 1000, id);
+    }
+    for (uint64_t id = 0; id < 12; id += 2)
+    {
+        ids.erase(id * 1000);
+    }
+    std::cout << "Size after erasing half: " << ids.getSize() << ", load factor: " << ids.getLoadFactor() << "%\n";
+    std::cout << "Contains 3000? " << ids.contains(3000) << ", contains 4000? " << ids.contains(4000) << "\n";
+
+    return 0;
+}
@@ -0,0 +1,90 @@
+#define PDS_VISUALISE 0
+
+#include "pds/bloomFilter/fixedBloomFilter.h"
+#include "pds/bloomFilter/simpleBloomFilter.h"
+#include "pds/linearCounter/fixedLinearCounter.h"
+#include "pds/linearCounter/linearCounter.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+using namespace pds::bloomFilter;
+using namespace pds::cardinality;
+
+using ConnectionFilter = FixedBloomFilter<uint64_t, 512, 3>;
+using ConnectionCounter = FixedLinearCounter<uint64_t, 256>;
+
+static_assert(sizeof(ConnectionFilter) == 512 / 8, "Nothing but the bits");
+static_assert(std::is_trivially_copyable_v<ConnectionFilter>, "Copyable with memcpy");
+static_assert(sizeof(ConnectionCounter) == 256 / 8, "Nothing but the bits");
+static_assert(sizeof(FixedLinearCounter<uint64_t, 100>) == 2 * sizeof(uint64_t), "Bits rounded up to 64-bit words");
+
+int main()
+{
+    std::cout << "\n=== SAME BITS AS A SIMPLE BLOOM FILTER OF THE SAME SIZE ===\n";
+    FixedBloomFilter<std::string, 1000, 4> fixed; // Not a power of two: reduced with %
+    SimpleBloomFilter<std::string> simple;
+    simple.init(4, 1000);
+    for (int i = 0; i < 100; ++i)
+    {
+        fixed.insert("item" + std::to_string(i));
+        simple.insert("item" + std::to_string(i));
+    }
+    size_t disagreements = 0;
+    for (int i = 0; i < 1000; ++i)
+    {
+        const std::string item = "item" + std::to_string(i);
+        disagreements += fixed.contains(item) != simple.query(item).has_value();
+    }
+    std::cout << "Set bits: " << fixed.getSize() << " vs " << simple.getSize() << ", disagreements: " << disagreements << "\n";
+    std::cout << "Contains string_view \"item7\"? " << fixed.contains(std::string_view("item7")) << "\n";
+
+    std::cout << "\n=== A MILLION PER-CONNECTION FILTERS IN ONE FLAT ARRAY ===\n";
+    constexpr size_t connections = 1000000;
+    std::vector<ConnectionFilter> filters(connections);
+    std::vector<ConnectionCounter> counters(connections);
+    std::cout << "Bytes per filter: " << sizeof(ConnectionFilter) << ", per counter: " << sizeof(ConnectionCounter) << "\n";
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t packet = 0; packet < 10 * connections; ++packet)
+    {
+        const size_t connection = (packet * 2654435761u) % connections;
+        filters[connection].insert(packet);
+        counters[connection].insert(packet % 97);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "10M inserts into each in " << elapsed.count() << "s\n";
+
+    size_t hits = 0;
+    for (uint64_t packet = 0; packet < 10 * connections; ++packet)
+    {
+        hits += filters[(packet * 2654435761u) % connections].contains(packet);
+    }
+    std::cout << "Inserted packets found: " << hits << " of " << 10 * connections << "\n";
+
+    std::cout << "\n=== FIXED LINEAR COUNTER MATCHES LINEAR COUNTER ===\n";
+    FixedLinearCounter<std::string, 1024> fixedCounter;
+    LinearCounter<std::string> counter;
+    counter.init(1024);
+    for (int i = 0; i < 300; ++i)
+    {
+        fixedCounter.insert("user" + std::to_string(i % 200));
+        counter.insert("user" + std::to_string(i % 200));
+    }
+    std::cout << "Estimate: " << fixedCounter.estimate().value() << " vs " << counter.estimate().value() << " (actual 200)\n";
+
+    FixedLinearCounter<std::string, 1024> otherCounter;
+    for (int i = 200; i < 300; ++i)
+    {
+        otherCounter.insert("user" + std::to_string(i));
+    }
+    fixedCounter.merge(otherCounter);
+    std::cout << "Merged estimate: " << fixedCounter.estimate().value() << " (actual 300)\n";
+
+    std::cout << "\n=== FINISHED TESTING ===\n";
+    return 0;
+}
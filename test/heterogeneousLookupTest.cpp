@@ -0,0 +1,92 @@
+#define PDS_VISUALISE 0
+
+#include "pds/bloomFilter/simpleBloomFilter.h"
+#include "pds/hashTable/fingerprintHashTable.h"
+#include "pds/hashTable/openAddressingHashTable.h"
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <string>
+#include <string_view>
+
+using namespace pds::bloomFilter;
+using namespace pds::hashTable;
+
+// Counts heap allocations so the lookups below can show they allocate nothing
+static size_t allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    ++allocations;
+    if (void* p = std::malloc(size))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+int main()
+{
+    OpenAddressingHashTable<std::string, std::string> table;
+    table.init(128);
+
+    std::cout << "\n=== TRY EMPLACE ===\n";
+    std::string key = "a-long-key-that-does-not-fit-in-sso";
+    std::string value = "a-long-value-that-does-not-fit-in-sso";
+    std::cout << "Emplaced: " << table.tryEmplace(std::move(key), std::move(value)) << "\n";
+    std::cout << "Emplaced again: " << table.tryEmplace(std::string("a-long-key-that-does-not-fit-in-sso"), "other") << "\n";
+    table.tryEmplace("GET", "read");
+
+    // A character pointer key hashes as its characters, so it is found, and not added twice, as a std::string
+    const char* pointer = "apple";
+    std::cout << "Emplaced through a pointer: " << table.tryEmplace(pointer, "fruit")
+              << ", contains apple? " << table.contains(std::string("apple"))
+              << ", emplaced apple again: " << table.tryEmplace(std::string("apple"), "other") << "\n";
+
+    FingerprintHashTable<std::string, int> fingerprints;
+    fingerprints.init(64);
+    std::cout << "Fingerprint table emplaced through a pointer: " << fingerprints.tryEmplace(pointer, 1)
+              << ", contains apple? " << fingerprints.contains(std::string("apple"))
+              << ", emplaced apple again: " << fingerprints.tryEmplace(std::string("apple"), 2)
+              << ", size: " << fingerprints.getSize() << "\n";
+
+    SimpleBloomFilter<std::string> filter;
+    filter.init(3);
+    filter.insert("a-long-key-that-does-not-fit-in-sso");
+
+    // Slices of a network buffer, as seen by a parser
+    const char buffer[] = "GET a-long-key-that-does-not-fit-in-sso HTTP/1.1";
+    const std::string_view method(buffer, 3);
+    const std::string_view path(buffer + 4, 35);
+
+    std::cout << "\n=== LOOKUPS WITH STRING VIEWS ===\n";
+    const size_t before = allocations;
+    const bool hasMethod = table.contains(method);
+    const bool hasPath = table.contains(path.data(), path.size());
+    const bool missing = table.contains(std::string_view("POST"));
+    const bool inFilter = filter.query(path).has_value();
+    const bool bufferInFilter = filter.contains(buffer, sizeof(buffer) - 1);
+    const size_t lookupAllocations = allocations - before;
+
+    std::cout << "Table contains GET? " << hasMethod << "\n";
+    std::cout << "Table contains path? " << hasPath << "\n";
+    std::cout << "Table contains POST? " << missing << "\n";
+    std::cout << "Filter contains path? " << inFilter << "\n";
+    std::cout << "Filter contains whole buffer? " << bufferInFilter << "\n";
+    std::cout << "Allocations during lookups: " << lookupAllocations << "\n";
+
+    auto result = table.query(path);
+    if (result)
+        std::cout << "Query result: " << *result << "\n";
+
+    std::cout << "\n=== FINISHED TESTING ===\n";
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include "pds/core/hugePageResource.h"
+#include "pds/core/bitArray.h"
+#include "pds/bloomFilter/simpleBloomFilter.h"
+#include <iostream>
+
+using namespace pds::core;
+
+int main()
+{
+    std::cout << "Base page size: " << HugePageResource::basePageSize() << " bytes\n";
+    std::cout << "Huge page size: " << HugePageResource::hugePageSize() << " bytes\n";
+
+    std::cout << "\n=== TRANSPARENT HUGE PAGES ===\n";
+    HugePageResource transparent({PageMode::TRANSPARENT});
+    {
+        BitArray bits(size_t{256} * 1024 * 1024, &transparent); // 32 MB
+        for (size_t i = 0; i < bits.size(); i += 4096)
+        {
+            bits.set(i); // Fault the pages in
+        }
+        std::cout << "Set bits: " << bits.count() << "\n";
+        std::cout << "Obtained page size: " << transparent.pageSizeOf(bits.data()) << " bytes\n";
+    }
+
+    std::cout << "\n=== EXPLICIT HUGE PAGES WITH FALLBACK ===\n";
+    HugePageResource explicitPages({PageMode::EXPLICIT});
+    {
+        BitArray bits(size_t{64} * 1024 * 1024, &explicitPages); // 8 MB
+        bits.set(42);
+        std::cout << "Obtained page size: " << explicitPages.pageSize() << " bytes\n";
+    }
+
+    std::cout << "\n=== INTERLEAVED ACROSS NUMA NODES 0 AND 1 ===\n";
+    HugePageOptions numaOptions;
+    numaOptions.numaPolicy = NumaPolicy::INTERLEAVE;
+    numaOptions.nodeMask = 0b11;
+    HugePageResource interleaved(numaOptions);
+    {
+        BitArray bits(size_t{64} * 1024 * 1024, &interleaved);
+        std::cout << "NUMA policy applied: " << interleaved.isNumaPolicyApplied(bits.data())
+                  << "\n";
+    }
+
+    std::cout << "\n=== SMALL FILTERS FALL THROUGH TO THE UPSTREAM RESOURCE ===\n";
+    pds::bloomFilter::SimpleBloomFilter<std::string> filter(&transparent);
+    filter.init(3, 256);
+    filter.insert("apple");
+    std::cout << "Page size with no mapped allocation: " << transparent.pageSize() << " bytes\n";
+
+    std::cout << "\n=== FINISHED TESTING ===\n";
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include "pds/countingBloomFilter/invertibleBloomLookupTable.h"
+#include <algorithm>
+#include <iostream>
+
+using namespace pds::bloomFilter;
+
+int main() {
+    // Two replicas sharing 100000 keys, each with a few the other lacks
+    const size_t shared = 100000;
+    const size_t cells = InvertibleBloomLookupTable<uint64_t>::cellsFor(100);
+    InvertibleBloomLookupTable<uint64_t> local;
+    InvertibleBloomLookupTable<uint64_t> remote;
+    local.init(cells);
+    remote.init(cells);
+
+    for (uint64_t key = 0; key < shared; ++key)
+    {
+        local.insert(key);
+        remote.insert(key);
+    }
+    for (uint64_t key = 0; key < 60; ++key)
+    {
+        local.insert(1000000 + key);
+    }
+    for (uint64_t key = 0; key < 40; ++key)
+    {
+        remote.insert(2000000 + key);
+    }
+
+    // The remote replica sends its table; its size follows the difference, not the sets
+    std::pmr::vector<uint8_t> payload = remote.encode();
+    std::cout << "Cells: " << cells << ", payload: " << payload.size() << " bytes, full key list: "
+              << (shared + 40) * sizeof(uint64_t) << " bytes\n";
+
+    InvertibleBloomLookupTable<uint64_t> received;
+    std::cout << "Decoded: " << received.decode(payload.data(), payload.size()) << "\n";
+    local.subtract(received);
+
+    std::pmr::vector<uint64_t> onlyLocal;
+    std::pmr::vector<uint64_t> onlyRemote;
+    const bool complete = local.peel(onlyLocal, onlyRemote);
+    std::sort(onlyLocal.begin(), onlyLocal.end());
+    std::sort(onlyRemote.begin(), onlyRemote.end());
+    std::cout << "Peeled completely: " << complete << ", only local: " << onlyLocal.size() << " (first "
+              << onlyLocal.front() << "), only remote: " << onlyRemote.size() << " (first " << onlyRemote.front() << ")\n";
+
+    // The subtracted table still encodes and decodes, and is small too
+    std::cout << "Difference payload: " << local.encode().size() << " bytes\n";
+
+    // Identical sets subtract to an empty table
+    InvertibleBloomLookupTable<uint64_t> same;
+    same.init(cells);
+    for (uint64_t key = 0; key < shared; ++key)
+    {
+        same.insert(key);
+    }
+    remote.erase(2000000 + 0);
+    for (uint64_t key = 1; key < 40; ++key)
+    {
+        remote.erase(2000000 + key);
+    }
+    same.subtract(remote);
+    std::cout << "Identical sets subtract to empty: " << same.isEmpty() << "\n";
+
+    // A difference far beyond the table's size fails to peel, and says so
+    InvertibleBloomLookupTable<uint64_t> small;
+    small.init(InvertibleBloomLookupTable<uint64_t>::cellsFor(10));
+    for (uint64_t key = 0; key < 500; ++key)
+    {
+        small.insert(key);
+    }
+    onlyLocal.clear();
+    onlyRemote.clear();
+    std::cout << "Oversized difference peeled: " << small.peel(onlyLocal, onlyRemote) << "\n";
+
+    // Tables must match to subtract, and corrupt payloads are rejected
+    InvertibleBloomLookupTable<uint64_t> other;
+    other.init(cells, 4);
+    std::cout << "Subtract mismatched tables: " << local.subtract(other) << "\n";
+    payload.resize(payload.size() / 2);
+    std::cout << "Decode truncated payload: " << received.decode(payload.data(), payload.size()) << "\n";
+
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include "pds/core/keyFileReader.h"
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace pds::core;
+
+// Reads a file a few bytes at a time, checking after every call that the previous batch's
+// views still hold the keys they held when returned
+static bool readAll(const std::string& path, KeyFileFormat format, size_t blockSize, std::vector<std::string>& out)
+{
+    KeyFileReader reader(path, format, blockSize);
+    std::vector<std::string_view> batches[2];
+    std::vector<std::string> copies;
+    bool intact = true;
+    for (size_t call = 0; reader.next(batches[call % 2]); ++call)
+    {
+        const std::vector<std::string_view>& previous = batches[(call + 1) % 2];
+        for (size_t i = 0; call > 0 && i < previous.size(); ++i)
+        {
+            intact &= previous[i] == copies[i];
+        }
+        copies.assign(batches[call % 2].begin(), batches[call % 2].end());
+        out.insert(out.end(), copies.begin(), copies.end());
+    }
+    return intact;
+}
+
+int main() {
+    const std::string path = "keyFileReaderTest.tmp";
+    const std::vector<std::string> expected = {"alpha", "a-record-longer-than-several-blocks", "beta", "gamma",
+                                               "delta-also-spanning-more-than-one-block"};
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "alpha\n\n\n\n\n\n\n\n\n\n\n\n\n\n" << expected[1] << "\r\nbeta\ngamma\n\n\n\n\n\n\n\n\n\n" << expected[4];
+    }
+
+    for (size_t blockSize : {1, 3, 8, 64})
+    {
+        std::vector<std::string> keys;
+        const bool intact = readAll(path, KeyFileFormat::NEWLINE, blockSize, keys);
+        std::cout << "Newline, " << blockSize << " byte blocks: " << keys.size() << " keys, match: " << (keys == expected)
+                  << ", earlier views intact: " << intact << "\n";
+    }
+
+    {
+        std::ofstream file(path, std::ios::binary);
+        for (const std::string& key : expected)
+        {
+            const uint32_t length = static_cast<uint32_t>(key.size());
+            const char prefix[4] = {static_cast<char>(length), static_cast<char>(length >> 8), static_cast<char>(length >> 16),
+                                    static_cast<char>(length >> 24)};
+            file.write(prefix, 4);
+            file << key;
+        }
+        file.write("\x09\0\0\0abc", 7); // Cut short
+    }
+    std::vector<std::string> keys;
+    const bool intact = readAll(path, KeyFileFormat::LENGTH_PREFIXED, 8, keys);
+    KeyFileReader reader(path, KeyFileFormat::LENGTH_PREFIXED, 8);
+    std::vector<std::string_view> batch;
+    while (reader.next(batch)) {}
+    std::cout << "Length prefixed, 8 byte blocks: match: " << (keys == expected) << ", earlier views intact: " << intact
+              << ", truncated: " << reader.isTruncated() << "\n";
+
+    std::remove(path.c_str());
+    return 0;
+}
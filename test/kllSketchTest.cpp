@@ -0,0 +1,77 @@
+#include "pds/kllSketch/kllSketch.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace pds::quantile;
+
+int main()
+{
+    std::cout << "\n=== LATENCY PERCENTILES FROM A STREAM ===\n";
+    // Log-normal latencies in milliseconds, kept in full only to check the sketch
+    std::mt19937_64 rng(42);
+    std::lognormal_distribution<double> latency(1.0, 0.75);
+    std::vector<double> samples(2000000);
+    for (double& sample : samples)
+    {
+        sample = latency(rng);
+    }
+
+    KllSketch<double> sketch;
+    auto start = std::chrono::steady_clock::now();
+    for (double sample : samples)
+    {
+        sketch.insert(sample);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << sketch.getCount() << " inserts in " << elapsed.count() << "s, retaining " << sketch.getRetained()
+              << " items (" << sketch.getRetained() * sizeof(double) << " bytes) in " << sketch.getNumLevels() << " levels\n";
+
+    std::vector<double> sorted = samples;
+    std::sort(sorted.begin(), sorted.end());
+    for (double q : {0.5, 0.9, 0.99, 0.999})
+    {
+        const double exact = sorted[static_cast<size_t>(std::ceil(q * sorted.size())) - 1];
+        const double estimate = sketch.quantile(q).value();
+        const double rankOfEstimate = static_cast<double>(std::upper_bound(sorted.begin(), sorted.end(), estimate) - sorted.begin()) / sorted.size();
+        std::cout << "p" << q * 100 << ": " << estimate << "ms (exact " << exact << "ms, rank error "
+                  << std::abs(rankOfEstimate - q) * 100 << "%)\n";
+    }
+    std::cout << "Bound at 99% confidence: " << sketch.getNormalizedRankError() * 100 << "%\n";
+    std::cout << "Min: " << sketch.getMin().value() << ", max: " << sketch.getMax().value() << "\n";
+    std::cout << "Rank of 10ms: " << sketch.rank(10.0) << " (exact "
+              << static_cast<double>(std::upper_bound(sorted.begin(), sorted.end(), 10.0) - sorted.begin()) / sorted.size() << ")\n";
+
+    std::cout << "\n=== BATCHED INSERT AND MERGING PER-SHARD SKETCHES ===\n";
+    KllSketch<double> shards[4];
+    start = std::chrono::steady_clock::now();
+    for (size_t s = 0; s < 4; ++s)
+    {
+        shards[s].insertRange(samples.begin() + s * samples.size() / 4, samples.begin() + (s + 1) * samples.size() / 4);
+    }
+    elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Batched inserts in " << elapsed.count() << "s\n";
+
+    KllSketch<double> merged;
+    for (const auto& shard : shards)
+    {
+        merged.merge(shard);
+    }
+    std::cout << "Merged count: " << merged.getCount() << ", retained: " << merged.getRetained()
+              << ", p99: " << merged.quantile(0.99).value() << "ms\n";
+
+    std::cout << "\n=== EXACT WHILE SMALL ===\n";
+    KllSketch<int> small;
+    for (int i = 1; i <= 100; ++i)
+    {
+        small.insert(i);
+    }
+    std::cout << "Median of 1..100: " << small.quantile(0.5).value() << ", rank of 25: " << small.rank(25) << "\n";
+    std::cout << "Empty sketch quantile: " << KllSketch<int>().quantile(0.5).has_value() << "\n";
+
+    std::cout << "\n=== FINISHED TESTING ===\n";
+    return 0;
+}
@@ -0,0 +1,63 @@
+#define PDS_VISUALISE 0
+
+#include "pds/linearCounter/linearCounter.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <vector>
+
+using namespace pds::cardinality;
+
+int main()
+{
+    constexpr size_t bitmapSize = size_t{1} << 24;
+    constexpr uint64_t numItems = 4000000;
+    constexpr uint64_t distinct = 1000000;
+
+    // A column scan: every distinct value appears four times
+    std::vector<uint64_t> column(numItems);
+    for (uint64_t i = 0; i < numItems; ++i)
+    {
+        column[i] = (i * 0x9e3779b97f4a7c15ULL) % distinct;
+    }
+
+    std::cout << "\n=== SEQUENTIAL INSERT (REFERENCE) ===\n";
+    LinearCounter<uint64_t> reference;
+    reference.init(bitmapSize);
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t value : column)
+    {
+        reference.insert(value);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Estimate: " << reference.estimate().value() << " (actual " << distinct << ") in " << elapsed.count() << "s\n";
+
+    std::cout << "\n=== PARALLEL INSERT RANGE ===\n";
+    for (size_t numThreads : {1, 2, 4, 8})
+    {
+        LinearCounter<uint64_t> counter;
+        counter.init(bitmapSize);
+        start = std::chrono::steady_clock::now();
+        counter.insertRange(column.begin(), column.end(), numThreads);
+        elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << numThreads << " thread(s): " << elapsed.count() << "s, set bits match reference? "
+                  << (counter.getSize() == reference.getSize()) << "\n";
+    }
+
+    std::cout << "\n=== MERGING COUNTERS OF TWO PARTITIONS ===\n";
+    const auto middle = column.begin() + numItems / 2;
+    LinearCounter<uint64_t> left, right;
+    left.init(bitmapSize);
+    right.init(bitmapSize);
+    left.insertRange(column.begin(), middle);
+    right.insertRange(middle, column.end());
+    std::cout << "Merged? " << left.merge(right) << ", set bits match reference? "
+              << (left.getSize() == reference.getSize()) << "\n";
+
+    LinearCounter<uint64_t> smaller;
+    smaller.init(1024);
+    std::cout << "Merged counters of different sizes? " << left.merge(smaller) << "\n";
+
+    std::cout << "\n=== FINISHED TESTING ===\n";
+    return 0;
+}
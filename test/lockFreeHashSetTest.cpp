@@ -0,0 +1,146 @@
+#include "pds/hashTable/lockFreeHashSet.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace pds::hashTable;
+
+int main()
+{
+    constexpr uint64_t keySpace = 200000;
+    constexpr size_t writers = 4;
+    constexpr size_t readers = 2;
+
+    std::cout << "\n=== LINEARIZABILITY STRESS TEST (STARTING FROM 16 SLOTS) ===\n";
+    LockFreeHashSet<uint64_t> set;
+    set.init(16);
+
+    // Writers insert overlapping ranges so the same key races in several threads.
+    // Each key must be reported as newly inserted exactly once, and once any insert
+    // of a key has returned, every later lookup must see it.
+    auto wins = std::make_unique<std::atomic<uint8_t>[]>(keySpace);
+    auto completed = std::make_unique<std::atomic<bool>[]>(keySpace);
+    for (uint64_t key = 0; key < keySpace; ++key)
+    {
+        wins[key] = 0;
+        completed[key] = false;
+    }
+
+    std::atomic<bool> done{false};
+    std::atomic<uint64_t> missedCompleted{0};
+    std::atomic<uint64_t> lostKeys{0};
+    std::vector<std::thread> threads;
+
+    for (size_t w = 0; w < writers; ++w)
+    {
+        threads.emplace_back([&, w] {
+            for (uint64_t i = 0; i < keySpace; ++i)
+            {
+                const uint64_t key = (i * (2 * w + 1) + w * 7919) % keySpace;
+                if (set.insert(key))
+                {
+                    wins[key].fetch_add(1, std::memory_order_relaxed);
+                }
+                completed[key].store(true, std::memory_order_release);
+            }
+        });
+    }
+
+    for (size_t r = 0; r < readers; ++r)
+    {
+        threads.emplace_back([&, r] {
+            std::vector<uint64_t> seen;
+            uint64_t key = r;
+            while (!done.load(std::memory_order_relaxed))
+            {
+                const bool wasCompleted = completed[key].load(std::memory_order_acquire);
+                const bool found = set.contains(key);
+                if (wasCompleted && !found)
+                {
+                    missedCompleted.fetch_add(1, std::memory_order_relaxed);
+                }
+                if (found && seen.size() < 4096)
+                {
+                    seen.push_back(key);
+                }
+                key = (key + 104729) % keySpace;
+            }
+
+            // Keys are never erased, so anything observed must still be present
+            for (uint64_t observed : seen)
+            {
+                if (!set.contains(observed))
+                {
+                    lostKeys.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+        });
+    }
+
+    for (size_t w = 0; w < writers; ++w)
+    {
+        threads[w].join();
+    }
+    done = true;
+    for (size_t r = writers; r < threads.size(); ++r)
+    {
+        threads[r].join();
+    }
+
+    uint64_t duplicateWins = 0, missingKeys = 0;
+    for (uint64_t key = 0; key < keySpace; ++key)
+    {
+        duplicateWins += wins[key].load() != 1;
+        missingKeys += !set.contains(key);
+    }
+
+    std::cout << "Size: " << set.getSize() << " (expected " << keySpace << "), capacity grew to " << set.getCapacity() << "\n";
+    std::cout << "Keys not inserted exactly once: " << duplicateWins << "\n";
+    std::cout << "Keys missing after all inserts: " << missingKeys << "\n";
+    std::cout << "Completed inserts not visible to a later lookup: " << missedCompleted.load() << "\n";
+    std::cout << "Observed keys later lost: " << lostKeys.load() << "\n";
+    std::cout << "Contains key beyond key space? " << set.contains(keySpace + 1) << "\n";
+
+    std::cout << "\n=== MARKER BIT PATTERNS ARE ORDINARY KEYS ===\n";
+    LockFreeHashSet<int64_t> signedSet;
+    signedSet.init(8);
+    std::cout << "Insert 0: " << signedSet.insert(0) << ", insert -1: " << signedSet.insert(-1)
+              << ", insert 0 again: " << signedSet.insert(0) << "\n";
+    std::cout << "Contains 0? " << signedSet.contains(0) << ", contains -1? " << signedSet.contains(-1)
+              << ", contains 1? " << signedSet.contains(1) << "\n";
+
+    std::cout << "\n=== THROUGHPUT VS THREADS (DISJOINT INSERTS) ===\n";
+    constexpr uint64_t insertsPerThread = 500000;
+    const size_t maxThreads = std::max(2u, std::thread::hardware_concurrency());
+    for (size_t numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+    {
+        LockFreeHashSet<uint64_t> dedupe;
+        dedupe.init(1024);
+        std::vector<std::thread> workers;
+        const auto start = std::chrono::steady_clock::now();
+        for (size_t t = 0; t < numThreads; ++t)
+        {
+            workers.emplace_back([&, t] {
+                for (uint64_t i = 1; i <= insertsPerThread; ++i)
+                {
+                    dedupe.insert(t * insertsPerThread + i);
+                }
+            });
+        }
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << numThreads << " thread(s): "
+                  << static_cast<uint64_t>(numThreads * insertsPerThread / elapsed.count()) << " inserts/s\n";
+    }
+
+    std::cout << "\n=== FINISHED TESTING ===\n";
+    return 0;
+}
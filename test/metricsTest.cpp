@@ -0,0 +1,94 @@
+#define PDS_VISUALISE 0
+#define PDS_METRICS 1
+
+#include "pds/bloomFilter/simpleBloomFilter.h"
+#include "pds/countingBloomFilter/countingBloomFilter.h"
+#include "pds/hashTable/openAddressingHashTable.h"
+#include "pds/linearCounter/linearCounter.h"
+#include "pds/core/metrics.h"
+#include <iostream>
+#include <string>
+
+using namespace pds;
+
+// Keeps the latest snapshot per publish, as a scraper exporting to monitoring would
+class LatestStatsSink : public core::MetricsSink
+{
+    public:
+    void publish(std::string_view structure, const core::Stats& stats) override
+    {
+        ++publications;
+        latest = stats;
+        std::cout << "[" << structure << "] fill ratio " << stats.fillRatio << " after " << stats.inserts << " inserts\n";
+    }
+
+    size_t publications = 0;
+    core::Stats latest;
+};
+
+int main()
+{
+    std::cout << "\n=== SIMPLE BLOOM FILTER: HITS, MISSES AND FILL RATIO OVER TIME ===\n";
+    LatestStatsSink sink;
+    bloomFilter::SimpleBloomFilter<std::string> filter;
+    filter.init(3, 4096);
+    filter.setMetricsSink(&sink, 250);
+    for (int i = 0; i < 1000; ++i)
+    {
+        filter.insert("key" + std::to_string(i));
+    }
+    for (int i = 0; i < 200; ++i)
+    {
+        filter.query("key" + std::to_string(i * 10));
+    }
+    core::Stats stats = filter.stats();
+    std::cout << "Inserts: " << stats.inserts << ", queries: " << stats.queries << ", hits: " << stats.hits
+              << ", misses: " << stats.misses << ", publications: " << sink.publications << "\n";
+
+    std::cout << "\n=== COUNTING BLOOM FILTER: COUNTER SATURATION ===\n";
+    bloomFilter::CountingBloomFilter<std::string> counting;
+    counting.init(2, 64);
+    for (int i = 0; i < 300; ++i)
+    {
+        counting.insert("hot");
+    }
+    for (int i = 0; i < 300; ++i)
+    {
+        counting.erase("hot");
+    }
+    stats = counting.stats();
+    std::cout << "Saturated increments: " << stats.saturations << ", erases: " << stats.erases << "\n";
+    std::cout << "Still present after erasing (saturated counters stick)? " << counting.query("hot").has_value() << "\n";
+
+    std::cout << "\n=== OPEN ADDRESSING HASH TABLE: PROBE LENGTH HISTOGRAM ===\n";
+    hashTable::OpenAddressingHashTable<std::string, int> table;
+    table.init(128);
+    for (int i = 0; i < 112; ++i)
+    {
+        table.insert("user" + std::to_string(i), i);
+    }
+    for (int i = 0; i < 112; ++i)
+    {
+        table.contains("user" + std::to_string(i));
+    }
+    stats = table.stats();
+    std::cout << "Fill ratio: " << stats.fillRatio << ", probe lengths:";
+    for (size_t i = 0; i < core::PROBE_HISTOGRAM_SIZE; ++i)
+    {
+        std::cout << " " << stats.probeLengths[i];
+    }
+    std::cout << "\n";
+
+    std::cout << "\n=== LINEAR COUNTER: STREAM SINK ===\n";
+    core::StreamMetricsSink streamSink(std::cout);
+    cardinality::LinearCounter<int> counter;
+    counter.init(1024);
+    counter.setMetricsSink(&streamSink, 100);
+    for (int i = 0; i < 300; ++i)
+    {
+        counter.insert(i % 150);
+    }
+
+    std::cout << "\n=== FINISHED TESTING ===\n";
+    return 0;
+}
@@ -0,0 +1,142 @@
+#define PDS_VISUALISE 0
+
+#include "pds/minHash/lshIndex.h"
+#include "pds/minHash/minHash.h"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using namespace pds::similarity;
+
+static std::vector<std::string> shingles(const std::vector<std::string>& words, size_t width = 3)
+{
+    std::vector<std::string> result;
+    for (size_t i = 0; i + width <= words.size(); ++i)
+    {
+        std::string shingle;
+        for (size_t j = 0; j < width; ++j)
+        {
+            shingle += words[i + j] + ' ';
+        }
+        result.push_back(shingle);
+    }
+    return result;
+}
+
+static double jaccard(const std::vector<std::string>& a, const std::vector<std::string>& b)
+{
+    std::unordered_set<std::string> setA(a.begin(), a.end());
+    std::unordered_set<std::string> setB(b.begin(), b.end());
+    size_t shared = 0;
+    for (const auto& s : setA)
+    {
+        shared += setB.count(s);
+    }
+    return static_cast<double>(shared) / static_cast<double>(setA.size() + setB.size() - shared);
+}
+
+int main()
+{
+    // 2000 documents of 200 random words; every tenth is a copy of the one before with 5% of words changed
+    std::mt19937_64 rng(7);
+    std::uniform_int_distribution<int> wordDist(0, 4999);
+    std::vector<std::vector<std::string>> documents;
+    for (size_t d = 0; d < 2000; ++d)
+    {
+        std::vector<std::string> words;
+        if (d % 10 == 9)
+        {
+            words = documents.back();
+            for (auto& word : words)
+            {
+                if (rng() % 20 == 0)
+                    word = "w" + std::to_string(wordDist(rng));
+            }
+        }
+        else
+        {
+            for (int w = 0; w < 200; ++w)
+            {
+                words.push_back("w" + std::to_string(wordDist(rng)));
+            }
+        }
+        documents.push_back(words);
+    }
+    std::vector<std::vector<std::string>> documentShingles;
+    for (const auto& words : documents)
+    {
+        documentShingles.push_back(shingles(words));
+    }
+
+    std::cout << "\n=== SIGNATURES AND ESTIMATED SIMILARITY ===\n";
+    MinHash<std::string> minHash;
+    minHash.init(128);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Signature> signatures;
+    for (const auto& s : documentShingles)
+    {
+        signatures.push_back(minHash.signature(s.begin(), s.end()));
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "128 minimums for 2000 documents in " << elapsed.count() * 1000 << "ms\n";
+
+    std::cout << "Near duplicates 8 and 9: exact " << jaccard(documentShingles[8], documentShingles[9])
+              << ", estimated " << MinHash<std::string>::similarity(signatures[8], signatures[9]) << "\n";
+    std::cout << "Unrelated 7 and 8: exact " << jaccard(documentShingles[7], documentShingles[8])
+              << ", estimated " << MinHash<std::string>::similarity(signatures[7], signatures[8]) << "\n";
+
+    MinHash<std::string> onePermutation;
+    onePermutation.init(128, MinHashScheme::ONE_PERMUTATION);
+    auto a = onePermutation.signature(documentShingles[8].begin(), documentShingles[8].end());
+    auto b = onePermutation.signature(documentShingles[9].begin(), documentShingles[9].end());
+    std::cout << "One permutation estimate for 8 and 9: " << MinHash<std::string>::similarity(a, b) << "\n";
+
+    std::cout << "\n=== B-BIT COMPRESSION ===\n";
+    for (uint8_t bits : {1, 2, 4, 8})
+    {
+        MinHash<std::string> wide;
+        wide.init(512);
+        auto x = wide.signature(documentShingles[8].begin(), documentShingles[8].end());
+        auto y = wide.signature(documentShingles[9].begin(), documentShingles[9].end());
+        auto z = wide.signature(documentShingles[7].begin(), documentShingles[7].end());
+        auto px = wide.compress(x, bits);
+        std::cout << static_cast<int>(bits) << " bits x 512: " << px.words.size() * 8 << " bytes, near duplicates "
+                  << MinHash<std::string>::similarity(px, wide.compress(y, bits)) << ", unrelated "
+                  << MinHash<std::string>::similarity(px, wide.compress(z, bits)) << "\n";
+    }
+
+    std::cout << "\n=== LSH CANDIDATE PAIRS ===\n";
+    LshIndex<uint64_t> index;
+    index.init(20, 5, documents.size());
+    for (size_t d = 0; d < signatures.size(); ++d)
+    {
+        index.insert(d, signatures[d]);
+    }
+    start = std::chrono::steady_clock::now();
+    auto pairs = index.candidatePairs();
+    elapsed = std::chrono::steady_clock::now() - start;
+
+    size_t planted = 0;
+    for (const auto& [first, second] : pairs)
+    {
+        planted += second == first + 1 && second % 10 == 9;
+    }
+    std::cout << "Threshold: " << index.getThreshold() << ", buckets: " << index.getNumBuckets() << "\n";
+    std::cout << "Candidate pairs: " << pairs.size() << " (planted near duplicates found: " << planted << " of 200) in "
+              << elapsed.count() * 1000 << "ms, instead of " << documents.size() * (documents.size() - 1) / 2 << " comparisons\n";
+
+    auto candidates = index.query(signatures[19]);
+    std::cout << "Candidates for document 19:";
+    for (auto id : candidates)
+    {
+        std::cout << " " << id;
+    }
+    std::cout << "\n";
+
+    std::cout << "\n=== FINISHED TESTING ===\n";
+    return 0;
+}
@@ -0,0 +1,91 @@
+#define PDS_VISUALISE 0
+#include "pds/hashTable/openAddressingHashSet.h"
+#include "pds/hashTable/openAddressingHashTable.h"
+#include <iostream>
+#include <random>
+#include <set>
+#include <string>
+#include <string_view>
+
+using namespace pds::hashTable;
+
+int main() {
+    OpenAddressingHashSet<std::string> seen;
+    seen.init(64);
+    std::cout << "Insert apple: " << seen.insert("apple") << ", again: " << seen.insert("apple") << "\n";
+    seen.insert("banana");
+    seen.insert("carrot");
+    std::cout << "Contains banana via string_view? " << seen.contains(std::string_view("banana")) << "\n";
+    std::cout << "Found carrot: " << *seen.find("carrot") << "\n";
+
+    seen.forEach([](const std::string& key) { std::cout << "  " << key << "\n"; });
+    std::cout << "Erased keys starting with b or c: "
+              << seen.eraseIf([](const std::string& key) { return key[0] == 'b' || key[0] == 'c'; })
+              << ", size now " << seen.getSize() << "\n";
+
+    // Values are read and updated in place, with no copy per lookup
+    OpenAddressingHashTable<std::string, std::string> table;
+    table.init(64);
+    table.insert("apple", "fruit");
+    table.insert("carrot", "vegetable");
+    if (std::string* value = table.find("carrot"))
+    {
+        *value += ", orange";
+    }
+    std::cout << "carrot: " << *table.find(std::string_view("carrot")) << ", absent key: "
+              << (table.find("pear") == nullptr) << "\n";
+
+    // Random inserts and erases on a small, nearly full set, with long probe runs that wrap
+    // around the end; erasure shifts keys back so every remaining one stays reachable
+    std::mt19937_64 rng(7);
+    OpenAddressingHashSet<uint64_t> numbers;
+    numbers.init(257);
+    std::set<uint64_t> reference;
+    size_t mismatches = 0;
+    for (int round = 0; round < 200; ++round)
+    {
+        while (numbers.getSize() < 240)
+        {
+            const uint64_t key = rng() % 4096;
+            mismatches += numbers.insert(key) != reference.insert(key).second;
+        }
+        for (int i = 0; i < 40; ++i)
+        {
+            const uint64_t key = rng() % 4096;
+            mismatches += numbers.erase(key) != (reference.erase(key) == 1);
+        }
+        const uint64_t divisor = 2 + round % 5;
+        const size_t erased = numbers.eraseIf([divisor](uint64_t key) { return key % divisor == 0; });
+        size_t expected = 0;
+        for (auto it = reference.begin(); it != reference.end();)
+        {
+            it = *it % divisor == 0 ? (++expected, reference.erase(it)) : std::next(it);
+        }
+        mismatches += erased != expected;
+
+        size_t visited = 0;
+        numbers.forEach([&](uint64_t key) { mismatches += reference.count(key) == 0; ++visited; });
+        mismatches += visited != reference.size();
+        for (uint64_t key : reference)
+        {
+            mismatches += !numbers.contains(key);
+        }
+    }
+    std::cout << "Mismatches against std::set after random inserts, erases and eraseIf: " << mismatches << "\n";
+
+    // A full table answers misses after one lap instead of probing forever
+    OpenAddressingHashTable<uint64_t, uint64_t> full;
+    full.init(8);
+    for (uint64_t key = 0; key < 8; ++key)
+    {
+        full.insert(key, key * key);
+    }
+    full.insert(8, 64);
+    std::cout << "Full table contains 9? " << full.contains(9) << ", 7 -> " << *full.find(7) << "\n";
+    size_t sum = 0;
+    full.forEach([&sum](uint64_t, uint64_t value) { sum += value; });
+    std::cout << "Sum of values: " << sum << ", erased odd keys: "
+              << full.eraseIf([](uint64_t key, uint64_t) { return key % 2 == 1; }) << ", size " << full.getSize() << "\n";
+
+    return 0;
+}
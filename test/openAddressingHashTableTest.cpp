@@ -17,5 +17,11 @@ int main() {
 
     std::cout << "Contains banana? " << table.contains("banana") << "\n";
 
+    OpenAddressingHashTable<std::string, std::string> tiny;
+    tiny.init(2);
+    tiny.insert("apple", "fruit");
+    tiny.insert("banana", "fruit");
+    std::cout << "Inserted cherry into a full table? " << tiny.insert("cherry", "fruit") << "\n";
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,77 @@
+#define PDS_VISUALISE 0
+#include "pds/hashTable/perfectHashMap.h"
+#include "pds/hashTable/openAddressingHashTable.h"
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace pds::hashTable;
+
+int main() {
+    const size_t n = 1000000;
+    std::vector<std::pair<std::string, uint32_t>> entries;
+    entries.reserve(n);
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        entries.emplace_back("key-" + std::to_string(i), i);
+    }
+
+    // Partitions are searched in parallel, one per hardware thread
+    PerfectHashMap<std::string, uint32_t> map;
+    auto start = std::chrono::steady_clock::now();
+    const bool built = map.build(entries.begin(), entries.end());
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << "Built: " << built << ", keys: " << map.getSize() << ", in " << seconds << "s\n";
+    std::cout << "Perfect hash bits per key: " << map.getBitsPerKey() << "\n";
+
+    size_t correct = 0;
+    for (const auto& [key, value] : entries)
+    {
+        const uint32_t* found = map.find(key);
+        correct += found != nullptr && *found == value;
+    }
+    std::cout << "Keys found with their value: " << correct << " / " << n << "\n";
+    std::cout << "Query key-42 via string_view: " << *map.query(std::string_view("key-42")) << "\n";
+    std::cout << "Contains absent key? " << map.contains("not-a-key") << "\n";
+
+    // Storing fingerprints instead of keys: absent keys match with probability 2^-16
+    PerfectHashMap<std::string, uint32_t, uint16_t> compact;
+    compact.build(entries.begin(), entries.end(), 2);
+    size_t falsePositives = 0;
+    for (uint32_t i = 0; i < n; ++i)
+    {
+        falsePositives += compact.contains("absent-" + std::to_string(i));
+    }
+    std::cout << "Fingerprint map false positive rate: " << static_cast<double>(falsePositives) / n
+              << " (expected about " << 1.0 / 65536 << ")\n";
+
+    // Memory per entry next to an open addressing table holding the same pairs
+    OpenAddressingHashTable<std::string, uint32_t> table;
+    table.init(2 * n);
+    for (const auto& [key, value] : entries)
+    {
+        table.insert(key, value);
+    }
+    std::cout << "Slot bytes per entry, perfect: " << sizeof(std::pair<std::string, uint32_t>)
+              << " + " << map.getBitsPerKey() / 8 << ", fingerprint: " << sizeof(std::pair<uint16_t, uint32_t>)
+              << " + " << compact.getBitsPerKey() / 8 << ", open addressing at "
+              << table.getLoadFactor() << "% load: " << sizeof(std::pair<std::string, uint32_t>) * 100 / table.getLoadFactor() << "\n";
+
+    // Small maps and integer keys
+    std::vector<std::pair<uint64_t, uint64_t>> small = {{7, 70}, {11, 110}, {13, 130}};
+    PerfectHashMap<uint64_t, uint64_t> tiny;
+    tiny.build(small.begin(), small.end());
+    std::cout << "Tiny map: " << *tiny.query(7) << " " << *tiny.query(11) << " " << *tiny.query(13)
+              << ", contains 8? " << tiny.contains(8) << "\n";
+
+    // Repeated keys cannot be placed
+    std::vector<std::pair<uint64_t, uint64_t>> repeated = {{1, 1}, {1, 2}};
+    PerfectHashMap<uint64_t, uint64_t> failed;
+    std::cout << "Build with a repeated key: " << failed.build(repeated.begin(), repeated.end())
+              << ", empty: " << failed.isEmpty() << "\n";
+
+    return 0;
+}
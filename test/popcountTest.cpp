@@ -0,0 +1,71 @@
+#define PDS_VISUALISE 0
+
+#include "pds/core/bitArray.h"
+#include "pds/core/popcount.h"
+#include "pds/linearCounter/linearCounter.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace pds::core;
+
+int main()
+{
+    std::cout << "\n=== VECTORISED POPCOUNT MATCHES SCALAR ===\n";
+    std::mt19937_64 rng(42);
+    size_t mismatches = 0;
+    for (size_t numWords : {0, 1, 7, 63, 64, 65, 257, 1000, 4099})
+    {
+        std::vector<uint64_t> words(numWords);
+        for (auto& word : words)
+        {
+            word = rng() & rng();
+        }
+        mismatches += popcount(words.data(), numWords) != detail::popcountScalar(words.data(), numWords);
+    }
+    std::cout << "Mismatching sizes: " << mismatches << "\n";
+
+    std::cout << "\n=== BIT ARRAY COUNT IS MAINTAINED INCREMENTALLY ===\n";
+    BitArray bits(1 << 20);
+    for (size_t i = 0; i < 1000; ++i)
+    {
+        bits.set((i * 7919) % bits.size());
+        bits.set((i * 7919) % bits.size()); // Setting a set bit does not count twice
+    }
+    bits.reset(0);
+    bits.reset(0);
+    std::cout << "Maintained count: " << bits.count() << ", recounted: " << bits.recount() << "\n";
+
+    std::cout << "\n=== POLLING ESTIMATE ON A LARGE LINEAR COUNTER ===\n";
+    pds::cardinality::LinearCounter<uint64_t> counter;
+    counter.init(size_t{1} << 26);
+    for (uint64_t i = 0; i < 1000000; ++i)
+    {
+        counter.insert(i);
+    }
+
+    constexpr size_t polls = 1000;
+    auto start = std::chrono::steady_clock::now();
+    float estimate = 0;
+    for (size_t i = 0; i < polls; ++i)
+    {
+        estimate = counter.estimate().value();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Estimate " << estimate << ", " << elapsed.count() / polls * 1e6 << " us per estimate()\n";
+
+    BitArray large(size_t{1} << 26);
+    start = std::chrono::steady_clock::now();
+    size_t recounted = 0;
+    for (size_t i = 0; i < 10; ++i)
+    {
+        recounted += large.recount();
+    }
+    elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Full recount of 2^26 bits: " << elapsed.count() / 10 * 1e3 << " ms (" << recounted << " bits)\n";
+
+    std::cout << "\n=== FINISHED TESTING ===\n";
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include "pds/bloomFilter/quotientFilter.h"
+#include <iostream>
+#include <string>
+
+using namespace pds::bloomFilter;
+
+int main()
+{
+    QuotientFilter<std::string> filter;
+
+    // 8 slots, 8 remainder bits each
+    filter.init(3, 8);
+
+    std::cout << "\n=== INSERTING ITEMS ===\n";
+    filter.insert("apple");
+    filter.insert("banana");
+    filter.insert("cherry");
+    filter.insert("apple");
+
+    auto report = [&](const std::string& item) {
+        auto result = filter.query(item);
+        if (result.has_value())
+        {
+            std::cout << "Possibly contains '" << item << "' (count " << filter.count(item)
+                      << ") with false positive probability: " << result.value() * 100 << "%\n";
+        }
+        else
+        {
+            std::cout << "Definitely does not contain: '" << item << "'\n";
+        }
+    };
+
+    std::cout << "\n=== QUERYING AND COUNTING ===\n";
+    report("apple");
+    report("banana");
+    report("mango");
+
+    std::cout << "\n=== ERASING ONE APPLE AND THE BANANA ===\n";
+    filter.erase("apple");
+    filter.erase("banana");
+    report("apple");
+    report("banana");
+
+    std::cout << "\n=== DOUBLING WITHOUT THE ORIGINAL ITEMS ===\n";
+    filter.insert("date");
+    filter.insert("elderberry");
+    filter.insert("fig");
+    filter.insert("grape");
+    filter.insert("honeydew");
+    filter.insert("jackfruit"); // Past 90% load: the filter doubles to 16 slots with 7 remainder bits
+    std::cout << "Capacity: " << filter.getCapacity() << ", remainder bits: " << filter.getRemainderBits()
+              << ", load factor: " << filter.getLoadFactor() << "%\n";
+    report("apple");
+    report("fig");
+
+    std::cout << "\n=== MERGING ANOTHER FILTER ===\n";
+    QuotientFilter<std::string> other;
+    other.init(2, 9); // Same 11-bit fingerprints, split differently
+    other.insert("kiwi");
+    other.insert("apple");
+    const bool merged = filter.merge(other);
+    std::cout << "Merged? " << merged << "\n";
+    report("kiwi");
+    report("apple");
+
+    std::cout << "\nSize: " << filter.getSize() << "\n";
+
+    std::cout << "\n=== COUNTING A HOT KEY ===\n";
+    QuotientFilter<std::string> counts;
+    counts.init(4, 8);
+    counts.insert("cold");
+    for (int i = 0; i < 300; ++i)
+    {
+        counts.insert("hot"); // A remainder slot and two 8-bit counter slots holding 299
+    }
+    for (int i = 0; i < 100; ++i)
+    {
+        counts.erase("hot");
+    }
+    std::cout << "Count of 'hot': " << counts.count("hot") << " (expected 200, back to one counter slot), of 'cold': " << counts.count("cold")
+              << ", load factor: " << counts.getLoadFactor() << "%\n";
+    std::cout << "\n=== FINISHED TESTING ===\n";
+    return 0;
+}
@@ -0,0 +1,54 @@
+#include "pds/slidingWindowBloomFilter/slidingWindowBloomFilter.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace pds::bloomFilter;
+using namespace std::chrono_literals;
+
+int main()
+{
+    using Filter = SlidingWindowBloomFilter<std::string>;
+    Filter filter;
+
+    // "Seen in the last 10 minutes", split across 5 generations of 256 bits
+    filter.init(3, 10min, 5, 256);
+
+    const Filter::TimePoint start{};
+
+    std::cout << "\n=== INSERTING ITEMS ===\n";
+    filter.insert("apple", start);
+    filter.insert("banana", start + 4min);
+    filter.insert("cherry", start + 9min);
+
+    auto report = [&](const std::string& item, Filter::TimePoint now) {
+        auto result = filter.query(item, now);
+        if (result.has_value())
+        {
+            std::cout << "Possibly seen '" << item << "' with false positive probability: "
+                      << result.value() * 100 << "%\n";
+        }
+        else
+        {
+            std::cout << "Not seen in window: '" << item << "'\n";
+        }
+    };
+
+    std::cout << "\n=== QUERYING WITHIN WINDOW (t = 9min) ===\n";
+    report("apple", start + 9min);
+    report("banana", start + 9min);
+    report("cherry", start + 9min);
+    report("mango", start + 9min);
+
+    std::cout << "\n=== QUERYING AFTER APPLE EXPIRES (t = 13min) ===\n";
+    filter.insert("date", start + 13min); // Inserts advance the window and expire old generations
+    report("apple", start + 13min);
+    report("banana", start + 13min);
+    report("date", start + 13min);
+
+    std::cout << "\n=== QUERYING AFTER A LONG GAP (t = 60min) ===\n";
+    report("date", start + 60min);
+
+    std::cout << "\n=== FINISHED TESTING ===\n";
+    return 0;
+}
@@ -0,0 +1,107 @@
+#define PDS_VISUALISE 0
+
+#include "pds/core/snapshot.h"
+#include "pds/bloomFilter/simpleBloomFilter.h"
+#include "pds/hashTable/openAddressingHashTable.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace pds;
+
+static std::atomic<int> liveVersions{0};
+
+// A rebuilt filter and table, counted so the test can see old versions being destroyed
+struct Blocklist
+{
+    bloomFilter::SimpleBloomFilter<uint64_t> filter;
+    hashTable::OpenAddressingHashTable<uint64_t, uint64_t> owners;
+    uint64_t generation = 0;
+
+    Blocklist() { ++liveVersions; }
+    Blocklist(Blocklist&& other) noexcept
+        : filter(std::move(other.filter)), owners(std::move(other.owners)), generation(other.generation) { ++liveVersions; }
+    ~Blocklist() { --liveVersions; }
+};
+
+static Blocklist build(uint64_t generation)
+{
+    Blocklist blocklist;
+    blocklist.generation = generation;
+    blocklist.filter.init(5, 1 << 16);
+    blocklist.owners.init(2048);
+    for (uint64_t i = 0; i < 1000; ++i)
+    {
+        blocklist.filter.insert(generation * 1000 + i);
+        blocklist.owners.insert(i, generation);
+    }
+    return blocklist;
+}
+
+int main()
+{
+    core::Snapshot<Blocklist> snapshot;
+    snapshot.publish(build(0));
+
+    std::cout << "\n=== READERS QUERYING WHILE A WRITER REBUILDS ===\n";
+    std::atomic<bool> stop{false};
+    std::atomic<uint64_t> queries{0};
+    std::atomic<uint64_t> inconsistent{0};
+    std::vector<std::thread> readers;
+    for (int t = 0; t < 3; ++t)
+    {
+        readers.emplace_back([&] {
+            uint64_t local = 0;
+            while (!stop.load(std::memory_order_relaxed))
+            {
+                auto blocklist = snapshot.read();
+                const uint64_t generation = blocklist->generation;
+                // Every query under one guard sees the same, complete version
+                if (!blocklist->filter.query(generation * 1000 + local % 1000).has_value() ||
+                    blocklist->owners.query(local % 1000) != generation)
+                {
+                    inconsistent.fetch_add(1, std::memory_order_relaxed);
+                }
+                ++local;
+            }
+            queries.fetch_add(local, std::memory_order_relaxed);
+        });
+    }
+
+    constexpr uint64_t rebuilds = 200;
+    for (uint64_t generation = 1; generation <= rebuilds; ++generation)
+    {
+        snapshot.publish(build(generation));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    stop.store(true);
+    for (auto& reader : readers)
+    {
+        reader.join();
+    }
+
+    std::cout << "Rebuilds published: " << rebuilds << ", queries: " << queries.load()
+              << ", inconsistent answers: " << inconsistent.load() << "\n";
+    std::cout << "Versions alive before reclaiming: " << liveVersions.load()
+              << " (retired: " << snapshot.getRetiredCount() << ")\n";
+
+    snapshot.reclaim();
+    std::cout << "Versions alive after reclaiming: " << liveVersions.load() << ", epoch: " << snapshot.getEpoch() << "\n";
+
+    std::cout << "\n=== A GUARD HOLDS ITS VERSION ACROSS A PUBLISH ===\n";
+    {
+        auto held = snapshot.read();
+        snapshot.publish(build(rebuilds + 1));
+        snapshot.publish(build(rebuilds + 2));
+        std::cout << "Held generation: " << held->generation << ", current: " << snapshot.read()->generation
+                  << ", retired waiting: " << snapshot.getRetiredCount() << "\n";
+    }
+    std::cout << "Destroyed after the guard is dropped: " << snapshot.reclaim() << "\n";
+
+    std::cout << "\n=== FINISHED TESTING ===\n";
+    return 0;
+}
@@ -0,0 +1,54 @@
+#include "pds/bloomFilter/simpleBloomFilter.h"
+#include "pds/countingBloomFilter/countingBloomFilter.h"
+#include "pds/hashTable/openAddressingHashTable.h"
+#include "pds/core/snapshotWriter.h"
+#include <iostream>
+#include <sstream>
+#include <string>
+
+using namespace pds;
+
+int main()
+{
+    std::cout << "\n=== JSON SNAPSHOTS OF EVERY 4TH STATE, WRITTEN IN THE BACKGROUND ===\n";
+    std::ostringstream json;
+    {
+        core::SnapshotWriter writer(json, core::SnapshotFormat::JSON, 4);
+        bloomFilter::SimpleBloomFilter<std::string> filter;
+        filter.setSnapshotWriter(&writer);
+        filter.init(2, 64);
+        for (const char* fruit : {"apple", "banana", "cherry", "date", "elderberry"})
+        {
+            filter.insert(fruit);
+        }
+        filter.query("apple");
+        filter.query("fig");
+        writer.flush();
+        std::cout << "Dropped snapshots: " << writer.getDropped() << "\n";
+    }
+    std::cout << json.str();
+
+    std::cout << "\n=== CSV SNAPSHOTS OF COUNTERS, WRITTEN SYNCHRONOUSLY ===\n";
+    {
+        core::SnapshotWriter writer(std::cout, core::SnapshotFormat::CSV, 1, false);
+        bloomFilter::CountingBloomFilter<std::string> counting;
+        counting.setSnapshotWriter(&writer);
+        counting.init(2, 32);
+        counting.insert("apple");
+        counting.insert("apple");
+        counting.erase("apple");
+    }
+
+    std::cout << "\n=== DETACHING THE WRITER DRAWS TO STD::COUT AGAIN ===\n";
+    std::ostringstream discarded;
+    core::SnapshotWriter writer(discarded, core::SnapshotFormat::JSON);
+    hashTable::OpenAddressingHashTable<std::string, int> table;
+    table.setSnapshotWriter(&writer);
+    table.init(8);
+    table.insert("apple", 1);
+    table.setSnapshotWriter(nullptr);
+    table.insert("banana", 2);
+
+    std::cout << "\n=== FINISHED TESTING ===\n";
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include "pds/bloomFilter/ssdBloomFilter.h"
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <iostream>
+#include <string>
+
+using namespace pds::bloomFilter;
+
+int main()
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "pds_ssd_bloom_filter_test.bin").string();
+    constexpr uint64_t numItems = 500000;
+
+    std::cout << "\n=== BUILDING A FILTER ON DISK ===\n";
+    {
+        // 128 blocks of 4KB is a 512KB filter, with room for 64 cached pages and 50000 buffered inserts
+        SsdBloomFilter<uint64_t> filter;
+        if (!filter.create(path, 128, 7, 50000, 64))
+        {
+            std::cout << "Could not create " << path << "\n";
+            return 1;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint64_t i = 0; i < numItems; ++i)
+        {
+            filter.insert(i);
+        }
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        std::cout << numItems << " inserts in " << elapsed.count() << "s, " << filter.getBufferedCount()
+                  << " still buffered\n";
+
+        auto buffered = filter.query(numItems - 1);
+        std::cout << "Buffered item found before flushing: " << buffered.has_value() << "\n";
+        std::cout << "Flushed: " << filter.flush() << ", file size: " << std::filesystem::file_size(path) << " bytes\n";
+    } // Closing flushes anything left and writes the header
+
+    std::cout << "\n=== REOPENING AND QUERYING ===\n";
+    SsdBloomFilter<uint64_t> filter;
+    std::cout << "Opened: " << filter.open(path, 50000, 16) << ", blocks: " << filter.getNumBlocks()
+              << ", items: " << filter.getInsertedCount() << "\n";
+
+    size_t found = 0;
+    for (uint64_t i = 0; i < 10000; ++i)
+    {
+        found += filter.query(i * 37).has_value();
+    }
+    std::cout << "Inserted items found: " << found << " of 10000, page reads: " << filter.getPageReads() << "\n";
+
+    const uint64_t readsBefore = filter.getPageReads();
+    size_t falsePositives = 0;
+    std::optional<float> probability;
+    for (uint64_t i = 0; i < 10000; ++i)
+    {
+        auto result = filter.query(numItems + i);
+        falsePositives += result.has_value();
+        probability = result.has_value() ? result : probability;
+    }
+    std::cout << "Absent items reported: " << falsePositives << " of 10000 (expected rate "
+              << probability.value_or(0) * 100 << "%), page reads: " << filter.getPageReads() - readsBefore << "\n";
+
+    const uint64_t repeatBefore = filter.getPageReads();
+    for (int i = 0; i < 1000; ++i)
+    {
+        filter.query(42);
+    }
+    std::cout << "Page reads for 1000 repeated queries of a cached block: " << filter.getPageReads() - repeatBefore << "\n";
+
+    filter.close();
+    std::filesystem::remove(path);
+
+    std::cout << "\n=== REJECTING A FILE THAT IS NOT A FILTER ===\n";
+    std::cout << "Opened: " << filter.open(path) << "\n";
+
+    std::cout << "\n=== FINISHED TESTING ===\n";
+    return 0;
+}
@@ -0,0 +1,75 @@
+#include "pds/thetaSketch/thetaSketch.h"
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+
+using namespace pds::cardinality;
+
+static void report(const std::string& label, const ThetaSketch<uint64_t>& sketch, double actual)
+{
+    std::cout << label << ": estimate " << sketch.estimate() << " in [" << sketch.lowerBound() << ", "
+              << sketch.upperBound() << "], actual " << actual << ", retained " << sketch.getRetained()
+              << ", theta " << sketch.getTheta() << "\n";
+}
+
+int main()
+{
+    std::cout << "\n=== EXACT UNTIL THE SKETCH FILLS ===\n";
+    ThetaSketch<std::string> small;
+    small.init(64);
+    for (const char* fruit : {"apple", "banana", "cherry", "apple", "banana", "date"})
+    {
+        small.insert(fruit);
+    }
+    std::cout << "Estimate: " << small.estimate() << ", estimation mode: " << small.isEstimationMode() << "\n";
+
+    std::cout << "\n=== AUDIENCE OVERLAP ===\n";
+    // Campaign A reached users [0, 600000), campaign B reached users [400000, 1000000)
+    ThetaSketch<uint64_t> a;
+    ThetaSketch<uint64_t> b;
+    a.init(4096);
+    b.init(4096);
+
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t user = 0; user < 600000; ++user)
+    {
+        a.insert(user);
+        a.insert(user); // Repeat visits are not counted twice
+    }
+    for (uint64_t user = 400000; user < 1000000; ++user)
+    {
+        b.insert(user);
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "1.8M inserts in " << elapsed.count() << "s\n";
+
+    report("A", a, 600000);
+    report("B", b, 600000);
+
+    ThetaSketch<uint64_t> either = a;
+    either.merge(b);
+    report("A union B", either, 1000000);
+
+    ThetaSketch<uint64_t> both = a;
+    both.intersect(b);
+    report("A intersect B", both, 200000);
+
+    ThetaSketch<uint64_t> onlyA = a;
+    onlyA.subtract(b);
+    report("A not B", onlyA, 400000);
+
+    std::cout << "\n=== DISJOINT STREAMS ===\n";
+    ThetaSketch<uint64_t> c;
+    c.init(4096);
+    for (uint64_t user = 2000000; user < 2100000; ++user)
+    {
+        c.insert(user);
+    }
+    ThetaSketch<uint64_t> none = a;
+    none.intersect(c);
+    report("A intersect C", none, 0);
+
+    std::cout << "\n=== FINISHED TESTING ===\n";
+    return 0;
+}
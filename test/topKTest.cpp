@@ -0,0 +1,54 @@
+#include "pds/topK/topK.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace pds::frequency;
+
+int main()
+{
+    TopK<std::string> tracker;
+
+    // Monitor the 5 heaviest items
+    tracker.init(5);
+
+    // Skewed stream: "item0" appears 200 times, "item1" 100 times, ...
+    // followed by a long tail of items seen only once
+    std::cout << "\n=== INSERTING STREAM ===\n";
+    for (int rank = 0; rank < 8; ++rank)
+    {
+        const int repeats = 200 / (rank + 1);
+        for (int i = 0; i < repeats; ++i)
+        {
+            tracker.insert("item" + std::to_string(rank));
+        }
+    }
+
+    for (int i = 0; i < 500; ++i)
+    {
+        tracker.insert("tail" + std::to_string(i));
+    }
+
+    std::cout << "\n=== TOP K ===\n";
+    for (const auto& [item, count, error] : tracker.topK())
+    {
+        std::cout << item << " count: " << count << " error: " << error
+                  << " (true frequency in [" << count - error << ", " << count << "])\n";
+    }
+
+    std::cout << "\n=== QUERYING ===\n";
+    auto heavy = tracker.query("item0");
+    if (heavy.has_value())
+    {
+        std::cout << "item0 estimated count: " << heavy.value() << "\n";
+    }
+
+    if (!tracker.query("tail7").has_value())
+    {
+        std::cout << "tail7 is not a heavy hitter\n";
+    }
+
+    std::cout << "Stream length: " << tracker.getStreamLength() << "\n";
+    std::cout << "\n=== FINISHED TESTING ===\n";
+    return 0;
+}